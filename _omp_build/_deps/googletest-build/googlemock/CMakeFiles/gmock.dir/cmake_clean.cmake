@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "../../../bin/libgmock.pdb"
+  "../../../lib/libgmock.so"
+  "../../../lib/libgmock.so.1.12.1"
+  "CMakeFiles/gmock.dir/src/gmock-all.cc.o"
+  "CMakeFiles/gmock.dir/src/gmock-all.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/gmock.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
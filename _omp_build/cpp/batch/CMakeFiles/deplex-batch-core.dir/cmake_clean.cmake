@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/deplex-batch-core.dir/batch.cpp.o"
+  "CMakeFiles/deplex-batch-core.dir/batch.cpp.o.d"
+  "libdeplex-batch-core.a"
+  "libdeplex-batch-core.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/deplex-batch-core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
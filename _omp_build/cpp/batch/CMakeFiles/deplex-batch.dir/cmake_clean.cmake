@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/deplex-batch.dir/main.cpp.o"
+  "CMakeFiles/deplex-batch.dir/main.cpp.o.d"
+  "deplex-batch"
+  "deplex-batch.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/deplex-batch.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,38 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/cpp/deplex/src/deplex/cell_grid.cpp" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/cell_grid.cpp.o" "gcc" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/cell_grid.cpp.o.d"
+  "/root/repo/cpp/deplex/src/deplex/cell_layout.cpp" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/cell_layout.cpp.o" "gcc" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/cell_layout.cpp.o.d"
+  "/root/repo/cpp/deplex/src/deplex/cell_segment.cpp" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/cell_segment.cpp.o" "gcc" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/cell_segment.cpp.o.d"
+  "/root/repo/cpp/deplex/src/deplex/cell_segment_stat.cpp" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/cell_segment_stat.cpp.o" "gcc" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/cell_segment_stat.cpp.o.d"
+  "/root/repo/cpp/deplex/src/deplex/config.cpp" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/config.cpp.o" "gcc" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/config.cpp.o.d"
+  "/root/repo/cpp/deplex/src/deplex/extractor_pool.cpp" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/extractor_pool.cpp.o" "gcc" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/extractor_pool.cpp.o.d"
+  "/root/repo/cpp/deplex/src/deplex/manhattan_frame.cpp" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/manhattan_frame.cpp.o" "gcc" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/manhattan_frame.cpp.o.d"
+  "/root/repo/cpp/deplex/src/deplex/normals_histogram.cpp" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/normals_histogram.cpp.o" "gcc" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/normals_histogram.cpp.o.d"
+  "/root/repo/cpp/deplex/src/deplex/object_clusterer.cpp" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/object_clusterer.cpp.o" "gcc" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/object_clusterer.cpp.o.d"
+  "/root/repo/cpp/deplex/src/deplex/parallel_policy.cpp" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/parallel_policy.cpp.o" "gcc" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/parallel_policy.cpp.o.d"
+  "/root/repo/cpp/deplex/src/deplex/plane_extractor.cpp" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/plane_extractor.cpp.o" "gcc" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/plane_extractor.cpp.o.d"
+  "/root/repo/cpp/deplex/src/deplex/plane_geometry.cpp" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/plane_geometry.cpp.o" "gcc" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/plane_geometry.cpp.o.d"
+  "/root/repo/cpp/deplex/src/deplex/plane_query_index.cpp" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/plane_query_index.cpp.o" "gcc" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/plane_query_index.cpp.o.d"
+  "/root/repo/cpp/deplex/src/deplex/result_publisher.cpp" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/result_publisher.cpp.o" "gcc" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/result_publisher.cpp.o.d"
+  "/root/repo/cpp/deplex/src/deplex/robust_refit.cpp" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/robust_refit.cpp.o" "gcc" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/robust_refit.cpp.o.d"
+  "/root/repo/cpp/deplex/src/deplex/thread_placement.cpp" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/thread_placement.cpp.o" "gcc" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/thread_placement.cpp.o.d"
+  "/root/repo/cpp/deplex/src/deplex/utils/depth_image.cpp" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/utils/depth_image.cpp.o" "gcc" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/utils/depth_image.cpp.o.d"
+  "/root/repo/cpp/deplex/src/deplex/utils/eigen_io.cpp" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/utils/eigen_io.cpp.o" "gcc" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/utils/eigen_io.cpp.o.d"
+  "/root/repo/cpp/deplex/src/deplex/utils/shm_ring_buffer.cpp" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/utils/shm_ring_buffer.cpp.o" "gcc" "cpp/deplex/CMakeFiles/deplex.dir/src/deplex/utils/shm_ring_buffer.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_omp_build/libs/dsyev/CMakeFiles/dsyev.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
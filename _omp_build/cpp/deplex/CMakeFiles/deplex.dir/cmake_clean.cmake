@@ -0,0 +1,47 @@
+file(REMOVE_RECURSE
+  "../../lib/libdeplex.pdb"
+  "../../lib/libdeplex.so"
+  "CMakeFiles/deplex.dir/src/deplex/cell_grid.cpp.o"
+  "CMakeFiles/deplex.dir/src/deplex/cell_grid.cpp.o.d"
+  "CMakeFiles/deplex.dir/src/deplex/cell_layout.cpp.o"
+  "CMakeFiles/deplex.dir/src/deplex/cell_layout.cpp.o.d"
+  "CMakeFiles/deplex.dir/src/deplex/cell_segment.cpp.o"
+  "CMakeFiles/deplex.dir/src/deplex/cell_segment.cpp.o.d"
+  "CMakeFiles/deplex.dir/src/deplex/cell_segment_stat.cpp.o"
+  "CMakeFiles/deplex.dir/src/deplex/cell_segment_stat.cpp.o.d"
+  "CMakeFiles/deplex.dir/src/deplex/config.cpp.o"
+  "CMakeFiles/deplex.dir/src/deplex/config.cpp.o.d"
+  "CMakeFiles/deplex.dir/src/deplex/extractor_pool.cpp.o"
+  "CMakeFiles/deplex.dir/src/deplex/extractor_pool.cpp.o.d"
+  "CMakeFiles/deplex.dir/src/deplex/manhattan_frame.cpp.o"
+  "CMakeFiles/deplex.dir/src/deplex/manhattan_frame.cpp.o.d"
+  "CMakeFiles/deplex.dir/src/deplex/normals_histogram.cpp.o"
+  "CMakeFiles/deplex.dir/src/deplex/normals_histogram.cpp.o.d"
+  "CMakeFiles/deplex.dir/src/deplex/object_clusterer.cpp.o"
+  "CMakeFiles/deplex.dir/src/deplex/object_clusterer.cpp.o.d"
+  "CMakeFiles/deplex.dir/src/deplex/parallel_policy.cpp.o"
+  "CMakeFiles/deplex.dir/src/deplex/parallel_policy.cpp.o.d"
+  "CMakeFiles/deplex.dir/src/deplex/plane_extractor.cpp.o"
+  "CMakeFiles/deplex.dir/src/deplex/plane_extractor.cpp.o.d"
+  "CMakeFiles/deplex.dir/src/deplex/plane_geometry.cpp.o"
+  "CMakeFiles/deplex.dir/src/deplex/plane_geometry.cpp.o.d"
+  "CMakeFiles/deplex.dir/src/deplex/plane_query_index.cpp.o"
+  "CMakeFiles/deplex.dir/src/deplex/plane_query_index.cpp.o.d"
+  "CMakeFiles/deplex.dir/src/deplex/result_publisher.cpp.o"
+  "CMakeFiles/deplex.dir/src/deplex/result_publisher.cpp.o.d"
+  "CMakeFiles/deplex.dir/src/deplex/robust_refit.cpp.o"
+  "CMakeFiles/deplex.dir/src/deplex/robust_refit.cpp.o.d"
+  "CMakeFiles/deplex.dir/src/deplex/thread_placement.cpp.o"
+  "CMakeFiles/deplex.dir/src/deplex/thread_placement.cpp.o.d"
+  "CMakeFiles/deplex.dir/src/deplex/utils/depth_image.cpp.o"
+  "CMakeFiles/deplex.dir/src/deplex/utils/depth_image.cpp.o.d"
+  "CMakeFiles/deplex.dir/src/deplex/utils/eigen_io.cpp.o"
+  "CMakeFiles/deplex.dir/src/deplex/utils/eigen_io.cpp.o.d"
+  "CMakeFiles/deplex.dir/src/deplex/utils/shm_ring_buffer.cpp.o"
+  "CMakeFiles/deplex.dir/src/deplex/utils/shm_ring_buffer.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/deplex.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/deplex-server-client.dir/client.cpp.o"
+  "CMakeFiles/deplex-server-client.dir/client.cpp.o.d"
+  "deplex-server-client"
+  "deplex-server-client.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/deplex-server-client.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
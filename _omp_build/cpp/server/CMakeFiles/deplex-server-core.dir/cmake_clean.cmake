@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/deplex-server-core.dir/server.cpp.o"
+  "CMakeFiles/deplex-server-core.dir/server.cpp.o.d"
+  "libdeplex-server-core.a"
+  "libdeplex-server-core.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/deplex-server-core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
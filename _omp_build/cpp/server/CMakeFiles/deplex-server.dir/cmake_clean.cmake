@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/deplex-server.dir/main.cpp.o"
+  "CMakeFiles/deplex-server.dir/main.cpp.o.d"
+  "deplex-server"
+  "deplex-server.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/deplex-server.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/run-unit-tests"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/run-unit-tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
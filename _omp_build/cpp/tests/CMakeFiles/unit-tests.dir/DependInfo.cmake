@@ -0,0 +1,44 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/cpp/tests/main.cpp" "cpp/tests/CMakeFiles/unit-tests.dir/main.cpp.o" "gcc" "cpp/tests/CMakeFiles/unit-tests.dir/main.cpp.o.d"
+  "/root/repo/cpp/tests/test_async.cpp" "cpp/tests/CMakeFiles/unit-tests.dir/test_async.cpp.o" "gcc" "cpp/tests/CMakeFiles/unit-tests.dir/test_async.cpp.o.d"
+  "/root/repo/cpp/tests/test_batch.cpp" "cpp/tests/CMakeFiles/unit-tests.dir/test_batch.cpp.o" "gcc" "cpp/tests/CMakeFiles/unit-tests.dir/test_batch.cpp.o.d"
+  "/root/repo/cpp/tests/test_cell_layout.cpp" "cpp/tests/CMakeFiles/unit-tests.dir/test_cell_layout.cpp.o" "gcc" "cpp/tests/CMakeFiles/unit-tests.dir/test_cell_layout.cpp.o.d"
+  "/root/repo/cpp/tests/test_cell_segment_stat.cpp" "cpp/tests/CMakeFiles/unit-tests.dir/test_cell_segment_stat.cpp.o" "gcc" "cpp/tests/CMakeFiles/unit-tests.dir/test_cell_segment_stat.cpp.o.d"
+  "/root/repo/cpp/tests/test_config.cpp" "cpp/tests/CMakeFiles/unit-tests.dir/test_config.cpp.o" "gcc" "cpp/tests/CMakeFiles/unit-tests.dir/test_config.cpp.o.d"
+  "/root/repo/cpp/tests/test_depth_image.cpp" "cpp/tests/CMakeFiles/unit-tests.dir/test_depth_image.cpp.o" "gcc" "cpp/tests/CMakeFiles/unit-tests.dir/test_depth_image.cpp.o.d"
+  "/root/repo/cpp/tests/test_eigen_io.cpp" "cpp/tests/CMakeFiles/unit-tests.dir/test_eigen_io.cpp.o" "gcc" "cpp/tests/CMakeFiles/unit-tests.dir/test_eigen_io.cpp.o.d"
+  "/root/repo/cpp/tests/test_extractor_pool.cpp" "cpp/tests/CMakeFiles/unit-tests.dir/test_extractor_pool.cpp.o" "gcc" "cpp/tests/CMakeFiles/unit-tests.dir/test_extractor_pool.cpp.o.d"
+  "/root/repo/cpp/tests/test_object_clusterer.cpp" "cpp/tests/CMakeFiles/unit-tests.dir/test_object_clusterer.cpp.o" "gcc" "cpp/tests/CMakeFiles/unit-tests.dir/test_object_clusterer.cpp.o.d"
+  "/root/repo/cpp/tests/test_parallel_policy.cpp" "cpp/tests/CMakeFiles/unit-tests.dir/test_parallel_policy.cpp.o" "gcc" "cpp/tests/CMakeFiles/unit-tests.dir/test_parallel_policy.cpp.o.d"
+  "/root/repo/cpp/tests/test_pipeline.cpp" "cpp/tests/CMakeFiles/unit-tests.dir/test_pipeline.cpp.o" "gcc" "cpp/tests/CMakeFiles/unit-tests.dir/test_pipeline.cpp.o.d"
+  "/root/repo/cpp/tests/test_plane_extractor.cpp" "cpp/tests/CMakeFiles/unit-tests.dir/test_plane_extractor.cpp.o" "gcc" "cpp/tests/CMakeFiles/unit-tests.dir/test_plane_extractor.cpp.o.d"
+  "/root/repo/cpp/tests/test_plane_query_index.cpp" "cpp/tests/CMakeFiles/unit-tests.dir/test_plane_query_index.cpp.o" "gcc" "cpp/tests/CMakeFiles/unit-tests.dir/test_plane_query_index.cpp.o.d"
+  "/root/repo/cpp/tests/test_refinement.cpp" "cpp/tests/CMakeFiles/unit-tests.dir/test_refinement.cpp.o" "gcc" "cpp/tests/CMakeFiles/unit-tests.dir/test_refinement.cpp.o.d"
+  "/root/repo/cpp/tests/test_result_publisher.cpp" "cpp/tests/CMakeFiles/unit-tests.dir/test_result_publisher.cpp.o" "gcc" "cpp/tests/CMakeFiles/unit-tests.dir/test_result_publisher.cpp.o.d"
+  "/root/repo/cpp/tests/test_robust_refit.cpp" "cpp/tests/CMakeFiles/unit-tests.dir/test_robust_refit.cpp.o" "gcc" "cpp/tests/CMakeFiles/unit-tests.dir/test_robust_refit.cpp.o.d"
+  "/root/repo/cpp/tests/test_scenes.cpp" "cpp/tests/CMakeFiles/unit-tests.dir/test_scenes.cpp.o" "gcc" "cpp/tests/CMakeFiles/unit-tests.dir/test_scenes.cpp.o.d"
+  "/root/repo/cpp/tests/test_server.cpp" "cpp/tests/CMakeFiles/unit-tests.dir/test_server.cpp.o" "gcc" "cpp/tests/CMakeFiles/unit-tests.dir/test_server.cpp.o.d"
+  "/root/repo/cpp/tests/test_shm_ring_buffer.cpp" "cpp/tests/CMakeFiles/unit-tests.dir/test_shm_ring_buffer.cpp.o" "gcc" "cpp/tests/CMakeFiles/unit-tests.dir/test_shm_ring_buffer.cpp.o.d"
+  "/root/repo/cpp/tests/test_thread_placement.cpp" "cpp/tests/CMakeFiles/unit-tests.dir/test_thread_placement.cpp.o" "gcc" "cpp/tests/CMakeFiles/unit-tests.dir/test_thread_placement.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_omp_build/cpp/batch/CMakeFiles/deplex-batch-core.dir/DependInfo.cmake"
+  "/root/repo/_omp_build/cpp/server/CMakeFiles/deplex-server-core.dir/DependInfo.cmake"
+  "/root/repo/_omp_build/_deps/googletest-build/googletest/CMakeFiles/gtest_main.dir/DependInfo.cmake"
+  "/root/repo/_omp_build/cpp/deplex/CMakeFiles/deplex.dir/DependInfo.cmake"
+  "/root/repo/_omp_build/_deps/googletest-build/googletest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
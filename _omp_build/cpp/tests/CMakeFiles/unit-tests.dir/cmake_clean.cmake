@@ -0,0 +1,52 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/unit-tests.dir/main.cpp.o"
+  "CMakeFiles/unit-tests.dir/main.cpp.o.d"
+  "CMakeFiles/unit-tests.dir/test_async.cpp.o"
+  "CMakeFiles/unit-tests.dir/test_async.cpp.o.d"
+  "CMakeFiles/unit-tests.dir/test_batch.cpp.o"
+  "CMakeFiles/unit-tests.dir/test_batch.cpp.o.d"
+  "CMakeFiles/unit-tests.dir/test_cell_layout.cpp.o"
+  "CMakeFiles/unit-tests.dir/test_cell_layout.cpp.o.d"
+  "CMakeFiles/unit-tests.dir/test_cell_segment_stat.cpp.o"
+  "CMakeFiles/unit-tests.dir/test_cell_segment_stat.cpp.o.d"
+  "CMakeFiles/unit-tests.dir/test_config.cpp.o"
+  "CMakeFiles/unit-tests.dir/test_config.cpp.o.d"
+  "CMakeFiles/unit-tests.dir/test_depth_image.cpp.o"
+  "CMakeFiles/unit-tests.dir/test_depth_image.cpp.o.d"
+  "CMakeFiles/unit-tests.dir/test_eigen_io.cpp.o"
+  "CMakeFiles/unit-tests.dir/test_eigen_io.cpp.o.d"
+  "CMakeFiles/unit-tests.dir/test_extractor_pool.cpp.o"
+  "CMakeFiles/unit-tests.dir/test_extractor_pool.cpp.o.d"
+  "CMakeFiles/unit-tests.dir/test_object_clusterer.cpp.o"
+  "CMakeFiles/unit-tests.dir/test_object_clusterer.cpp.o.d"
+  "CMakeFiles/unit-tests.dir/test_parallel_policy.cpp.o"
+  "CMakeFiles/unit-tests.dir/test_parallel_policy.cpp.o.d"
+  "CMakeFiles/unit-tests.dir/test_pipeline.cpp.o"
+  "CMakeFiles/unit-tests.dir/test_pipeline.cpp.o.d"
+  "CMakeFiles/unit-tests.dir/test_plane_extractor.cpp.o"
+  "CMakeFiles/unit-tests.dir/test_plane_extractor.cpp.o.d"
+  "CMakeFiles/unit-tests.dir/test_plane_query_index.cpp.o"
+  "CMakeFiles/unit-tests.dir/test_plane_query_index.cpp.o.d"
+  "CMakeFiles/unit-tests.dir/test_refinement.cpp.o"
+  "CMakeFiles/unit-tests.dir/test_refinement.cpp.o.d"
+  "CMakeFiles/unit-tests.dir/test_result_publisher.cpp.o"
+  "CMakeFiles/unit-tests.dir/test_result_publisher.cpp.o.d"
+  "CMakeFiles/unit-tests.dir/test_robust_refit.cpp.o"
+  "CMakeFiles/unit-tests.dir/test_robust_refit.cpp.o.d"
+  "CMakeFiles/unit-tests.dir/test_scenes.cpp.o"
+  "CMakeFiles/unit-tests.dir/test_scenes.cpp.o.d"
+  "CMakeFiles/unit-tests.dir/test_server.cpp.o"
+  "CMakeFiles/unit-tests.dir/test_server.cpp.o.d"
+  "CMakeFiles/unit-tests.dir/test_shm_ring_buffer.cpp.o"
+  "CMakeFiles/unit-tests.dir/test_shm_ring_buffer.cpp.o.d"
+  "CMakeFiles/unit-tests.dir/test_thread_placement.cpp.o"
+  "CMakeFiles/unit-tests.dir/test_thread_placement.cpp.o.d"
+  "unit-tests"
+  "unit-tests.pdb"
+  "unit-tests[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/unit-tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
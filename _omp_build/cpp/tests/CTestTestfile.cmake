@@ -0,0 +1,7 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/cpp/tests
+# Build directory: /root/repo/_omp_build/cpp/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+include("/root/repo/_omp_build/cpp/tests/unit-tests[1]_include.cmake")
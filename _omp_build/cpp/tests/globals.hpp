@@ -0,0 +1,43 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+namespace deplex {
+namespace test_globals {
+// ICL NUIM living room dataset
+namespace icl {
+constexpr const int image_width = 640, image_height = 480;
+constexpr const char* intrinsics = "/root/repo/data/configs/ICL_living_room.K";
+constexpr const char* config = "/root/repo/data/configs/ICL_living_room.ini";
+constexpr const char* sample_image = "/root/repo/data/icl_nuim/0.png";
+}  // namespace icl
+
+// TUM freiburg3 long_office_validation dataset
+namespace tum {
+constexpr const int image_width = 640, image_height = 480;
+constexpr const char* intrinsics = "/root/repo/data/configs/TUM_fr3_long_val.K";
+constexpr const char* config = "/root/repo/data/configs/TUM_fr3_long_val.ini";
+constexpr const char* sample_image = "/root/repo/data/tum/1341848230.910894.png";
+constexpr const char* sample_image_points = "/root/repo/data/tum/points_1341848230.910894.csv";
+}  // namespace tum
+
+namespace invalid {
+constexpr const char* missing_params_config = "/root/repo/cpp/tests/data/invalid/MissingParameters.ini";
+constexpr const char* invalid_extension_image = "/root/repo/cpp/tests/data/invalid/InvalidFile.jpg";
+constexpr const char* invalid_depth_image = "/root/repo/cpp/tests/data/invalid/InvalidFile.png";
+}  // namespace invalid
+}  // namespace test_globals
+}  // namespace deplex
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_omp_build/cpp/tests/unit-tests[1]_tests.cmake")
+  include("/root/repo/_omp_build/cpp/tests/unit-tests[1]_tests.cmake")
+else()
+  add_test(unit-tests_NOT_BUILT unit-tests_NOT_BUILT)
+endif()
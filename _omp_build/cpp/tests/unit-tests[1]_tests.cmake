@@ -0,0 +1,215 @@
+add_test([=[TUMPlaneExtraction.DefaultConfigExtraction]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=TUMPlaneExtraction.DefaultConfigExtraction]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TUMPlaneExtraction.DefaultConfigExtraction]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TUMPlaneExtraction.ParallelCalibrationKeepsLabels]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=TUMPlaneExtraction.ParallelCalibrationKeepsLabels]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TUMPlaneExtraction.ParallelCalibrationKeepsLabels]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TUMPlaneExtraction.ZeroLeadingConfigExtraction]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=TUMPlaneExtraction.ZeroLeadingConfigExtraction]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TUMPlaneExtraction.ZeroLeadingConfigExtraction]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TUMPlaneExtraction.ZeroPatchSize]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=TUMPlaneExtraction.ZeroPatchSize]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TUMPlaneExtraction.ZeroPatchSize]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TUMPlaneExtraction.EnormousPatchSize]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=TUMPlaneExtraction.EnormousPatchSize]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TUMPlaneExtraction.EnormousPatchSize]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TUMPlaneExtraction.Refinement]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=TUMPlaneExtraction.Refinement]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TUMPlaneExtraction.Refinement]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TUMPlaneExtraction.RobustRefit]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=TUMPlaneExtraction.RobustRefit]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TUMPlaneExtraction.RobustRefit]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TUMPlaneExtraction.BoundaryRefinement]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=TUMPlaneExtraction.BoundaryRefinement]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TUMPlaneExtraction.BoundaryRefinement]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ImageShape.NotMultipleOfPatchSize]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ImageShape.NotMultipleOfPatchSize]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ImageShape.NotMultipleOfPatchSize]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[GravityPrior.RejectsSlopedPlanes]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=GravityPrior.RejectsSlopedPlanes]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[GravityPrior.RejectsSlopedPlanes]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[GravityPrior.SnapToTiltedGravity]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=GravityPrior.SnapToTiltedGravity]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[GravityPrior.SnapToTiltedGravity]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[GravityPrior.ZeroGravity]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=GravityPrior.ZeroGravity]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[GravityPrior.ZeroGravity]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ExtractionResult.PlanesMatchLabels]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ExtractionResult.PlanesMatchLabels]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ExtractionResult.PlanesMatchLabels]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ExtractionResult.PixelIndex]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ExtractionResult.PixelIndex]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ExtractionResult.PixelIndex]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ManhattanMode.AxesAssigned]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ManhattanMode.AxesAssigned]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ManhattanMode.AxesAssigned]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ManhattanMode.GravityAxis]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ManhattanMode.GravityAxis]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ManhattanMode.GravityAxis]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[GlobalMerge.SplitFloor]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=GlobalMerge.SplitFloor]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[GlobalMerge.SplitFloor]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[GlobalMerge.FarTiltedParts]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=GlobalMerge.FarTiltedParts]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[GlobalMerge.FarTiltedParts]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CellConnectivity.DiagonalCells]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=CellConnectivity.DiagonalCells]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CellConnectivity.DiagonalCells]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[PlaneGeometry.FloorDescriptors]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=PlaneGeometry.FloorDescriptors]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[PlaneGeometry.FloorDescriptors]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[DenoisePoints.SnapsAndFillsWall]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=DenoisePoints.SnapsAndFillsWall]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[DenoisePoints.SnapsAndFillsWall]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ResidualMap.WallResiduals]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ResidualMap.WallResiduals]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ResidualMap.WallResiduals]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[InvalidInput.ZeroValuePoints]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=InvalidInput.ZeroValuePoints]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[InvalidInput.ZeroValuePoints]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[InvalidInput.EmptyPoints]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=InvalidInput.EmptyPoints]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[InvalidInput.EmptyPoints]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[InvalidInput.WrongShape]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=InvalidInput.WrongShape]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[InvalidInput.WrongShape]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[AsyncProcessing.FuturesMatchSyncResults]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=AsyncProcessing.FuturesMatchSyncResults]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[AsyncProcessing.FuturesMatchSyncResults]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[AsyncProcessing.InFlightLimitAndOrder]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=AsyncProcessing.InFlightLimitAndOrder]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[AsyncProcessing.InFlightLimitAndOrder]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[AsyncProcessing.PipelinedResultsInOrder]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=AsyncProcessing.PipelinedResultsInOrder]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[AsyncProcessing.PipelinedResultsInOrder]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[AsyncProcessing.MappedBufferAndErrors]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=AsyncProcessing.MappedBufferAndErrors]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[AsyncProcessing.MappedBufferAndErrors]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[AsyncProcessing.CallbackExceptionsAndDestruction]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=AsyncProcessing.CallbackExceptionsAndDestruction]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[AsyncProcessing.CallbackExceptionsAndDestruction]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[PlaneCovariance.MatchesMonteCarlo]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=PlaneCovariance.MatchesMonteCarlo]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[PlaneCovariance.MatchesMonteCarlo]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[PlaneCovariance.EmptyStat]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=PlaneCovariance.EmptyStat]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[PlaneCovariance.EmptyStat]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CellSegmentStat.MergedFarWall]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=CellSegmentStat.MergedFarWall]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CellSegmentStat.MergedFarWall]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ConfigInit.InvalidPath]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ConfigInit.InvalidPath]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ConfigInit.InvalidPath]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ConfigInit.MissingParameters]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ConfigInit.MissingParameters]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ConfigInit.MissingParameters]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ConfigInit.ParameterMap]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ConfigInit.ParameterMap]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ConfigInit.ParameterMap]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ConfigInit.InvalidParameterValue]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ConfigInit.InvalidParameterValue]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ConfigInit.InvalidParameterValue]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ConfigInit.CellOrder]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ConfigInit.CellOrder]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ConfigInit.CellOrder]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ConfigInit.RobustLoss]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ConfigInit.RobustLoss]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ConfigInit.RobustLoss]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ReadImage.ValidImage]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ReadImage.ValidImage]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ReadImage.ValidImage]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ReadImage.InvalidPath]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ReadImage.InvalidPath]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ReadImage.InvalidPath]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ReadImage.InvalidImageExtension]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ReadImage.InvalidImageExtension]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ReadImage.InvalidImageExtension]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ReadImage.InvalidImage]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ReadImage.InvalidImage]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ReadImage.InvalidImage]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[TransformPointCloud.ValidTransform]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=TransformPointCloud.ValidTransform]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[TransformPointCloud.ValidTransform]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[LabelsBinary.SaveAndRead]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=LabelsBinary.SaveAndRead]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[LabelsBinary.SaveAndRead]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[LabelsBinary.CompleteFile]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=LabelsBinary.CompleteFile]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[LabelsBinary.CompleteFile]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[LabelsBinary.WrongShape]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=LabelsBinary.WrongShape]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[LabelsBinary.WrongShape]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[LabelsBinary.InvalidFile]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=LabelsBinary.InvalidFile]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[LabelsBinary.InvalidFile]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ExtractorPool.ReuseWarmExtractor]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ExtractorPool.ReuseWarmExtractor]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ExtractorPool.ReuseWarmExtractor]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ExtractorPool.KeyedByShapeAndConfig]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ExtractorPool.KeyedByShapeAndConfig]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ExtractorPool.KeyedByShapeAndConfig]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ExtractorPool.MemoryLimitEviction]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ExtractorPool.MemoryLimitEviction]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ExtractorPool.MemoryLimitEviction]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ExtractorPool.ReleaseResetsSettings]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ExtractorPool.ReleaseResetsSettings]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ExtractorPool.ReleaseResetsSettings]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ExtractorPool.SameResultAsExtractor]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ExtractorPool.SameResultAsExtractor]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ExtractorPool.SameResultAsExtractor]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ObjectClusterer.BoxesOnFloor]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ObjectClusterer.BoxesOnFloor]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ObjectClusterer.BoxesOnFloor]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ObjectClusterer.InvalidInput]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ObjectClusterer.InvalidInput]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ObjectClusterer.InvalidInput]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ParallelPolicy.SmallWorkIsSerial]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ParallelPolicy.SmallWorkIsSerial]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ParallelPolicy.SmallWorkIsSerial]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ParallelPolicy.ScheduleCoversAllItems]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ParallelPolicy.ScheduleCoversAllItems]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ParallelPolicy.ScheduleCoversAllItems]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ParallelPolicy.ForceSerial]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ParallelPolicy.ForceSerial]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ParallelPolicy.ForceSerial]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ParallelPolicy.RecordedTimeUpdatesCost]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ParallelPolicy.RecordedTimeUpdatesCost]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ParallelPolicy.RecordedTimeUpdatesCost]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ParallelPolicy.SublinearScalingLimitsThreads]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ParallelPolicy.SublinearScalingLimitsThreads]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ParallelPolicy.SublinearScalingLimitsThreads]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Pipeline.StageTimings]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=Pipeline.StageTimings]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Pipeline.StageTimings]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Pipeline.SkipPixelLabels]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=Pipeline.SkipPixelLabels]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Pipeline.SkipPixelLabels]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Pipeline.ReplaceRegionGrowing]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=Pipeline.ReplaceRegionGrowing]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Pipeline.ReplaceRegionGrowing]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Pipeline.ReplaceCandidatesAndMerge]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=Pipeline.ReplaceCandidatesAndMerge]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Pipeline.ReplaceCandidatesAndMerge]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Pipeline.RejectUnknownLabels]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=Pipeline.RejectUnknownLabels]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Pipeline.RejectUnknownLabels]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[PlaneQueryIndex.RequiresGeometry]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=PlaneQueryIndex.RequiresGeometry]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[PlaneQueryIndex.RequiresGeometry]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[PlaneQueryIndex.CastRays]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=PlaneQueryIndex.CastRays]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[PlaneQueryIndex.CastRays]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[PlaneQueryIndex.AssignPoints]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=PlaneQueryIndex.AssignPoints]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[PlaneQueryIndex.AssignPoints]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[PlaneQueryIndex.LabelLookupMatchesBVH]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=PlaneQueryIndex.LabelLookupMatchesBVH]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[PlaneQueryIndex.LabelLookupMatchesBVH]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ICLPlaneExtraction.Refinement]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ICLPlaneExtraction.Refinement]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ICLPlaneExtraction.Refinement]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[BoundaryRefinement.LabelsPixelsOfNonPlanarCell]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=BoundaryRefinement.LabelsPixelsOfNonPlanarCell]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[BoundaryRefinement.LabelsPixelsOfNonPlanarCell]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ResultPublisher.LatestResult]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ResultPublisher.LatestResult]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ResultPublisher.LatestResult]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ResultPublisher.ConcurrentReaders]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ResultPublisher.ConcurrentReaders]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ResultPublisher.ConcurrentReaders]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[RobustRefit.NoneKeepsModel]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=RobustRefit.NoneKeepsModel]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[RobustRefit.NoneKeepsModel]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[RobustRefit.TukeyRejectsOutliers]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=RobustRefit.TukeyRejectsOutliers]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[RobustRefit.TukeyRejectsOutliers]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[RobustRefit.HuberReducesOutlierBias]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=RobustRefit.HuberReducesOutlierBias]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[RobustRefit.HuberReducesOutlierBias]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ShmRingBuffer.SingleProcessOrdering]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ShmRingBuffer.SingleProcessOrdering]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ShmRingBuffer.SingleProcessOrdering]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ShmRingBuffer.OversizedPayload]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ShmRingBuffer.OversizedPayload]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ShmRingBuffer.OversizedPayload]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ShmRingBuffer.ExistingRing]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ShmRingBuffer.ExistingRing]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ShmRingBuffer.ExistingRing]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ShmRingBuffer.OpenMissingRing]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ShmRingBuffer.OpenMissingRing]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ShmRingBuffer.OpenMissingRing]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ShmRingBuffer.RejectsFrameExceedingPayload]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ShmRingBuffer.RejectsFrameExceedingPayload]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ShmRingBuffer.RejectsFrameExceedingPayload]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ShmRingBuffer.FullResultsRing]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ShmRingBuffer.FullResultsRing]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ShmRingBuffer.FullResultsRing]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ShmRingBuffer.TwoProcessExtraction]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ShmRingBuffer.TwoProcessExtraction]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ShmRingBuffer.TwoProcessExtraction]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ThreadPlacement.ParseCpuList]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ThreadPlacement.ParseCpuList]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ThreadPlacement.ParseCpuList]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ThreadPlacement.InvalidCpuList]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ThreadPlacement.InvalidCpuList]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ThreadPlacement.InvalidCpuList]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ThreadPlacement.InvalidConfig]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ThreadPlacement.InvalidConfig]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ThreadPlacement.InvalidConfig]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ThreadPlacement.PinnedExtraction]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ThreadPlacement.PinnedExtraction]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ThreadPlacement.PinnedExtraction]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[ThreadPlacement.UnpinnedExtractionAfterPinned]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=ThreadPlacement.UnpinnedExtractionAfterPinned]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[ThreadPlacement.UnpinnedExtractionAfterPinned]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Batch.SameRootNames]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=Batch.SameRootNames]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Batch.SameRootNames]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Batch.Resume]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=Batch.Resume]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Batch.Resume]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Server.LoopbackSession]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=Server.LoopbackSession]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Server.LoopbackSession]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Server.StalledClientDoesntBlockOthers]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=Server.StalledClientDoesntBlockOthers]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Server.StalledClientDoesntBlockOthers]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Server.OversizedMessage]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=Server.OversizedMessage]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Server.OversizedMessage]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Server.PriorityBeforeArrival]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=Server.PriorityBeforeArrival]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Server.PriorityBeforeArrival]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Server.WorkersDontOversubscribe]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=Server.WorkersDontOversubscribe]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Server.WorkersDontOversubscribe]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CellOrders/CellLayoutTest.IndexRoundTrip/RowMajor  # GetParam() = 4-byte object <00-00 00-00>]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=CellOrders/CellLayoutTest.IndexRoundTrip/RowMajor]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CellOrders/CellLayoutTest.IndexRoundTrip/RowMajor  # GetParam() = 4-byte object <00-00 00-00>]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CellOrders/CellLayoutTest.IndexRoundTrip/Morton  # GetParam() = 4-byte object <01-00 00-00>]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=CellOrders/CellLayoutTest.IndexRoundTrip/Morton]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CellOrders/CellLayoutTest.IndexRoundTrip/Morton  # GetParam() = 4-byte object <01-00 00-00>]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CellOrders/CellLayoutTest.IndexRoundTrip/Tiled  # GetParam() = 4-byte object <02-00 00-00>]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=CellOrders/CellLayoutTest.IndexRoundTrip/Tiled]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CellOrders/CellLayoutTest.IndexRoundTrip/Tiled  # GetParam() = 4-byte object <02-00 00-00>]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CellOrders/CellLayoutTest.Neighbours/RowMajor  # GetParam() = 4-byte object <00-00 00-00>]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=CellOrders/CellLayoutTest.Neighbours/RowMajor]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CellOrders/CellLayoutTest.Neighbours/RowMajor  # GetParam() = 4-byte object <00-00 00-00>]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CellOrders/CellLayoutTest.Neighbours/Morton  # GetParam() = 4-byte object <01-00 00-00>]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=CellOrders/CellLayoutTest.Neighbours/Morton]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CellOrders/CellLayoutTest.Neighbours/Morton  # GetParam() = 4-byte object <01-00 00-00>]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CellOrders/CellLayoutTest.Neighbours/Tiled  # GetParam() = 4-byte object <02-00 00-00>]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=CellOrders/CellLayoutTest.Neighbours/Tiled]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CellOrders/CellLayoutTest.Neighbours/Tiled  # GetParam() = 4-byte object <02-00 00-00>]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CellOrders/CellLayoutTest.DiagonalNeighbours/RowMajor  # GetParam() = 4-byte object <00-00 00-00>]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=CellOrders/CellLayoutTest.DiagonalNeighbours/RowMajor]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CellOrders/CellLayoutTest.DiagonalNeighbours/RowMajor  # GetParam() = 4-byte object <00-00 00-00>]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CellOrders/CellLayoutTest.DiagonalNeighbours/Morton  # GetParam() = 4-byte object <01-00 00-00>]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=CellOrders/CellLayoutTest.DiagonalNeighbours/Morton]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CellOrders/CellLayoutTest.DiagonalNeighbours/Morton  # GetParam() = 4-byte object <01-00 00-00>]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CellOrders/CellLayoutTest.DiagonalNeighbours/Tiled  # GetParam() = 4-byte object <02-00 00-00>]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=CellOrders/CellLayoutTest.DiagonalNeighbours/Tiled]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CellOrders/CellLayoutTest.DiagonalNeighbours/Tiled  # GetParam() = 4-byte object <02-00 00-00>]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CellOrders/CellLayoutTest.SameLabelsAsRowMajor/RowMajor  # GetParam() = 4-byte object <00-00 00-00>]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=CellOrders/CellLayoutTest.SameLabelsAsRowMajor/RowMajor]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CellOrders/CellLayoutTest.SameLabelsAsRowMajor/RowMajor  # GetParam() = 4-byte object <00-00 00-00>]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CellOrders/CellLayoutTest.SameLabelsAsRowMajor/Morton  # GetParam() = 4-byte object <01-00 00-00>]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=CellOrders/CellLayoutTest.SameLabelsAsRowMajor/Morton]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CellOrders/CellLayoutTest.SameLabelsAsRowMajor/Morton  # GetParam() = 4-byte object <01-00 00-00>]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[CellOrders/CellLayoutTest.SameLabelsAsRowMajor/Tiled  # GetParam() = 4-byte object <02-00 00-00>]=]  /root/repo/_omp_build/cpp/tests/unit-tests [==[--gtest_filter=CellOrders/CellLayoutTest.SameLabelsAsRowMajor/Tiled]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[CellOrders/CellLayoutTest.SameLabelsAsRowMajor/Tiled  # GetParam() = 4-byte object <02-00 00-00>]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_omp_build/cpp/tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  unit-tests_TESTS TUMPlaneExtraction.DefaultConfigExtraction TUMPlaneExtraction.ParallelCalibrationKeepsLabels TUMPlaneExtraction.ZeroLeadingConfigExtraction TUMPlaneExtraction.ZeroPatchSize TUMPlaneExtraction.EnormousPatchSize TUMPlaneExtraction.Refinement TUMPlaneExtraction.RobustRefit TUMPlaneExtraction.BoundaryRefinement ImageShape.NotMultipleOfPatchSize GravityPrior.RejectsSlopedPlanes GravityPrior.SnapToTiltedGravity GravityPrior.ZeroGravity ExtractionResult.PlanesMatchLabels ExtractionResult.PixelIndex ManhattanMode.AxesAssigned ManhattanMode.GravityAxis GlobalMerge.SplitFloor GlobalMerge.FarTiltedParts CellConnectivity.DiagonalCells PlaneGeometry.FloorDescriptors DenoisePoints.SnapsAndFillsWall ResidualMap.WallResiduals InvalidInput.ZeroValuePoints InvalidInput.EmptyPoints InvalidInput.WrongShape AsyncProcessing.FuturesMatchSyncResults AsyncProcessing.InFlightLimitAndOrder AsyncProcessing.PipelinedResultsInOrder AsyncProcessing.MappedBufferAndErrors AsyncProcessing.CallbackExceptionsAndDestruction PlaneCovariance.MatchesMonteCarlo PlaneCovariance.EmptyStat CellSegmentStat.MergedFarWall ConfigInit.InvalidPath ConfigInit.MissingParameters ConfigInit.ParameterMap ConfigInit.InvalidParameterValue ConfigInit.CellOrder ConfigInit.RobustLoss ReadImage.ValidImage ReadImage.InvalidPath ReadImage.InvalidImageExtension ReadImage.InvalidImage TransformPointCloud.ValidTransform LabelsBinary.SaveAndRead LabelsBinary.CompleteFile LabelsBinary.WrongShape LabelsBinary.InvalidFile ExtractorPool.ReuseWarmExtractor ExtractorPool.KeyedByShapeAndConfig ExtractorPool.MemoryLimitEviction ExtractorPool.ReleaseResetsSettings ExtractorPool.SameResultAsExtractor ObjectClusterer.BoxesOnFloor ObjectClusterer.InvalidInput ParallelPolicy.SmallWorkIsSerial ParallelPolicy.ScheduleCoversAllItems ParallelPolicy.ForceSerial ParallelPolicy.RecordedTimeUpdatesCost ParallelPolicy.SublinearScalingLimitsThreads Pipeline.StageTimings Pipeline.SkipPixelLabels Pipeline.ReplaceRegionGrowing Pipeline.ReplaceCandidatesAndMerge Pipeline.RejectUnknownLabels PlaneQueryIndex.RequiresGeometry PlaneQueryIndex.CastRays PlaneQueryIndex.AssignPoints PlaneQueryIndex.LabelLookupMatchesBVH ICLPlaneExtraction.Refinement BoundaryRefinement.LabelsPixelsOfNonPlanarCell ResultPublisher.LatestResult ResultPublisher.ConcurrentReaders RobustRefit.NoneKeepsModel RobustRefit.TukeyRejectsOutliers RobustRefit.HuberReducesOutlierBias ShmRingBuffer.SingleProcessOrdering ShmRingBuffer.OversizedPayload ShmRingBuffer.ExistingRing ShmRingBuffer.OpenMissingRing ShmRingBuffer.RejectsFrameExceedingPayload ShmRingBuffer.FullResultsRing ShmRingBuffer.TwoProcessExtraction ThreadPlacement.ParseCpuList ThreadPlacement.InvalidCpuList ThreadPlacement.InvalidConfig ThreadPlacement.PinnedExtraction ThreadPlacement.UnpinnedExtractionAfterPinned Batch.SameRootNames Batch.Resume Server.LoopbackSession Server.StalledClientDoesntBlockOthers Server.OversizedMessage Server.PriorityBeforeArrival Server.WorkersDontOversubscribe [==[CellOrders/CellLayoutTest.IndexRoundTrip/RowMajor  # GetParam() = 4-byte object <00-00 00-00>]==] [==[CellOrders/CellLayoutTest.IndexRoundTrip/Morton  # GetParam() = 4-byte object <01-00 00-00>]==] [==[CellOrders/CellLayoutTest.IndexRoundTrip/Tiled  # GetParam() = 4-byte object <02-00 00-00>]==] [==[CellOrders/CellLayoutTest.Neighbours/RowMajor  # GetParam() = 4-byte object <00-00 00-00>]==] [==[CellOrders/CellLayoutTest.Neighbours/Morton  # GetParam() = 4-byte object <01-00 00-00>]==] [==[CellOrders/CellLayoutTest.Neighbours/Tiled  # GetParam() = 4-byte object <02-00 00-00>]==] [==[CellOrders/CellLayoutTest.DiagonalNeighbours/RowMajor  # GetParam() = 4-byte object <00-00 00-00>]==] [==[CellOrders/CellLayoutTest.DiagonalNeighbours/Morton  # GetParam() = 4-byte object <01-00 00-00>]==] [==[CellOrders/CellLayoutTest.DiagonalNeighbours/Tiled  # GetParam() = 4-byte object <02-00 00-00>]==] [==[CellOrders/CellLayoutTest.SameLabelsAsRowMajor/RowMajor  # GetParam() = 4-byte object <00-00 00-00>]==] [==[CellOrders/CellLayoutTest.SameLabelsAsRowMajor/Morton  # GetParam() = 4-byte object <01-00 00-00>]==] [==[CellOrders/CellLayoutTest.SameLabelsAsRowMajor/Tiled  # GetParam() = 4-byte object <02-00 00-00>]==])
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/process_cloud.dir/process_cloud.cpp.o"
+  "CMakeFiles/process_cloud.dir/process_cloud.cpp.o.d"
+  "process_cloud"
+  "process_cloud.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/process_cloud.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/process_sequence.dir/process_sequence.cpp.o"
+  "CMakeFiles/process_sequence.dir/process_sequence.cpp.o.d"
+  "process_sequence"
+  "process_sequence.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/process_sequence.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
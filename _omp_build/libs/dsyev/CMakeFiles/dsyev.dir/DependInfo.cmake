@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libs/dsyev/src/dsyevc3.c" "libs/dsyev/CMakeFiles/dsyev.dir/src/dsyevc3.c.o" "gcc" "libs/dsyev/CMakeFiles/dsyev.dir/src/dsyevc3.c.o.d"
+  "/root/repo/libs/dsyev/src/dsyevh3.c" "libs/dsyev/CMakeFiles/dsyev.dir/src/dsyevh3.c.o" "gcc" "libs/dsyev/CMakeFiles/dsyev.dir/src/dsyevh3.c.o.d"
+  "/root/repo/libs/dsyev/src/dsyevq3.c" "libs/dsyev/CMakeFiles/dsyev.dir/src/dsyevq3.c.o" "gcc" "libs/dsyev/CMakeFiles/dsyev.dir/src/dsyevq3.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
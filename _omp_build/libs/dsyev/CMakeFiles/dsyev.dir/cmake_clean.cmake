@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/dsyev.dir/src/dsyevc3.c.o"
+  "CMakeFiles/dsyev.dir/src/dsyevc3.c.o.d"
+  "CMakeFiles/dsyev.dir/src/dsyevh3.c.o"
+  "CMakeFiles/dsyev.dir/src/dsyevh3.c.o.d"
+  "CMakeFiles/dsyev.dir/src/dsyevq3.c.o"
+  "CMakeFiles/dsyev.dir/src/dsyevq3.c.o.d"
+  "libdsyev.pdb"
+  "libdsyev.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/dsyev.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
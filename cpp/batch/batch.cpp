@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "batch.h"
+
+#include <deplex/parallel_policy.h>
+#include <deplex/plane_extractor.h>
+#include <deplex/utils/depth_image.h>
+#include <deplex/utils/eigen_io.h>
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <map>
+#include <mutex>
+
+namespace fs = std::filesystem;
+
+namespace deplex {
+namespace batch {
+fs::path getOutputDir(fs::path const& output_dir, fs::path const& dataset_root) {
+  return output_dir / fs::weakly_canonical(fs::absolute(dataset_root)).relative_path();
+}
+
+std::vector<Task> collectTasks(Options const& options, size_t* nr_skipped) {
+  std::vector<Task> tasks;
+  for (auto const& root : options.dataset_roots) {
+    fs::path output_dir = getOutputDir(options.output_dir, root);
+    fs::create_directories(output_dir);
+
+    std::vector<fs::path> images;
+    for (auto const& entry : fs::directory_iterator(root)) {
+      if (entry.path().extension() == ".png") {
+        images.push_back(entry.path());
+      }
+    }
+    std::sort(images.begin(), images.end());
+    for (auto const& image_path : images) {
+      fs::path output_path = output_dir / image_path.filename().replace_extension(".labels");
+      if (options.resume && utils::isLabelsBinaryComplete(output_path.string())) {
+        ++*nr_skipped;
+        continue;
+      }
+      tasks.push_back({image_path, output_path});
+    }
+  }
+  return tasks;
+}
+
+Summary run(Options const& options) {
+  config::Config config(options.config_path.string());
+  Eigen::Matrix3f intrinsics(utils::readIntrinsics(options.intrinsics_path.string()));
+
+  Summary summary;
+  std::vector<Task> tasks = collectTasks(options, &summary.nr_skipped);
+
+  std::atomic<size_t> next_task{0};
+  std::atomic<size_t> nr_processed{0};
+  std::atomic<size_t> nr_failed{0};
+  std::mutex log_mutex;
+  size_t nr_workers = std::min(options.nr_threads, std::max<size_t>(tasks.size(), 1));
+
+  auto worker = [&]() {
+    // Parallelism of the run comes from workers, OpenMP teams of every worker would oversubscribe CPUs
+    ParallelPolicy::setForceSerial(nr_workers > 1);
+    // Extractors are reused between frames of the same resolution
+    std::map<std::pair<int32_t, int32_t>, PlaneExtractor> extractors;
+    for (size_t task_id = next_task++; task_id < tasks.size(); task_id = next_task++) {
+      Task const& task = tasks[task_id];
+      try {
+        utils::DepthImage image(task.image_path.string());
+        auto resolution = std::make_pair(image.getHeight(), image.getWidth());
+        auto extractor = extractors.find(resolution);
+        if (extractor == extractors.end()) {
+          PlaneExtractor algorithm(resolution.first, resolution.second, config);
+          extractor = extractors.emplace(resolution, std::move(algorithm)).first;
+        }
+        Eigen::VectorXi labels = extractor->second.process(image.toPointCloud(intrinsics));
+
+        fs::path tmp_path = task.output_path;
+        tmp_path += ".tmp";
+        utils::saveLabelsBinary(labels, image.getHeight(), image.getWidth(), tmp_path.string());
+        fs::rename(tmp_path, task.output_path);
+        ++nr_processed;
+      } catch (std::exception const& e) {
+        std::lock_guard<std::mutex> lock(log_mutex);
+        std::cerr << "Failed " << task.image_path << ": " << e.what() << '\n';
+        ++nr_failed;
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < nr_workers; ++i) {
+    workers.emplace_back(worker);
+  }
+  for (auto& thread : workers) {
+    thread.join();
+  }
+
+  summary.nr_processed = nr_processed;
+  summary.nr_failed = nr_failed;
+  summary.nr_threads = workers.size();
+  return summary;
+}
+}  // namespace batch
+}  // namespace deplex
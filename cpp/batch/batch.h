@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace deplex {
+namespace batch {
+struct Options {
+  std::filesystem::path intrinsics_path;
+  std::filesystem::path config_path;
+  std::filesystem::path output_dir;
+  size_t nr_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  bool resume = false;
+  std::vector<std::filesystem::path> dataset_roots;
+};
+
+struct Task {
+  std::filesystem::path image_path;
+  std::filesystem::path output_path;
+};
+
+struct Summary {
+  size_t nr_processed = 0;
+  // Frames with complete output, skipped by resume
+  size_t nr_skipped = 0;
+  size_t nr_failed = 0;
+  size_t nr_threads = 0;
+};
+
+/**
+ * Output directory of dataset root: absolute root path mirrored under output directory,
+ * so that roots with the same name (a/seq1, b/seq1) never share output.
+ *
+ * @param output_dir Output directory of batch run.
+ * @param dataset_root Dataset root directory.
+ * @returns <output_dir>/<absolute dataset root path>.
+ */
+std::filesystem::path getOutputDir(std::filesystem::path const& output_dir, std::filesystem::path const& dataset_root);
+
+/**
+ * Collect .png depth images of all dataset roots and create their output directories.
+ *
+ * @param options Batch run options.
+ * @param nr_skipped Output number of frames with complete output (if Options::resume is set).
+ * @returns Frames to process.
+ */
+std::vector<Task> collectTasks(Options const& options, size_t* nr_skipped);
+
+/**
+ * Process all frames of dataset roots on Options::nr_threads threads. Labels of each frame are written
+ * to temporary file and renamed (see utils::saveLabelsBinary), so output is either complete or missing.
+ * With more than one thread every frame is extracted serially, so that threads don't start OpenMP teams.
+ *
+ * @param options Batch run options.
+ * @returns Frame counters of the run.
+ */
+Summary run(Options const& options);
+}  // namespace batch
+}  // namespace deplex
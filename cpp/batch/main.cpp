@@ -0,0 +1,78 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <iostream>
+
+#include "batch.h"
+
+namespace {
+void printUsage(char const* program) {
+  std::cerr << "Usage: " << program
+            << " --intrinsics <K> --config <ini> --output <dir> [--threads N] [--resume] <dataset_root>...\n"
+               "Processes every .png depth image of each dataset root and writes\n"
+               "<output>/<absolute dataset root path>/<image>.labels (see deplex::utils::saveLabelsBinary).\n"
+               "With --resume, frames with complete output are skipped.\n";
+}
+
+bool parseOptions(int argc, char* argv[], deplex::batch::Options* options) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if (arg == "--intrinsics" && has_value) {
+      options->intrinsics_path = argv[++i];
+    } else if (arg == "--config" && has_value) {
+      options->config_path = argv[++i];
+    } else if (arg == "--output" && has_value) {
+      options->output_dir = argv[++i];
+    } else if (arg == "--threads" && has_value) {
+      options->nr_threads = std::max(std::stoul(argv[++i]), 1ul);
+    } else if (arg == "--resume") {
+      options->resume = true;
+    } else if (!arg.empty() && arg[0] != '-') {
+      options->dataset_roots.emplace_back(arg);
+    } else {
+      return false;
+    }
+  }
+  return !options->intrinsics_path.empty() && !options->config_path.empty() && !options->output_dir.empty() &&
+         !options->dataset_roots.empty();
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  deplex::batch::Options options;
+  if (!parseOptions(argc, argv, &options)) {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  auto start_time = std::chrono::high_resolution_clock::now();
+  deplex::batch::Summary summary = deplex::batch::run(options);
+  auto elapsed_time =
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start_time)
+          .count();
+
+  std::cout << "Processed frames: " << summary.nr_processed << '\n';
+  std::cout << "Skipped frames (resume): " << summary.nr_skipped << '\n';
+  std::cout << "Failed frames: " << summary.nr_failed << '\n';
+  std::cout << "Threads: " << summary.nr_threads << '\n';
+  std::cout << "Elapsed time (mks): " << elapsed_time << '\n';
+  if (summary.nr_processed > 0) {
+    std::cout << "FPS: " << 1e6l * summary.nr_processed / std::max<int64_t>(elapsed_time, 1) << '\n';
+  }
+
+  return summary.nr_failed == 0 ? 0 : 2;
+}
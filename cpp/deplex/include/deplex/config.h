@@ -21,6 +21,30 @@
 
 namespace deplex {
 namespace config {
+/**
+ * Storage order of cells in cell grid.
+ */
+enum class CellOrder : int32_t {
+  // cell_id = row * nr_horizontal_cells + col
+  kRowMajor = 0,
+  // Row-major 16x16 blocks of Z-order (bits of row and column interleaved) cells
+  kMorton,
+  // Row-major 8x8 tiles of row-major cells
+  kTiled
+};
+
+/**
+ * Robust loss of plane refit, weights points by point-to-plane residual.
+ */
+enum class RobustLoss : int32_t {
+  // No refit, plane models come from cell statistics
+  kNone = 0,
+  // Full weight within 1.345 sigma, decreasing as 1 / residual outside
+  kHuber,
+  // Smoothly decreasing weight, zero beyond 4.685 sigma
+  kTukey
+};
+
 /**
  * Wrapper class for PlaneExtractor algorithm parameters.
  *
@@ -47,6 +71,14 @@ struct Config {
    * @param config_path Path to .ini file with parameters.
    */
   Config(std::string const& config_path);
+
+  /**
+   * Parameter-wise comparison of two configs.
+   */
+  bool operator==(Config const& other) const;
+
+  bool operator!=(Config const& other) const;
+
   // Minimal size of a region, unit: pixels
   int32_t patch_size = 10;
   // Seed selection, bigger value detects dominant normal direction more precisely
@@ -79,6 +111,55 @@ struct Config {
   float ransac_threshold = 1.;
   // Minimal inliers ratio for plane points to be valid
   float ransac_inliers_ratio = 0.9;
+  // Measure thread fork/join and per-pixel stage costs on the first processed frame
+  bool parallel_calibration = false;
+  // CPUs to run processing threads on, Linux cpuset format (e.g. "0-7,16-23"), empty means any CPU.
+  // In pipelined mode the last CPU is reserved for prefetch thread
+  std::string cpu_affinity;
+  // SCHED_FIFO priority of processing threads, 0 keeps default scheduling
+  int32_t realtime_priority = 0;
+  // Storage order of cells, Morton and tiled orders improve locality of region growing on large grids
+  CellOrder cell_order = CellOrder::kRowMajor;
+  // Cell neighbourhood of region growing and plane adjacency: 4 (sides) or 8 (sides and corners)
+  int32_t cell_connectivity = 4;
+  // Maximum deviation of plane from horizontal or vertical orientation in gravity-prior mode, unit: degree
+  float gravity_tolerance = 10;
+  // Snap plane normals to the closest horizontal or vertical orientation in gravity-prior mode
+  bool gravity_snap = false;
+  // Restrict seeding and merging to three orthogonal directions of dominant (Manhattan) frame
+  bool manhattan_mode = false;
+  // Maximum deviation of plane normal from Manhattan axis, unit: degree
+  float manhattan_tolerance = 10;
+  // Merge coplanar planes, which don't touch each other (e.g. table split by object on it)
+  bool global_merge = false;
+  // Label pixels of non-planar cells bordering planes, cheap alternative to RANSAC refinement
+  bool boundary_refinement = false;
+  // Loss of iteratively reweighted refit of plane models to final plane pixels, residuals are scaled by depth noise
+  RobustLoss robust_loss = RobustLoss::kNone;
+  // Number of reweighting iterations of plane refit
+  int32_t robust_refit_iterations = 3;
+  // Output residual map and residual histograms of planes (see ExtractionResult::residuals)
+  bool residual_map = false;
+  // Residual map also holds distance of unlabelled points to the closest plane of adjacent cells
+  bool residual_map_unlabelled = false;
+  // Output denoised point cloud (see ExtractionResult::points)
+  bool denoise_points = false;
+  // Output pixel indices of each plane (see ExtractionResult::plane_pixels)
+  bool pixel_index = false;
+  // Compute boundary polygons, convex hull, area and bounding box of planes (see PlaneModel)
+  bool compute_geometry = false;
+  // Maximum number of frames queued or being processed by asynchronous API (see PlaneExtractor::extractAsync)
+  int32_t max_frames_in_flight = 2;
+  // Pipeline asynchronous frames: cell grid of the next queued frame is computed on a separate thread
+  // while the current frame runs sequential stages (region growing, merge, ...)
+  bool pipelined_processing = false;
+};
+
+/**
+ * Hash of all Config parameters, consistent with Config::operator==.
+ */
+struct ConfigHash {
+  size_t operator()(Config const& config) const;
 };
 }  // namespace config
 }  // namespace deplex
\ No newline at end of file
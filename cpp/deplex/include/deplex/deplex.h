@@ -16,5 +16,11 @@
 #pragma once
 
 #include <deplex/config.h>
+#include <deplex/extraction_result.h>
+#include <deplex/extractor_pool.h>
+#include <deplex/object_clusterer.h>
+#include <deplex/pipeline.h>
 #include <deplex/plane_extractor.h>
+#include <deplex/plane_query_index.h>
+#include <deplex/result_publisher.h>
 #include <deplex/utils/utils.h>
\ No newline at end of file
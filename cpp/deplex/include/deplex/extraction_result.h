@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace deplex {
+/**
+ * Oriented bounding box of plane region.
+ */
+struct OrientedBox {
+  Eigen::Vector3f center = Eigen::Vector3f::Zero();
+  // Columns: major in-plane axis, minor in-plane axis, plane normal
+  Eigen::Matrix3f axes = Eigen::Matrix3f::Identity();
+  // Half sizes along axes, along normal: RMS distance of points to plane
+  Eigen::Vector3f half_extents = Eigen::Vector3f::Zero();
+};
+
+// Residual histogram of PlaneModel
+constexpr int32_t kNrResidualBins = 16;
+constexpr float kResidualRange = 4;
+
+/**
+ * Parameters of extracted plane: normal.dot(p) + d = 0, normal oriented towards camera (d > 0).
+ */
+struct PlaneModel {
+  // Label of plane points in ExtractionResult::labels
+  int32_t label = 0;
+  Eigen::Vector3f normal = Eigen::Vector3f::Zero();
+  float d = 0;
+  // Centroid of plane points
+  Eigen::Vector3f mean = Eigen::Vector3f::Zero();
+  // Number of points plane was fitted to
+  int32_t nr_points = 0;
+  // Mean squared distance of points to plane, unit: squared point unit
+  float mse = 0;
+  // Planarity score, ratio of the largest eigenvalue to sum of eigenvalues
+  float score = 0;
+  // Column of ExtractionResult::manhattan_frame plane normal is aligned with, -1 outside Manhattan mode
+  int32_t manhattan_axis = -1;
+  // Histogram of signed residuals of plane points in units of depth noise sigma (Config::residual_map):
+  // kNrResidualBins bins evenly covering [-kResidualRange, kResidualRange], outliers fall into edge bins.
+  // Points filled by Config::denoise_points have no measurement and are not counted
+  std::vector<int32_t> residual_histogram;
+  // Covariance of Hessian-form parameters (normal, d), first-order propagation of point noise through PCA fit
+  Eigen::Matrix<float, 4, 4, Eigen::DontAlign> covariance = Eigen::Matrix4f::Zero();
+
+  // Geometry below is computed from cell grid if Config::compute_geometry is set
+
+  // Outer boundaries of plane region (several if region is disconnected), centers of boundary cells projected
+  // onto plane, clockwise in image
+  std::vector<std::vector<Eigen::Vector3f>> contours;
+  // Convex hull of contours, counter-clockwise around normal
+  std::vector<Eigen::Vector3f> convex_hull;
+  // Area of plane region, sum of cell footprints, unit: squared point unit
+  float area = 0;
+  OrientedBox box;
+};
+
+/**
+ * Output of plane extraction from one frame.
+ */
+struct ExtractionResult {
+  // Plane label of each point, 0 refers to non-planar segment
+  Eigen::VectorXi labels;
+  // Planes in ascending order of label
+  std::vector<PlaneModel> planes;
+  // Pixel index of planes in compressed sparse row form, filled if Config::pixel_index is set:
+  // pixels of planes[i] are plane_pixels[plane_offsets[i]], ..., plane_pixels[plane_offsets[i + 1] - 1] (ascending)
+  std::vector<int32_t> plane_offsets;
+  std::vector<int32_t> plane_pixels;
+  // Denoised point cloud [Nx3], filled if Config::denoise_points is set: plane points are moved onto their plane
+  // along viewing ray, zero-depth points inside planes are filled if camera intrinsics are set
+  Eigen::MatrixX3f points;
+  // Signed distance of each point to its plane, filled if Config::residual_map is set. Unlabelled points get NaN,
+  // or, if Config::residual_map_unlabelled is set, distance to the closest plane of adjacent cells (NaN if there
+  // is none). Invalid points (zero depth) get NaN, so points filled by Config::denoise_points are labelled but get NaN
+  Eigen::VectorXf residuals;
+  // Dominant orthogonal directions (columns), valid if has_manhattan_frame is set
+  Eigen::Matrix3f manhattan_frame = Eigen::Matrix3f::Identity();
+  bool has_manhattan_frame = false;
+};
+}  // namespace deplex
@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include "deplex/config.h"
+#include "deplex/plane_extractor.h"
+
+namespace deplex {
+/**
+ * Thread-safe cache of warm PlaneExtractor instances keyed by image shape and config.
+ *
+ * Streams switching resolution or config acquire an extractor for current frame shape,
+ * so that a switch costs a hash lookup instead of extractor construction.
+ * Idle extractors are evicted in least-recently-used order when memory limit is exceeded.
+ */
+class ExtractorPool {
+ public:
+  /**
+   * Exclusive handle to an extractor. Extractor returns to the pool when lease is destroyed,
+   * after its asynchronous frames are processed and its settings are reset (see PlaneExtractor::reset).
+   */
+  class Lease {
+   public:
+    Lease(Lease&& op) noexcept;
+    Lease& operator=(Lease&& op) noexcept;
+    ~Lease();
+
+    PlaneExtractor& operator*() const;
+    PlaneExtractor* operator->() const;
+
+   private:
+    friend class ExtractorPool;
+    struct State;
+
+    Lease(std::shared_ptr<State> state, std::unique_ptr<PlaneExtractor> extractor, int32_t image_height,
+          int32_t image_width, config::Config const& config);
+
+    std::shared_ptr<State> state_;
+    std::unique_ptr<PlaneExtractor> extractor_;
+    int32_t image_height_;
+    int32_t image_width_;
+    config::Config config_;
+  };
+
+  /**
+   * ExtractorPool constructor.
+   *
+   * @param memory_limit Maximum workspace size of all extractors (idle and leased), unit: bytes.
+   * 0 means no limit. Leased extractors are never evicted, so the limit may be exceeded while they are in use.
+   */
+  explicit ExtractorPool(size_t memory_limit = 0);
+  ~ExtractorPool();
+
+  /**
+   * Get extractor for given image shape and config. Constructs new extractor if there is no idle one.
+   *
+   * @param image_height Image height in pixels.
+   * @param image_width Image width in pixels.
+   * @param config Parameters of plane extraction algorithm.
+   * @returns Exclusive lease of the extractor.
+   */
+  Lease acquire(int32_t image_height, int32_t image_width, config::Config const& config = config::Config());
+
+  /**
+   * Number of idle extractors in the pool.
+   */
+  size_t size() const;
+
+  /**
+   * Workspace size of all extractors created by the pool and not evicted yet, unit: bytes.
+   */
+  size_t getMemoryUsage() const;
+
+  /**
+   * Drop all idle extractors.
+   */
+  void clear();
+
+ private:
+  std::shared_ptr<Lease::State> state_;
+};
+}  // namespace deplex
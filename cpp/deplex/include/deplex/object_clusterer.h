@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "deplex/extraction_result.h"
+
+namespace deplex {
+/**
+ * Object standing on support plane.
+ */
+struct ObjectCluster {
+  // Indices of object points in organized point cloud, ascending
+  std::vector<int32_t> pixels;
+  // Bounding box aligned with support plane: axes are in-plane axes and normal of support plane box
+  OrientedBox box;
+};
+
+/**
+ * Clustering of points above support plane (e.g. table) into objects.
+ *
+ * Points between minimal and maximal height above support plane, whose projection lies inside its convex hull,
+ * are grouped into 4-connected components on organized image grid. Neighbour points are connected
+ * if their depth difference doesn't exceed discontinuity threshold. Two raster passes with union-find
+ * replace Euclidean clustering of the whole cloud, workspace is reused between frames.
+ */
+class ObjectClusterer {
+ public:
+  /**
+   * ObjectClusterer constructor.
+   *
+   * @param image_height Image height in pixels.
+   * @param image_width Image width in pixels.
+   * @param depth_discontinuity_threshold Maximum depth difference of connected neighbour points.
+   * @param min_cluster_size Minimum number of object points, smaller components are dropped.
+   */
+  ObjectClusterer(int32_t image_height, int32_t image_width, float depth_discontinuity_threshold = 160,
+                  int32_t min_cluster_size = 50);
+
+  /**
+   * Cluster points above support plane.
+   *
+   * @param pcd_array Points matrix [Nx3] of ORGANIZED point cloud.
+   * @param result Extraction result of the cloud, plane geometry (Config::compute_geometry) is required.
+   * @param support_label Label of support plane.
+   * @param min_height Minimum height of object point above support plane.
+   * @param max_height Maximum height of object point above support plane.
+   * @returns Objects in raster order of their first point.
+   */
+  std::vector<ObjectCluster> cluster(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array,
+                                     ExtractionResult const& result, int32_t support_label, float min_height,
+                                     float max_height);
+
+ private:
+  int32_t image_height_;
+  int32_t image_width_;
+  float depth_discontinuity_threshold_;
+  int32_t min_cluster_size_;
+  // Provisional component of each pixel, -1 for points not above support plane
+  std::vector<int32_t> components_;
+  // Union-find parents of provisional components
+  std::vector<int32_t> parents_;
+
+  int32_t findRoot(int32_t component);
+};
+}  // namespace deplex
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "deplex/extraction_result.h"
+
+namespace deplex {
+/**
+ * Stages of plane extraction in execution order.
+ */
+enum class PipelineStage : int32_t {
+  // Cell statistics and planarity test
+  kCellGrid = 0,
+  // Selection of cells allowed to seed and join planes (gravity prior)
+  kCandidateSelection,
+  // Seed choice and growing of plane segments from seed cells, Manhattan frame estimation
+  kRegionGrowing,
+  // Merge of adjacent (and coplanar, see Config::global_merge) segments into planes
+  kMerge,
+  // Rasterization of cell labels to pixel labels
+  kLabels,
+  // Boundary and RANSAC refinement of pixel labels
+  kRefinement,
+  // Plane models and per-plane outputs: refit, residuals, denoising, pixel index, geometry
+  kPlaneModels,
+  kNrStages
+};
+
+constexpr size_t kNrPipelineStages = static_cast<size_t>(PipelineStage::kNrStages);
+
+/**
+ * Intermediate data of frame being processed, passed to hooks (see StageHook).
+ * Cell data of a stage is exported only if there are hooks at this or any later stage, so that pipelines
+ * without hooks don't pay for conversions. Cells are stored in row-major order [nr_cell_rows x nr_cell_cols].
+ */
+struct PipelineFrame {
+  int32_t nr_cell_rows = 0;
+  int32_t nr_cell_cols = 0;
+  // kCellGrid output (read-only): planarity, normal, mean and plane fit MSE of each cell
+  std::vector<bool> cell_planar;
+  Eigen::MatrixX3f cell_normals;
+  Eigen::MatrixX3f cell_means;
+  Eigen::VectorXf cell_mse;
+  // kCandidateSelection output: cells allowed to seed and join planes
+  std::vector<bool> candidate_cells;
+  // kRegionGrowing output: segment id of each cell starting from 1, 0 - no segment.
+  // Every segment set by a hook has to cover at least one cell with valid points
+  Eigen::MatrixXi cell_segments;
+  // kMerge output: plane label of each cell starting from 1, 0 - no plane, same requirement as cell_segments
+  Eigen::MatrixXi cell_labels;
+  // kLabels and kRefinement output: result.labels, kPlaneModels output: the rest of result
+  ExtractionResult result;
+};
+
+/**
+ * User stage called after pipeline stage. Hook may read frame data and rewrite output of the stage it is
+ * attached to, e.g. a hook at disabled kRegionGrowing stage replaces region growing by filling cell_segments.
+ * Modifications of outputs of other stages are ignored.
+ *
+ * @param pcd_array Points matrix [Nx3] of ORGANIZED point cloud being processed.
+ * @param frame Intermediate data of the frame.
+ */
+using StageHook = std::function<void(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array, PipelineFrame* frame)>;
+}  // namespace deplex
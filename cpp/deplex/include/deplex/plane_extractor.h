@@ -15,13 +15,49 @@
  */
 #pragma once
 
+#include <exception>
+#include <functional>
+#include <future>
 #include <memory>
+#include <vector>
 
 #include <Eigen/Core>
 
 #include "deplex/config.h"
+#include "deplex/extraction_result.h"
+#include "deplex/pipeline.h"
 
 namespace deplex {
+/**
+ * Reference-counted point cloud for asynchronous processing. Points are not copied: owner keeps their memory
+ * alive until the frame is processed.
+ */
+struct PointCloudBuffer {
+  /**
+   * Buffer owning point cloud matrix.
+   *
+   * @param matrix Points matrix [Nx3] of ORGANIZED point cloud, non-null.
+   */
+  PointCloudBuffer(std::shared_ptr<const Eigen::MatrixX3f> matrix);
+
+  /**
+   * Buffer of points stored elsewhere (e.g. shared memory slot).
+   *
+   * @param points Points matrix [Nx3] of ORGANIZED point cloud.
+   * @param owner Object keeping memory of points alive, may be null if memory outlives processing.
+   */
+  PointCloudBuffer(Eigen::Map<const Eigen::MatrixX3f> points, std::shared_ptr<const void> owner);
+
+  Eigen::Map<const Eigen::MatrixX3f> points;
+  std::shared_ptr<const void> owner;
+};
+
+/**
+ * Completion callback of asynchronous extraction. Called on extractor's worker thread with result,
+ * or with exception thrown by extraction (result is then empty).
+ */
+using ExtractionCallback = std::function<void(ExtractionResult result, std::exception_ptr error)>;
+
 /**
  * Algorithm for plane extraction from RGB-D data.
  */
@@ -35,17 +71,151 @@ class PlaneExtractor {
    * @param config Parameters of plane extraction algorithm.
    */
   PlaneExtractor(int32_t image_height, int32_t image_width, config::Config config = config::Config());
+
+  /**
+   * Destructor waits until all asynchronous frames are processed.
+   */
   ~PlaneExtractor();
 
   /**
    * Extract planes from given image.
    *
    * @param pcd_array Points matrix [Nx3] of ORGANIZED point cloud
-   * i.e. points that refer to organized image structure.
+   * i.e. points that refer to organized image structure. Mapped buffers (e.g. shared memory) are accepted as is.
    * @returns 1D Array, where i-th value is plane number to which refers i-th point of point cloud.
    * 0-value label refers to non-planar segment.
+   * @note Calling thread is pinned according to Config::cpu_affinity and Config::realtime_priority for
+   * the duration of the call, its previous placement is restored afterwards. OpenMP team of the calling thread
+   * runs with real-time priority during the call only. Its CPUs are pinned by the first call and kept between calls,
+   * until a call with other CPUs or without placement on the same thread.
+   */
+  Eigen::VectorXi process(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array);
+
+  /**
+   * Extract horizontal and vertical planes from given image using gravity prior (e.g. from IMU).
+   * Cells deviating from both orientations by more than Config::gravity_tolerance are rejected before
+   * seeding and region growing. Plane normals are snapped to the closest orientation if Config::gravity_snap is set.
+   *
+   * @param pcd_array Points matrix [Nx3] of ORGANIZED point cloud.
+   * @param gravity Gravity direction in camera coordinates, any non-zero length.
+   * @returns 1D Array, where i-th value is plane number to which refers i-th point of point cloud.
+   * 0-value label refers to non-planar segment.
+   */
+  Eigen::VectorXi process(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array, Eigen::Vector3f const& gravity);
+
+  /**
+   * Extract planes from given image.
+   *
+   * @param pcd_array Points matrix [Nx3] of ORGANIZED point cloud.
+   * @returns Point labels, plane models and Manhattan frame (if Config::manhattan_mode is set).
+   */
+  ExtractionResult extract(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array);
+
+  /**
+   * Extract horizontal and vertical planes from given image using gravity prior (see process).
+   * In Manhattan mode gravity is used as the first axis of Manhattan frame.
+   *
+   * @param pcd_array Points matrix [Nx3] of ORGANIZED point cloud.
+   * @param gravity Gravity direction in camera coordinates, any non-zero length.
+   * @returns Point labels, plane models and Manhattan frame (if Config::manhattan_mode is set).
+   */
+  ExtractionResult extract(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array, Eigen::Vector3f const& gravity);
+
+  /**
+   * Enqueue frame on extractor's worker thread, which is started by the first asynchronous call.
+   * Frames are processed in order of submission, synchronous calls wait for the frame being processed.
+   *
+   * @param pcd_array Reference-counted points matrix [Nx3] of ORGANIZED point cloud.
+   * @returns Future of point labels (see process).
+   * @throws std::runtime_error if Config::max_frames_in_flight frames are queued or being processed.
+   */
+  std::future<Eigen::VectorXi> processAsync(PointCloudBuffer pcd_array);
+
+  /**
+   * Enqueue frame on extractor's worker thread (see processAsync).
+   *
+   * @param pcd_array Reference-counted points matrix [Nx3] of ORGANIZED point cloud.
+   * @returns Future of point labels, plane models and Manhattan frame (see extract).
+   */
+  std::future<ExtractionResult> extractAsync(PointCloudBuffer pcd_array);
+
+  /**
+   * Enqueue frame on extractor's worker thread (see processAsync).
+   *
+   * @param pcd_array Reference-counted points matrix [Nx3] of ORGANIZED point cloud.
+   * @param callback Completion callback, called on worker thread. Exceptions thrown by callback are ignored.
+   * Callback may destroy the extractor, the rest of the queue is then processed by the destructor.
+   */
+  void extractAsync(PointCloudBuffer pcd_array, ExtractionCallback callback);
+
+  /**
+   * Number of asynchronous frames queued or being processed.
+   */
+  size_t getFramesInFlight() const;
+
+  /**
+   * Set camera intrinsics point clouds are created with. Enables filling of zero-depth plane points
+   * by Config::denoise_points.
+   * Like other stage settings, waits for the frame being processed and must not be called from stage hooks.
+   *
+   * @param intrinsics Camera intrinsic matrix.
+   */
+  void setIntrinsics(Eigen::Matrix3f const& intrinsics);
+
+  /**
+   * Enable or disable pipeline stage. Disabled stage passes its input through:
+   * kCandidateSelection - all planar cells are candidates, kRegionGrowing - no segments,
+   * kMerge - each segment is a plane, kLabels - no pixel labels (ExtractionResult::labels is empty,
+   * pixel-based outputs are skipped), kRefinement - coarse labels, kPlaneModels - no plane models.
+   *
+   * Waits for the frame being processed, applies from the next one.
+   *
+   * @param stage Pipeline stage, kCellGrid can't be disabled.
+   * @param enabled true to run the stage.
+   */
+  void setStageEnabled(PipelineStage stage, bool enabled);
+
+  bool isStageEnabled(PipelineStage stage) const;
+
+  /**
+   * Add user stage called after pipeline stage (also if the stage is disabled), hooks of one stage are called
+   * in order of addition. Stages after region growing are not run, if frame has no plane segments.
+   * Hooks run while extractor is locked, so they must not call its methods.
+   *
+   * @param stage Pipeline stage the hook follows.
+   * @param hook User stage.
+   */
+  void addStageHook(PipelineStage stage, StageHook hook);
+
+  /**
+   * Remove all hooks of all stages.
+   */
+  void clearStageHooks();
+
+  /**
+   * Duration of each pipeline stage including its hooks during the last processed frame.
+   *
+   * @returns Durations indexed by PipelineStage, unit: microseconds. Stages which were not reached
+   * (see addStageHook) have zero duration.
+   */
+  std::vector<double> getStageTimings() const;
+
+  /**
+   * Wait until all asynchronous frames are processed and restore settings made after construction:
+   * intrinsics are dropped, all stages are enabled, stage hooks and timings are cleared.
+   *
+   * @throws std::runtime_error if called from completion callback.
+   */
+  void reset();
+
+  /**
+   * Size of memory allocated by extractor for intermediate per-frame data.
+   * Workspace is allocated by the first process call and reused by the following ones, so its memory lives
+   * on the NUMA node of the thread processing frames (see Config::cpu_affinity).
+   *
+   * @returns Workspace size, unit: bytes.
    */
-  Eigen::VectorXi process(Eigen::MatrixX3f const& pcd_array);
+  size_t getWorkspaceSize() const;
 
   PlaneExtractor(PlaneExtractor&& op) noexcept;
   PlaneExtractor& operator=(PlaneExtractor&& op) noexcept;
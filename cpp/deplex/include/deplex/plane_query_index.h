@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "deplex/extraction_result.h"
+
+namespace deplex {
+/**
+ * Intersection of ray with plane polygon.
+ */
+struct RayHit {
+  // Label of hit plane, 0 if ray doesn't hit any plane
+  int32_t label = 0;
+  // Distance from ray origin in units of ray direction length
+  float distance = std::numeric_limits<float>::infinity();
+  Eigen::Vector3f point = Eigen::Vector3f::Zero();
+};
+
+/**
+ * Spatial index over planes of one frame answering which plane a ray hits or a point belongs to.
+ *
+ * Planes are represented by their convex hulls (Config::compute_geometry must be set during extraction)
+ * and stored in bounding volume hierarchy. Point queries first look up plane label of the pixel point projects to,
+ * BVH is traversed only if that plane doesn't match.
+ */
+class PlaneQueryIndex {
+ public:
+  /**
+   * PlaneQueryIndex constructor without label image lookup, every query traverses BVH.
+   *
+   * @param result Extraction result with plane geometry.
+   */
+  explicit PlaneQueryIndex(ExtractionResult const& result);
+
+  /**
+   * PlaneQueryIndex constructor.
+   *
+   * @param result Extraction result with plane geometry.
+   * @param image_height Height of labels image.
+   * @param image_width Width of labels image.
+   * @param intrinsics Camera intrinsic matrix the point cloud was created with.
+   */
+  PlaneQueryIndex(ExtractionResult const& result, int32_t image_height, int32_t image_width,
+                  Eigen::Matrix3f const& intrinsics);
+
+  PlaneQueryIndex(PlaneQueryIndex&& op) noexcept;
+  PlaneQueryIndex& operator=(PlaneQueryIndex&& op) noexcept;
+  ~PlaneQueryIndex();
+
+  /**
+   * Find the closest plane polygon hit by ray.
+   *
+   * @param origin Ray origin.
+   * @param direction Ray direction.
+   * @param max_distance Maximum hit distance in units of direction length.
+   * @returns Closest hit, label 0 if there is none.
+   */
+  RayHit castRay(Eigen::Vector3f const& origin, Eigen::Vector3f const& direction,
+                 float max_distance = std::numeric_limits<float>::infinity()) const;
+
+  /**
+   * Batched castRay.
+   *
+   * @param origins Ray origins [N, 3].
+   * @param directions Ray directions [N, 3].
+   * @param max_distance Maximum hit distance in units of direction length.
+   * @returns Closest hit of each ray.
+   */
+  std::vector<RayHit> castRays(Eigen::Ref<const Eigen::MatrixX3f> const& origins,
+                               Eigen::Ref<const Eigen::MatrixX3f> const& directions,
+                               float max_distance = std::numeric_limits<float>::infinity()) const;
+
+  /**
+   * Find plane point belongs to: the closest plane within max_distance, whose polygon contains point projection.
+   *
+   * @param point Point in camera frame.
+   * @param max_distance Maximum distance from point to plane.
+   * @returns Plane label, 0 if point doesn't belong to any plane.
+   */
+  int32_t assignPoint(Eigen::Vector3f const& point, float max_distance) const;
+
+  /**
+   * Batched assignPoint.
+   *
+   * @param points Points in camera frame [N, 3].
+   * @param max_distance Maximum distance from point to plane.
+   * @returns Plane label of each point.
+   */
+  Eigen::VectorXi assignPoints(Eigen::Ref<const Eigen::MatrixX3f> const& points, float max_distance) const;
+
+  /**
+   * Number of indexed planes.
+   */
+  size_t size() const;
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace deplex
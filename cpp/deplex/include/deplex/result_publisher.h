@@ -0,0 +1,115 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "deplex/extraction_result.h"
+
+namespace deplex {
+/**
+ * Extraction result published to consumers.
+ */
+struct PublishedResult {
+  ExtractionResult result;
+  // Stage durations of the frame (see PlaneExtractor::getStageTimings)
+  std::vector<double> stage_timings;
+  // Number of the publication starting from 1
+  uint64_t sequence_number = 0;
+};
+
+/**
+ * Publication of the latest extraction result from one producer to many consumer threads.
+ *
+ * Results are moved into a fixed set of slots (max_snapshots + 2, i.e. triple buffering for a single reader):
+ * the latest result, the one being written and the ones pinned by snapshots. Readers pin the latest slot
+ * with an atomic reference count and never take a lock, the producer never blocks, waits for readers or copies.
+ * A reader retries only if a new result was published between reading the latest slot and pinning it.
+ */
+class ResultPublisher {
+ private:
+  struct Slot {
+    PublishedResult published;
+    std::atomic<int32_t> nr_readers{0};
+  };
+
+ public:
+  /**
+   * Pinned published result. Slot isn't overwritten while snapshot is alive.
+   */
+  class Snapshot {
+   public:
+    Snapshot() = default;
+    Snapshot(Snapshot&& op) noexcept;
+    Snapshot& operator=(Snapshot&& op) noexcept;
+    Snapshot(Snapshot const&) = delete;
+    Snapshot& operator=(Snapshot const&) = delete;
+    ~Snapshot();
+
+    PublishedResult const& operator*() const { return slot_->published; }
+    PublishedResult const* operator->() const { return &slot_->published; }
+
+    /**
+     * @returns false for empty snapshot (nothing was published yet).
+     */
+    explicit operator bool() const { return slot_ != nullptr; }
+
+   private:
+    friend class ResultPublisher;
+    explicit Snapshot(Slot* slot) : slot_(slot) {}
+
+    Slot* slot_ = nullptr;
+  };
+
+  /**
+   * ResultPublisher constructor.
+   *
+   * @param max_snapshots Maximum number of snapshots alive at the same time, e.g. one per reader thread.
+   */
+  explicit ResultPublisher(int32_t max_snapshots = 4);
+
+  /**
+   * Publish result, only one thread may publish at a time.
+   *
+   * @param result Extraction result, moved into the slot.
+   * @param stage_timings Stage durations of the frame.
+   * @returns false if all slots are pinned by more than max_snapshots snapshots, result is then dropped.
+   */
+  bool publish(ExtractionResult result, std::vector<double> stage_timings = {});
+
+  /**
+   * Pin the latest published result. Snapshots must not outlive the publisher.
+   *
+   * @returns Snapshot of the latest result, empty if nothing was published yet.
+   */
+  Snapshot getLatest() const;
+
+  /**
+   * Number of published results.
+   */
+  uint64_t getNrPublished() const;
+
+ private:
+  int32_t nr_slots_;
+  std::unique_ptr<Slot[]> slots_;
+  // Slot of the latest result, -1 if nothing was published
+  std::atomic<int32_t> latest_;
+  std::atomic<uint64_t> nr_published_;
+};
+}  // namespace deplex
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <Eigen/Core>
+#include <string>
 
 namespace deplex {
 namespace utils {
@@ -44,5 +45,38 @@ Eigen::Matrix3f readIntrinsics(std::string const& intrinsics_path);
  * @param path Path to output file.
  */
 void savePointCloudCSV(Eigen::MatrixXf const& pcd_points, std::string const& path);
+
+/**
+ * Write plane labels to binary file.
+ *
+ * File layout: 8-byte signature "DPLXLBL1", int32 image height, int32 image width,
+ * followed by [height x width] int32 labels (native byte order).
+ *
+ * @param labels Labels returned by PlaneExtractor::process.
+ * @param image_height Image height in pixels.
+ * @param image_width Image width in pixels.
+ * @param path Path to output file.
+ */
+void saveLabelsBinary(Eigen::VectorXi const& labels, int32_t image_height, int32_t image_width,
+                      std::string const& path);
+
+/**
+ * Read plane labels from binary file written by saveLabelsBinary.
+ *
+ * @param path Path to input file.
+ * @param image_height Output image height, may be nullptr.
+ * @param image_width Output image width, may be nullptr.
+ * @returns Labels [height x width].
+ */
+Eigen::VectorXi readLabelsBinary(std::string const& path, int32_t* image_height = nullptr,
+                                 int32_t* image_width = nullptr);
+
+/**
+ * Check that file written by saveLabelsBinary is complete: signature is valid and file size matches image shape.
+ *
+ * @param path Path to labels file.
+ * @returns false if file is missing, truncated or not a labels file.
+ */
+bool isLabelsBinaryComplete(std::string const& path);
 }  // namespace utils
 }  // namespace deplex
\ No newline at end of file
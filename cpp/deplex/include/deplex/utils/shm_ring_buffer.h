@@ -0,0 +1,182 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#ifndef _WIN32
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "deplex/plane_extractor.h"
+
+namespace deplex {
+namespace utils {
+/**
+ * Layout of a frame payload stored in a ring slot.
+ */
+enum class FrameFormat : uint32_t {
+  // Depth image [height x width] of uint16_t values, row-major
+  kDepthU16 = 0,
+  // Organized point cloud [(height * width) x 3] of floats, Eigen::MatrixX3f (column-major) storage
+  kPointsF32 = 1,
+  // Plane labels [height * width] of int32_t values, as returned by PlaneExtractor::process
+  kLabelsI32 = 2
+};
+
+/**
+ * Header written in front of every frame payload.
+ */
+struct FrameHeader {
+  // Frame number assigned by the producer
+  uint64_t sequence;
+  // Capture timestamp, unit: nanoseconds
+  uint64_t timestamp_ns;
+  int32_t height;
+  int32_t width;
+  FrameFormat format;
+  // Multiplier converting raw depth values to point cloud units (kDepthU16 only)
+  float depth_scale;
+  // Camera intrinsics, used to transform kDepthU16 frames to point cloud
+  float fx, fy, cx, cy;
+  // Size of payload following the header, unit: bytes
+  uint64_t payload_size;
+};
+
+/**
+ * Lock-free single-producer single-consumer ring of frames in POSIX shared memory.
+ *
+ * One process creates the ring, the other one opens it by name. Slots are written and read in place,
+ * so frames are never copied between processes.
+ */
+class ShmRingBuffer {
+ public:
+  /**
+   * Create new shared memory ring.
+   *
+   * @param name Shared memory object name, e.g. "/deplex_frames".
+   * @param nr_slots Number of frames the ring can hold.
+   * @param slot_capacity Maximum payload size of a frame, unit: bytes.
+   * @param replace_existing Unlink existing object with the same name first, e.g. stale ring of crashed producer.
+   * Otherwise existing object is an error, so that live ring of another producer is never taken over.
+   * @returns Ring owning the shared memory object (it is unlinked on destruction).
+   * @throws std::runtime_error if object exists and replace_existing is false, or it can't be created.
+   */
+  static ShmRingBuffer create(std::string const& name, uint32_t nr_slots, size_t slot_capacity,
+                              bool replace_existing = false);
+
+  /**
+   * Attach to the ring created by another process. Ring geometry is validated against size of shared memory object.
+   *
+   * @param name Shared memory object name.
+   * @returns Ring attached to existing shared memory object.
+   */
+  static ShmRingBuffer open(std::string const& name);
+
+  ~ShmRingBuffer();
+
+  ShmRingBuffer(ShmRingBuffer&& op) noexcept;
+  ShmRingBuffer& operator=(ShmRingBuffer&& op) noexcept;
+
+  ShmRingBuffer(ShmRingBuffer const&) = delete;
+  ShmRingBuffer& operator=(ShmRingBuffer const&) = delete;
+
+  /**
+   * Get payload of the next free slot (producer side).
+   *
+   * @returns Pointer to slot payload of getSlotCapacity() bytes, nullptr if ring is full.
+   */
+  void* tryAcquireWrite();
+
+  /**
+   * Publish frame written into the payload returned by tryAcquireWrite().
+   *
+   * @param header Frame header, payload_size must not exceed slot capacity.
+   */
+  void commitWrite(FrameHeader const& header);
+
+  /**
+   * Get the oldest unread frame (consumer side).
+   *
+   * @param header Output header of the frame.
+   * @returns Pointer to frame payload, nullptr if ring is empty. Payload stays valid until releaseRead().
+   */
+  void const* tryAcquireRead(FrameHeader* header);
+
+  /**
+   * Return slot of the frame returned by tryAcquireRead() to the producer.
+   */
+  void releaseRead();
+
+  /**
+   * Mark stream as finished. Consumer sees it after reading all remaining frames.
+   */
+  void close();
+
+  bool isClosed() const;
+
+  /**
+   * Number of frames published, but not yet released by consumer.
+   */
+  size_t size() const;
+
+  uint32_t getSlotCount() const;
+
+  size_t getSlotCapacity() const;
+
+ private:
+  struct ControlBlock;
+
+  ShmRingBuffer(std::string name, void* mapping, size_t mapping_size, bool owner);
+
+  std::string name_;
+  void* mapping_;
+  size_t mapping_size_;
+  bool owner_;
+  ControlBlock* control_;
+  unsigned char* slots_;
+  // Ring geometry, copy of validated control block values
+  uint32_t nr_slots_;
+  size_t slot_capacity_;
+  size_t slot_stride_;
+};
+
+/**
+ * Run plane extraction over frames of the shared memory ring.
+ *
+ * kPointsF32 frames are processed directly from shared memory, kDepthU16 frames are transformed to point cloud
+ * with intrinsics and depth scale from frame header. Labels are published to results ring as kLabelsI32 frames with
+ * the sequence and timestamp of the input frame. Empty and full rings are polled with backoff (yield, then sleep).
+ * Input slot is released on every path. Frames whose format is unknown or whose shape doesn't fit their payload or
+ * ring slot are rejected: they are counted and skipped, so no labels are published for their sequence.
+ *
+ * @param extractor Plane extractor matching frames resolution.
+ * @param frames Input ring, consumer side.
+ * @param results Output ring, producer side.
+ * @param max_frames Stop after given number of input frames (rejected ones included), negative value means until
+ * input ring is closed.
+ * @param result_timeout_ms Maximum wait for free slot of results ring, negative value means no limit.
+ * Consumer closes results ring to stop the loop.
+ * @param nr_rejected Optional output, incremented by number of rejected frames.
+ * @returns Number of processed frames (labels published to results ring).
+ * @throws std::runtime_error if extraction fails or results ring stays full.
+ */
+int64_t processShmFrames(PlaneExtractor* extractor, ShmRingBuffer* frames, ShmRingBuffer* results,
+                         int64_t max_frames = -1, int64_t result_timeout_ms = 1000, int64_t* nr_rejected = nullptr);
+}  // namespace utils
+}  // namespace deplex
+
+#endif
@@ -16,4 +16,5 @@
 #pragma once
 
 #include <deplex/utils/depth_image.h>
-#include <deplex/utils/eigen_io.h>
\ No newline at end of file
+#include <deplex/utils/eigen_io.h>
+#include <deplex/utils/shm_ring_buffer.h>
\ No newline at end of file
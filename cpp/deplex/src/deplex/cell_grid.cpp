@@ -17,32 +17,59 @@
 
 #include <utility>
 
+#include "parallel_policy.h"
+
 namespace deplex {
-CellGrid::CellGrid(Eigen::Matrix<float, Eigen::Dynamic, 3, Eigen::RowMajor> const& points, config::Config const& config,
-                   int32_t number_horizontal_cells, int32_t number_vertical_cells)
+CellGrid::CellGrid(config::Config const& config, CellLayout const& layout, int32_t image_width)
     : cell_width_(config.patch_size),
       cell_height_(config.patch_size),
-      number_horizontal_cells_(number_horizontal_cells),
-      number_vertical_cells_(number_vertical_cells),
-      parent_(number_vertical_cells * number_horizontal_cells),
-      component_size_(number_vertical_cells * number_horizontal_cells, 1),
-      planar_mask_(number_vertical_cells * number_horizontal_cells) {
-  cell_grid_.reserve(planar_mask_.size());
-  Eigen::Matrix<float, Eigen::Dynamic, 3, Eigen::RowMajor> cell_continuous_points(points.rows(), points.cols());
-  cellContinuousOrganize(points, &cell_continuous_points);
-
-  Eigen::Map<const Eigen::Matrix<float, Eigen::Dynamic, 3, Eigen::RowMajor>> cell_points(cell_continuous_points.data(),
-                                                                                         cell_width_ * cell_height_, 3);
-#pragma omp parallel for default(none) shared(cell_continuous_points, config) firstprivate(cell_points)
-  for (Eigen::Index cell_id = 0; cell_id < number_horizontal_cells_ * number_vertical_cells_; ++cell_id) {
-    Eigen::Index offset = cell_id * cell_height_ * cell_width_ * 3;
-    new (&cell_points) decltype(cell_points)(cell_continuous_points.data() + offset, cell_width_ * cell_height_, 3);
-    cell_grid_[cell_id] = std::move(CellSegment(cell_points, config));
+      image_width_(image_width),
+      layout_(layout),
+      config_(config) {}
+
+void CellGrid::allocateWorkspace() {
+  size_t nr_cells = layout_.size();
+  if (cell_grid_.size() == nr_cells) {
+    return;
+  }
+  cell_continuous_points_.resize(nr_cells * cell_width_ * cell_height_, 3);
+  parent_.resize(nr_cells);
+  component_size_.resize(nr_cells, 1);
+  cell_grid_.resize(nr_cells);
+  planar_mask_.resize(nr_cells);
+}
+
+void CellGrid::update(Eigen::Ref<const Eigen::MatrixX3f> const& points) {
+  allocateWorkspace();
+  cellContinuousOrganize(points, &cell_continuous_points_);
+
+  Eigen::Map<const Eigen::Matrix<float, Eigen::Dynamic, 3, Eigen::RowMajor>> cell_points(
+      cell_continuous_points_.data(), cell_width_ * cell_height_, 3);
+  auto schedule = ParallelPolicy::global().getSchedule(ParallelStage::kCellStatistics, cell_grid_.size(),
+                                                       cell_width_ * cell_height_);
+  ParallelPolicy::StageTimer timer(ParallelStage::kCellStatistics, schedule, cell_continuous_points_.rows());
+#pragma omp parallel for default(none) firstprivate(cell_points) shared(schedule) num_threads(schedule.nr_threads) \
+    schedule(static, schedule.grain_size) if (schedule.nr_threads > 1)
+  for (Eigen::Index cell_id = 0; cell_id < static_cast<Eigen::Index>(cell_grid_.size()); ++cell_id) {
     parent_[cell_id] = cell_id;
+    component_size_[cell_id] = 1;
+    if (!layout_.isValid(cell_id)) {
+      planar_mask_[cell_id] = false;
+      continue;
+    }
+    Eigen::Index offset = cell_id * cell_height_ * cell_width_ * 3;
+    new (&cell_points) decltype(cell_points)(cell_continuous_points_.data() + offset, cell_width_ * cell_height_, 3);
+    cell_grid_[cell_id] = CellSegment(cell_points, config_);
     planar_mask_[cell_id] = cell_grid_[cell_id].isPlanar();
   }
 }
 
+size_t CellGrid::getWorkspaceSize(CellLayout const& layout, int32_t patch_size) {
+  size_t nr_cells = layout.size();
+  return nr_cells * patch_size * patch_size * 3 * sizeof(float) +
+         nr_cells * (sizeof(CellSegment) + sizeof(size_t) + sizeof(int)) + nr_cells / 8;
+}
+
 size_t CellGrid::findLabel(size_t cell_id) {
   return (parent_[cell_id] == cell_id) ? cell_id : parent_[cell_id] = findLabel(parent_[cell_id]);
 }
@@ -60,24 +87,33 @@ void CellGrid::updateCell(size_t cell_id, CellSegment new_cell) {
   cell_grid_[cell_id] = std::move(new_cell);
 }
 
+CellLayout const& CellGrid::getLayout() const { return layout_; }
+
 CellSegment const& CellGrid::operator[](size_t cell_id) const { return cell_grid_[cell_id]; }
 
 std::vector<bool> const& CellGrid::getPlanarMask() const { return planar_mask_; }
 
 size_t CellGrid::size() const { return planar_mask_.size(); }
 
-void CellGrid::cellContinuousOrganize(Eigen::Matrix<float, Eigen::Dynamic, 3, Eigen::RowMajor> const& unorganized_data,
+void CellGrid::cellContinuousOrganize(Eigen::Ref<const Eigen::MatrixX3f> const& unorganized_data,
                                       Eigen::Matrix<float, Eigen::Dynamic, 3, Eigen::RowMajor>* organized_pcd) {
-  int32_t image_width = number_horizontal_cells_ * cell_width_;
-#pragma omp parallel for default(none) shared(cell_width_, cell_height_, organized_pcd, unorganized_data, image_width)
-  for (Eigen::Index cell_id = 0; cell_id < number_horizontal_cells_ * number_vertical_cells_; ++cell_id) {
+  auto nr_slots = static_cast<Eigen::Index>(layout_.size());
+  auto schedule =
+      ParallelPolicy::global().getSchedule(ParallelStage::kCellOrganize, nr_slots, cell_width_ * cell_height_);
+  ParallelPolicy::StageTimer timer(ParallelStage::kCellOrganize, schedule, organized_pcd->rows());
+#pragma omp parallel for default(none) shared(organized_pcd, unorganized_data, nr_slots, schedule) \
+    num_threads(schedule.nr_threads) schedule(static, schedule.grain_size) if (schedule.nr_threads > 1)
+  for (Eigen::Index cell_id = 0; cell_id < nr_slots; ++cell_id) {
+    if (!layout_.isValid(cell_id)) {
+      continue;
+    }
     Eigen::Index outer_cell_stride = cell_width_ * cell_height_ * cell_id;
+    Eigen::Index cell_origin = static_cast<Eigen::Index>(layout_.getRow(cell_id)) * cell_height_ * image_width_ +
+                               layout_.getCol(cell_id) * cell_width_;
     for (Eigen::Index i = 0; i < cell_height_; ++i) {
       Eigen::Index cell_row_stride = i * cell_width_;
       organized_pcd->block(cell_row_stride + outer_cell_stride, 0, cell_width_, 3) =
-          unorganized_data.block(i * image_width + (cell_id / number_horizontal_cells_ * image_width * cell_height_) +
-                                     (cell_id * cell_width_) % image_width,
-                                 0, cell_height_, 3);
+          unorganized_data.block(cell_origin + i * image_width_, 0, cell_width_, 3);
     }
   }
 }
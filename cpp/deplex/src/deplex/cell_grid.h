@@ -17,6 +17,7 @@
 
 #include <Eigen/Core>
 
+#include "cell_layout.h"
 #include "cell_segment.h"
 
 namespace deplex {
@@ -27,14 +28,36 @@ class CellGrid {
  public:
   /**
    * CellGrid constructor.
+   * Workspace is allocated by the first update(), so that its memory is first touched
+   * by the thread (and NUMA node) processing frames rather than by the constructing one.
    *
-   * @param points Point cloud points (row-major).
    * @param config Plane extractor config.
-   * @param number_horizontal_cells Total number of horizontal cells.
-   * @param number_vertical_cells Total number of vertical cells.
+   * @param layout Grid shape and storage order of cells.
+   * @param image_width Image width in pixels.
    */
-  CellGrid(Eigen::Matrix<float, Eigen::Dynamic, 3, Eigen::RowMajor> const& points, config::Config const& config,
-           int32_t number_horizontal_cells, int32_t number_vertical_cells);
+  CellGrid(config::Config const& config, CellLayout const& layout, int32_t image_width);
+
+  /**
+   * Recompute cells from new point cloud, reusing allocated workspace.
+   *
+   * @param points Points matrix [Nx3] of ORGANIZED point cloud.
+   */
+  void update(Eigen::Ref<const Eigen::MatrixX3f> const& points);
+
+  /**
+   * Size of workspace, allocated or to be allocated by the first update() of a grid with given shape.
+   * Depends on shape only, so it can be queried while another thread updates the grid.
+   *
+   * @param layout Grid shape and storage order of cells.
+   * @param patch_size Cell size in pixels.
+   * @returns Workspace size, unit: bytes.
+   */
+  static size_t getWorkspaceSize(CellLayout const& layout, int32_t patch_size);
+
+  /**
+   * Grid shape and storage order of cells. Cell ids of all methods are storage indices of this layout.
+   */
+  CellLayout const& getLayout() const;
 
   /**
    * Get cell's label.
@@ -75,27 +98,34 @@ class CellGrid {
   /**
    * Number of total cells
    *
-   * @returns Number of total cells
+   * @returns Number of total cells, including padding slots of layout
    */
   size_t size() const;
 
  private:
   int32_t cell_width_;
   int32_t cell_height_;
-  int32_t number_horizontal_cells_;
-  int32_t number_vertical_cells_;
+  int32_t image_width_;
+  CellLayout layout_;
+  config::Config config_;
+  Eigen::Matrix<float, Eigen::Dynamic, 3, Eigen::RowMajor> cell_continuous_points_;
   std::vector<size_t> parent_;
   std::vector<int> component_size_;
   std::vector<CellSegment> cell_grid_;
   std::vector<bool> planar_mask_;
 
+  /**
+   * Allocate workspace for grid shape, if it isn't allocated yet.
+   */
+  void allocateWorkspace();
+
   /**
    * Organize point cloud, so that points corresponding to one cell lie sequentially in memory.
    *
-   * @param unorganized_data Points matrix [Nx3] with default Eigen alignment (RowMajor).
-   * @returns Cell-wise organized points (RowMajor).
+   * @param unorganized_data Points matrix [Nx3] of ORGANIZED point cloud (image order).
+   * @param organized_pcd Cell-wise organized points (RowMajor).
    */
-  void cellContinuousOrganize(Eigen::Matrix<float, Eigen::Dynamic, 3, Eigen::RowMajor> const& unorganized_data,
+  void cellContinuousOrganize(Eigen::Ref<const Eigen::MatrixX3f> const& unorganized_data,
                               Eigen::Matrix<float, Eigen::Dynamic, 3, Eigen::RowMajor>* organized_pcd);
 };
 }  // namespace deplex
\ No newline at end of file
@@ -0,0 +1,64 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "cell_layout.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace deplex {
+constexpr int32_t CellLayout::kTileSize;
+constexpr int32_t CellLayout::kMortonBlockSize;
+constexpr int32_t CellLayout::kNeighbourOffsets[8][2];
+constexpr uint32_t CellLayout::kNeighbourBorders[8];
+
+CellLayout::CellLayout(config::CellOrder order, int32_t nr_rows, int32_t nr_cols, int32_t connectivity)
+    : order_(order),
+      nr_rows_(nr_rows),
+      nr_cols_(nr_cols),
+      nr_tile_cols_((nr_cols + kTileSize - 1) / kTileSize),
+      connectivity_(connectivity),
+      size_(0),
+      nr_block_cols_((nr_cols + kMortonBlockSize - 1) / kMortonBlockSize),
+      last_block_row_start_(0),
+      last_row_code_(0),
+      last_col_code_(0) {
+  if (connectivity != 4 && connectivity != 8) {
+    throw std::runtime_error("Error! Cell connectivity has to be 4 or 8: " + std::to_string(connectivity));
+  }
+  for (int32_t i = 0; i < 8; ++i) {
+    row_major_offsets_[i] = static_cast<ptrdiff_t>(kNeighbourOffsets[i][0]) * nr_cols + kNeighbourOffsets[i][1];
+  }
+  if (nr_rows <= 0 || nr_cols <= 0) {
+    return;
+  }
+  switch (order_) {
+    case config::CellOrder::kMorton: {
+      auto nr_block_rows = static_cast<size_t>((nr_rows + kMortonBlockSize - 1) / kMortonBlockSize);
+      size_ = nr_block_rows * nr_block_cols_ << (2 * kMortonShift);
+      last_block_row_start_ = (nr_block_rows - 1) * nr_block_cols_;
+      // In-block codes of the last row and column, that partial blocks of grid border have
+      last_row_code_ = spreadBits((nr_rows - 1) & kMortonMask) << 1;
+      last_col_code_ = spreadBits((nr_cols - 1) & kMortonMask);
+      break;
+    }
+    case config::CellOrder::kTiled:
+      size_ = static_cast<size_t>((nr_rows + kTileSize - 1) / kTileSize) * nr_tile_cols_ * kTileSize * kTileSize;
+      break;
+    default:
+      size_ = static_cast<size_t>(nr_rows) * nr_cols;
+  }
+}
+}  // namespace deplex
@@ -0,0 +1,235 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "deplex/config.h"
+
+namespace deplex {
+/**
+ * Mapping between cell grid coordinates and cell storage index.
+ *
+ * Morton (Z-order) and tiled orders keep 2D-neighbouring cells close in memory, so that region growing
+ * touches fewer cache lines on large grids. Morton order interleaves bits of coordinates inside square blocks,
+ * which are stored in row-major order, so that neighbours are found by dilated-integer arithmetic. Both orders
+ * pad partial blocks with slots, that don't correspond to any cell (see isValid).
+ */
+class CellLayout {
+ public:
+  // Side of square tile in tiled order, unit: cells. Has to be power of two.
+  static constexpr int32_t kTileSize = 8;
+  // Side of square block of Morton order, unit: cells. Has to be power of two.
+  static constexpr int32_t kMortonBlockSize = 16;
+
+  /**
+   * CellLayout constructor.
+   *
+   * @param order Storage order of cells.
+   * @param nr_rows Number of vertical cells.
+   * @param nr_cols Number of horizontal cells.
+   * @param connectivity Number of neighbours of inner cell: 4 or 8 (with diagonal neighbours).
+   */
+  CellLayout(config::CellOrder order, int32_t nr_rows, int32_t nr_cols, int32_t connectivity = 4);
+
+  /**
+   * Number of storage slots, including padding.
+   */
+  size_t size() const { return size_; }
+
+  int32_t getNrRows() const { return nr_rows_; }
+
+  int32_t getNrCols() const { return nr_cols_; }
+
+  int32_t getConnectivity() const { return connectivity_; }
+
+  size_t toIndex(int32_t row, int32_t col) const;
+
+  int32_t getRow(size_t index) const;
+
+  int32_t getCol(size_t index) const;
+
+  /**
+   * Check whether storage slot corresponds to a cell of grid.
+   */
+  bool isValid(size_t index) const { return getRow(index) < nr_rows_ && getCol(index) < nr_cols_; }
+
+  /**
+   * Call function for each neighbour of cell in order: up, down, left, right and with 8-connectivity
+   * up-left, up-right, down-left, down-right. Neighbours are derived from offset table and border flags of cell.
+   *
+   * @param index Storage index of cell.
+   * @param function Callable taking storage index of neighbour.
+   */
+  template <typename Function>
+  void forEachNeighbour(size_t index, Function&& function) const;
+
+ private:
+  static constexpr int32_t kTileShift = 3;
+  static constexpr int32_t kTileMask = kTileSize - 1;
+  static constexpr int32_t kMortonShift = 4;
+  static constexpr int32_t kMortonMask = kMortonBlockSize - 1;
+  // Bits of Morton code inside block: column (even) and row (odd)
+  static constexpr uint32_t kMortonCodeMask = (1u << (2 * kMortonShift)) - 1;
+  static constexpr uint32_t kMortonColumnBits = 0x55555555u & kMortonCodeMask;
+  static constexpr uint32_t kMortonRowBits = 0xAAAAAAAAu & kMortonCodeMask;
+  // Border flags of cell: neighbour exists in direction
+  static constexpr uint32_t kUp = 1, kDown = 2, kLeft = 4, kRight = 8;
+  // Neighbour offsets (row, column) and borders they require, 4-connected neighbours first
+  static constexpr int32_t kNeighbourOffsets[8][2] = {{-1, 0}, {1, 0},   {0, -1}, {0, 1},
+                                                      {-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
+  static constexpr uint32_t kNeighbourBorders[8] = {kUp,         kDown,        kLeft,          kRight,
+                                                    kUp | kLeft, kUp | kRight, kDown | kLeft, kDown | kRight};
+
+  config::CellOrder order_;
+  int32_t nr_rows_;
+  int32_t nr_cols_;
+  int32_t nr_tile_cols_;
+  int32_t connectivity_;
+  size_t size_;
+  // Index differences of neighbours in row-major order
+  ptrdiff_t row_major_offsets_[8];
+  // Morton order: number of block columns, first block of the last block row and Morton codes of the last
+  // row and column of partial blocks
+  uint32_t nr_block_cols_;
+  size_t last_block_row_start_;
+  uint32_t last_row_code_;
+  uint32_t last_col_code_;
+
+  static uint32_t spreadBits(uint32_t value);
+
+  static uint32_t compactBits(uint32_t code);
+
+  /**
+   * Border flags of cell in Morton order, computed from in-block codes. Block column is computed only for cells
+   * of the first block column and of the last columns of partial blocks.
+   */
+  uint32_t getMortonBorders(size_t block, uint32_t row_code, uint32_t col_code) const;
+};
+
+inline uint32_t CellLayout::spreadBits(uint32_t value) {
+  value &= 0x0000FFFFu;
+  value = (value | (value << 8)) & 0x00FF00FFu;
+  value = (value | (value << 4)) & 0x0F0F0F0Fu;
+  value = (value | (value << 2)) & 0x33333333u;
+  value = (value | (value << 1)) & 0x55555555u;
+  return value;
+}
+
+inline uint32_t CellLayout::compactBits(uint32_t code) {
+  code &= 0x55555555u;
+  code = (code | (code >> 1)) & 0x33333333u;
+  code = (code | (code >> 2)) & 0x0F0F0F0Fu;
+  code = (code | (code >> 4)) & 0x00FF00FFu;
+  code = (code | (code >> 8)) & 0x0000FFFFu;
+  return code;
+}
+
+inline size_t CellLayout::toIndex(int32_t row, int32_t col) const {
+  switch (order_) {
+    case config::CellOrder::kMorton:
+      return ((static_cast<size_t>(row >> kMortonShift) * nr_block_cols_ + (col >> kMortonShift))
+              << (2 * kMortonShift)) |
+             (spreadBits(row & kMortonMask) << 1) | spreadBits(col & kMortonMask);
+    case config::CellOrder::kTiled:
+      return ((static_cast<size_t>(row >> kTileShift) * nr_tile_cols_ + (col >> kTileShift))
+              << (2 * kTileShift)) |
+             ((row & kTileMask) << kTileShift) | (col & kTileMask);
+    default:
+      return static_cast<size_t>(row) * nr_cols_ + col;
+  }
+}
+
+inline int32_t CellLayout::getRow(size_t index) const {
+  switch (order_) {
+    case config::CellOrder::kMorton:
+      return static_cast<int32_t>(((index >> (2 * kMortonShift)) / nr_block_cols_) << kMortonShift |
+                                  compactBits((static_cast<uint32_t>(index) & kMortonRowBits) >> 1));
+    case config::CellOrder::kTiled:
+      return static_cast<int32_t>(((index >> (2 * kTileShift)) / nr_tile_cols_) << kTileShift |
+                                  ((index >> kTileShift) & kTileMask));
+    default:
+      return static_cast<int32_t>(index / nr_cols_);
+  }
+}
+
+inline int32_t CellLayout::getCol(size_t index) const {
+  switch (order_) {
+    case config::CellOrder::kMorton:
+      return static_cast<int32_t>(((index >> (2 * kMortonShift)) % nr_block_cols_) << kMortonShift |
+                                  compactBits(static_cast<uint32_t>(index) & kMortonColumnBits));
+    case config::CellOrder::kTiled:
+      return static_cast<int32_t>(((index >> (2 * kTileShift)) % nr_tile_cols_) << kTileShift | (index & kTileMask));
+    default:
+      return static_cast<int32_t>(index % nr_cols_);
+  }
+}
+
+inline uint32_t CellLayout::getMortonBorders(size_t block, uint32_t row_code, uint32_t col_code) const {
+  // Dilated integers of the same bits compare like the coordinates they encode
+  uint32_t borders = 0;
+  if (row_code != 0 || block >= nr_block_cols_) borders |= kUp;
+  if (block < last_block_row_start_ || row_code < last_row_code_) borders |= kDown;
+  if (col_code != 0 || static_cast<uint32_t>(block) % nr_block_cols_ != 0) borders |= kLeft;
+  if (col_code < last_col_code_ || static_cast<uint32_t>(block) % nr_block_cols_ + 1 != nr_block_cols_) {
+    borders |= kRight;
+  }
+  return borders;
+}
+
+template <typename Function>
+void CellLayout::forEachNeighbour(size_t index, Function&& function) const {
+  if (order_ == config::CellOrder::kMorton) {
+    size_t block = index >> (2 * kMortonShift);
+    auto row_code = static_cast<uint32_t>(index) & kMortonRowBits;
+    auto col_code = static_cast<uint32_t>(index) & kMortonColumnBits;
+    uint32_t borders = getMortonBorders(block, row_code, col_code);
+    // Decrement and increment of interleaved coordinate, carry out of block moves to adjacent block.
+    // Neighbour index is sum of block start, row part and column part for offsets -1, 0, 1
+    ptrdiff_t block_rows = static_cast<ptrdiff_t>(nr_block_cols_) << (2 * kMortonShift);
+    ptrdiff_t block_cols = static_cast<ptrdiff_t>(1) << (2 * kMortonShift);
+    ptrdiff_t row_parts[3] = {(row_code == 0 ? -block_rows : 0) + ((row_code - 1) & kMortonRowBits), row_code,
+                              (row_code == kMortonRowBits ? block_rows : 0) +
+                                  (((row_code | kMortonColumnBits) + 1) & kMortonRowBits)};
+    ptrdiff_t col_parts[3] = {(col_code == 0 ? -block_cols : 0) + ((col_code - 1) & kMortonColumnBits), col_code,
+                              (col_code == kMortonColumnBits ? block_cols : 0) +
+                                  (((col_code | kMortonRowBits) + 1) & kMortonColumnBits)};
+    auto block_start = static_cast<ptrdiff_t>(block << (2 * kMortonShift));
+    for (int32_t i = 0; i < connectivity_; ++i) {
+      if ((borders & kNeighbourBorders[i]) == kNeighbourBorders[i]) {
+        function(static_cast<size_t>(block_start + row_parts[kNeighbourOffsets[i][0] + 1] +
+                                     col_parts[kNeighbourOffsets[i][1] + 1]));
+      }
+    }
+    return;
+  }
+  int32_t row = getRow(index);
+  int32_t col = getCol(index);
+  uint32_t borders = (row > 0 ? kUp : 0) | (row + 1 < nr_rows_ ? kDown : 0) | (col > 0 ? kLeft : 0) |
+                     (col + 1 < nr_cols_ ? kRight : 0);
+  for (int32_t i = 0; i < connectivity_; ++i) {
+    if ((borders & kNeighbourBorders[i]) != kNeighbourBorders[i]) {
+      continue;
+    }
+    if (order_ == config::CellOrder::kRowMajor) {
+      function(static_cast<size_t>(static_cast<ptrdiff_t>(index) + row_major_offsets_[i]));
+    } else {
+      function(toIndex(row + kNeighbourOffsets[i][0], col + kNeighbourOffsets[i][1]));
+    }
+  }
+}
+}  // namespace deplex
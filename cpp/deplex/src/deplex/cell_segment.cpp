@@ -54,6 +54,8 @@ float CellSegment::getMergeTolerance() const { return merge_tolerance_; }
 
 void CellSegment::calculateStats() { stats_.fitPlane(); }
 
+void CellSegment::setNormal(Eigen::Vector3f const& normal) { stats_.setNormal(normal); }
+
 bool CellSegment::hasValidPoints(Eigen::MatrixX3f const& cell_points, size_t valid_pts_threshold) const {
   Eigen::Index valid_pts = (cell_points.col(2).array() > 0).count();
   return valid_pts >= valid_pts_threshold;
@@ -53,6 +53,13 @@ class CellSegment {
    */
   void calculateStats();
 
+  /**
+   * Replace fitted normal with given direction (see CellSegmentStat::setNormal).
+   *
+   * @param normal Unit normal.
+   */
+  void setNormal(Eigen::Vector3f const& normal);
+
   bool isPlanar() const;
 
   bool areNeighbours3D(CellSegment const& other) const;
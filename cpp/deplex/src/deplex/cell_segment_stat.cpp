@@ -16,6 +16,7 @@
 #include "cell_segment_stat.h"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <vector>
 
@@ -24,21 +25,36 @@ extern "C" {
 }
 
 namespace deplex {
-CellSegmentStat::CellSegmentStat() : nr_pts_(0), mse_(std::numeric_limits<float>::max()), score_(0) {}
+CellSegmentStat::CellSegmentStat()
+    : score_(0),
+      mse_(std::numeric_limits<float>::max()),
+      nr_pts_(0),
+      mean_(Eigen::Vector3f::Zero()),
+      scatter_(Eigen::Matrix3f::Zero()) {}
 
 CellSegmentStat::CellSegmentStat(Eigen::MatrixX3f const& cell_points)
-    : nr_pts_(cell_points.rows()),
-      coord_sum_(cell_points.colwise().sum()),
-      variance_(cell_points.transpose() * cell_points),
-      mean_(coord_sum_ / nr_pts_) {
+    : nr_pts_(cell_points.rows()), mean_(cell_points.colwise().sum() / nr_pts_) {
+  Eigen::MatrixX3f centered = cell_points.rowwise() - mean_.transpose();
+  scatter_ = centered.transpose() * centered;
   fitPlane();
 }
 
 CellSegmentStat& CellSegmentStat::operator+=(CellSegmentStat const& other) {
-  nr_pts_ += other.nr_pts_;
-  coord_sum_ += other.coord_sum_;
-  variance_ += other.variance_;
-  mean_ = coord_sum_ / nr_pts_;
+  if (other.nr_pts_ == 0) {
+    return *this;
+  }
+  if (nr_pts_ == 0) {
+    nr_pts_ = other.nr_pts_;
+    mean_ = other.mean_;
+    scatter_ = other.scatter_;
+    return *this;
+  }
+  int32_t nr_pts = nr_pts_ + other.nr_pts_;
+  Eigen::Vector3f delta = other.mean_ - mean_;
+  scatter_ += other.scatter_ +
+              delta * delta.transpose() * (static_cast<float>(nr_pts_) * static_cast<float>(other.nr_pts_) / nr_pts);
+  mean_ += delta * (static_cast<float>(other.nr_pts_) / nr_pts);
+  nr_pts_ = nr_pts;
   return *this;
 }
 
@@ -52,12 +68,25 @@ float CellSegmentStat::getMSE() const { return mse_; };
 
 float CellSegmentStat::getD() const { return d_; };
 
+int32_t CellSegmentStat::getNrPoints() const { return nr_pts_; }
+
+Eigen::Matrix3f CellSegmentStat::getCovariance() const {
+  return scatter_ / nr_pts_;
+}
+
+Eigen::Matrix4f CellSegmentStat::getParameterCovariance(float depth_sigma_coeff, float depth_sigma_margin) const {
+  if (nr_pts_ == 0) {
+    return Eigen::Matrix4f::Zero();
+  }
+  float noise_variance = getNoiseVariance(mse_, mean_.z(), depth_sigma_coeff, depth_sigma_margin);
+  return getPlaneCovariance(getCovariance(), mean_, static_cast<float>(nr_pts_), noise_variance);
+}
+
 void CellSegmentStat::fitPlane() {
-  Eigen::Matrix3f cov = variance_ - coord_sum_ * coord_sum_.transpose() / nr_pts_;
   double tmp_cov[3][3];
   for (int i = 0; i < 3; ++i) {
     for (int j = 0; j < 3; ++j) {
-      tmp_cov[i][j] = cov.data()[3 * j + i];
+      tmp_cov[i][j] = scatter_(i, j);
     }
   }
   double eigenvectors[3][3];
@@ -79,4 +108,51 @@ void CellSegmentStat::fitPlane() {
   mse_ = static_cast<float>(eigenvalues[min_es_ind] / nr_pts_);
   score_ = static_cast<float>(eigenvalues[max_es_ind] / (Eigen::Map<Eigen::Vector3d>(eigenvalues, 3).sum()));
 }
+
+void CellSegmentStat::setNormal(Eigen::Vector3f const& normal) {
+  d_ = -mean_.dot(normal);
+  // Enforce normal orientation
+  normal_ = (d_ > 0 ? normal : -normal);
+  d_ = std::abs(d_);
+  mse_ = normal_.dot(scatter_ * normal_) / nr_pts_;
+}
+
+Eigen::Matrix4f getPlaneCovariance(Eigen::Matrix3f const& covariance, Eigen::Vector3f const& mean, float nr_points,
+                                   float noise_variance) {
+  double tmp_cov[3][3];
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      tmp_cov[i][j] = covariance(i, j);
+    }
+  }
+  double eigenvectors[3][3];
+  double eigenvalues[3];
+  dsyevh3(tmp_cov, eigenvectors, eigenvalues);
+  Eigen::Index min_es_ind = std::distance(eigenvalues, std::min_element(eigenvalues, eigenvalues + 3));
+
+  Eigen::Matrix3d normal_cov = Eigen::Matrix3d::Zero();
+  for (Eigen::Index k = 0; k < 3; ++k) {
+    double gap = eigenvalues[k] - eigenvalues[min_es_ind];
+    if (k == min_es_ind || gap <= 0) {
+      continue;
+    }
+    Eigen::Vector3d v(eigenvectors[0][k], eigenvectors[1][k], eigenvectors[2][k]);
+    normal_cov += v * v.transpose() / gap;
+  }
+  normal_cov *= noise_variance / nr_points;
+
+  // d = -n.dot(mean): mean error is independent of normal error, only its normal component changes d
+  Eigen::Vector3d mean_d = mean.cast<double>();
+  Eigen::Matrix4f parameter_cov;
+  parameter_cov.topLeftCorner<3, 3>() = normal_cov.cast<float>();
+  parameter_cov.topRightCorner<3, 1>() = (-normal_cov * mean_d).cast<float>();
+  parameter_cov.bottomLeftCorner<1, 3>() = parameter_cov.topRightCorner<3, 1>().transpose();
+  parameter_cov(3, 3) = static_cast<float>(mean_d.dot(normal_cov * mean_d) + noise_variance / nr_points);
+  return parameter_cov;
+}
+
+float getNoiseVariance(float mse, float mean_depth, float depth_sigma_coeff, float depth_sigma_margin) {
+  float depth_sigma = depth_sigma_coeff * mean_depth * mean_depth + depth_sigma_margin;
+  return std::max(mse, depth_sigma * depth_sigma);
+}
 }  // namespace deplex
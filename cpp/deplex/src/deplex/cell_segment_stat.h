@@ -21,6 +21,8 @@ namespace deplex {
 /**
  * Cell Segment Statistics.
  * MSE, Planarity score, PCA etc.
+ * Points are summarized by mean and centered scatter matrix, so that statistics of large far segments
+ * stay accurate in single precision.
  */
 class CellSegmentStat {
  public:
@@ -35,7 +37,7 @@ class CellSegmentStat {
   explicit CellSegmentStat(Eigen::MatrixX3f const& cell_points);
 
   /**
-   * Merge two cell stats together
+   * Merge two cell stats together (pairwise update of mean and scatter by Chan et al.).
    *
    * @param other another CellSegmentStat.
    * @returns new CellSegmentStat with merged stats.
@@ -52,21 +54,63 @@ class CellSegmentStat {
 
   float getD() const;
 
+  int32_t getNrPoints() const;
+
+  /**
+   * Covariance matrix of points.
+   */
+  Eigen::Matrix3f getCovariance() const;
+
+  /**
+   * Covariance of fitted plane parameters (normal, d), see getPlaneCovariance.
+   *
+   * @param depth_sigma_coeff Quadratic coefficient of depth noise.
+   * @param depth_sigma_margin Constant term of depth noise.
+   */
+  Eigen::Matrix4f getParameterCovariance(float depth_sigma_coeff, float depth_sigma_margin) const;
+
   /**
    * Principal Component Analysis.
    * Compute cell's variance, eigenvalues (PCA), cell's normal etc
    */
   void fitPlane();
 
+  /**
+   * Replace fitted normal with given direction, keeping plane through the mean point.
+   * D offset and MSE are recomputed for new normal.
+   *
+   * @param normal Unit normal.
+   */
+  void setNormal(Eigen::Vector3f const& normal);
+
  private:
   float d_;
   float score_;
   float mse_;
   int32_t nr_pts_;
-  Eigen::Vector3f coord_sum_;
-  Eigen::Matrix3f variance_;
   Eigen::Vector3f mean_;
+  // Sum of outer products of points centered at mean
+  Eigen::Matrix3f scatter_;
   Eigen::Vector3f normal_;
 };
 
+/**
+ * Covariance of Hessian-form plane parameters (normal, d) fitted by PCA to points with isotropic noise.
+ * First-order perturbation of eigenvectors: cov(n) = sigma^2 / N * sum_k v_k v_k^T / (mu_k - mu_0),
+ * where mu_k, v_k are in-plane eigenpairs of point covariance, d = -n.dot(mean).
+ *
+ * @param covariance Covariance matrix of points.
+ * @param mean Mean point.
+ * @param nr_points Number of points (sum of weights for weighted fit).
+ * @param noise_variance Variance of point noise along normal, unit: squared point unit.
+ * @returns Covariance matrix [4x4] of (normal, d).
+ */
+Eigen::Matrix4f getPlaneCovariance(Eigen::Matrix3f const& covariance, Eigen::Vector3f const& mean, float nr_points,
+                                   float noise_variance);
+
+/**
+ * Variance of point noise along plane normal: the larger of fitted plane MSE and depth noise model
+ * sigma = coeff * z^2 + margin at mean depth.
+ */
+float getNoiseVariance(float mse, float mean_depth, float depth_sigma_coeff, float depth_sigma_margin);
 }  // namespace deplex
\ No newline at end of file
@@ -16,31 +16,86 @@
 #include "deplex/config.h"
 
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
 
 namespace deplex {
 namespace config {
-Config::Config() = default;
-
-// TODO:
-Config::Config(std::unordered_map<std::string, std::string> const& param_map) {}
-
-Config::Config(std::string const& config_path) {
+namespace {
+std::unordered_map<std::string, std::string> readIniFile(std::string const& config_path) {
   std::ifstream ini_file(config_path);
   if (!ini_file.is_open()) {
     throw std::runtime_error("Couldn't open ini file: " + config_path);
   }
+  std::unordered_map<std::string, std::string> param_map;
   while (ini_file) {
     std::string line;
     std::getline(ini_file, line);
     if (line.empty() || line[0] == '#') continue;
-    std::string key, value;
     size_t eq_pos = line.find_first_of('=');
     if (eq_pos == std::string::npos || eq_pos == 0) {
       continue;
     }
-    key = line.substr(0, eq_pos);
-    value = line.substr(eq_pos + 1);
+    param_map[line.substr(0, eq_pos)] = line.substr(eq_pos + 1);
+  }
+  return param_map;
+}
+
+CellOrder parseCellOrder(std::string const& value) {
+  if (value == "rowMajor") return CellOrder::kRowMajor;
+  if (value == "morton") return CellOrder::kMorton;
+  if (value == "tiled") return CellOrder::kTiled;
+  throw std::runtime_error("Error! Invalid config parameter: cellOrder(" + value +
+                           "). cellOrder has to be one of: rowMajor, morton, tiled.");
+}
+
+RobustLoss parseRobustLoss(std::string const& value) {
+  if (value == "none") return RobustLoss::kNone;
+  if (value == "huber") return RobustLoss::kHuber;
+  if (value == "tukey") return RobustLoss::kTukey;
+  throw std::runtime_error("Error! Invalid config parameter: robustLoss(" + value +
+                           "). robustLoss has to be one of: none, huber, tukey.");
+}
+
+/**
+ * Tie all parameters, so that comparison and hashing never miss a newly added one.
+ */
+auto tieParameters(Config const& config) {
+  return std::tie(config.patch_size, config.histogram_bins_per_coord, config.min_cos_angle_merge,
+                  config.max_merge_dist, config.min_region_growing_candidate_size,
+                  config.min_region_growing_cells_activated, config.min_region_planarity_score,
+                  config.depth_sigma_coeff, config.depth_sigma_margin, config.min_pts_per_cell,
+                  config.depth_discontinuity_threshold, config.max_number_depth_discontinuity,
+                  config.ransac_refinement, config.ransac_max_iterations, config.ransac_threshold,
+                  config.ransac_inliers_ratio, config.parallel_calibration, config.cpu_affinity,
+                  config.realtime_priority, config.cell_order, config.cell_connectivity,
+                  config.gravity_tolerance, config.gravity_snap, config.manhattan_mode,
+                  config.manhattan_tolerance, config.global_merge, config.boundary_refinement,
+                  config.robust_loss, config.robust_refit_iterations, config.residual_map,
+                  config.residual_map_unlabelled, config.denoise_points, config.pixel_index, config.compute_geometry, config.max_frames_in_flight,
+                  config.pipelined_processing);
+}
+
+template <typename Tuple, size_t... I>
+size_t hashTuple(Tuple const& parameters, std::index_sequence<I...>) {
+  size_t seed = 0;
+  int unused[] = {0, (seed ^= std::hash<std::decay_t<std::tuple_element_t<I, Tuple>>>{}(std::get<I>(parameters)) +
+                              0x9e3779b9 + (seed << 6) + (seed >> 2),
+                      0)...};
+  static_cast<void>(unused);
+  return seed;
+}
+}  // namespace
+
+Config::Config() = default;
+
+Config::Config(std::unordered_map<std::string, std::string> const& param_map) {
+  for (auto const& param : param_map) {
+    std::string const& key = param.first;
+    std::string const& value = param.second;
     if (key == "patchSize") {
       patch_size = std::stoi(value);
     } else if (key == "histogramBinsPerCoord") {
@@ -73,11 +128,62 @@ Config::Config(std::string const& config_path) {
       ransac_threshold = std::stof(value);
     } else if (key == "ransacInliersRatio") {
       ransac_inliers_ratio = std::stof(value);
+    } else if (key == "parallelCalibration") {
+      parallel_calibration = static_cast<bool>(std::stoi(value));
+    } else if (key == "cpuAffinity") {
+      cpu_affinity = value;
+    } else if (key == "realtimePriority") {
+      realtime_priority = std::stoi(value);
+    } else if (key == "cellOrder") {
+      cell_order = parseCellOrder(value);
+    } else if (key == "cellConnectivity") {
+      cell_connectivity = std::stoi(value);
+    } else if (key == "gravityTolerance") {
+      gravity_tolerance = std::stof(value);
+    } else if (key == "gravitySnap") {
+      gravity_snap = static_cast<bool>(std::stoi(value));
+    } else if (key == "manhattanMode") {
+      manhattan_mode = static_cast<bool>(std::stoi(value));
+    } else if (key == "manhattanTolerance") {
+      manhattan_tolerance = std::stof(value);
+    } else if (key == "globalMerge") {
+      global_merge = static_cast<bool>(std::stoi(value));
+    } else if (key == "boundaryRefinement") {
+      boundary_refinement = static_cast<bool>(std::stoi(value));
+    } else if (key == "robustLoss") {
+      robust_loss = parseRobustLoss(value);
+    } else if (key == "robustRefitIterations") {
+      robust_refit_iterations = std::stoi(value);
+    } else if (key == "residualMap") {
+      residual_map = static_cast<bool>(std::stoi(value));
+    } else if (key == "residualMapUnlabelled") {
+      residual_map_unlabelled = static_cast<bool>(std::stoi(value));
+    } else if (key == "denoisePoints") {
+      denoise_points = static_cast<bool>(std::stoi(value));
+    } else if (key == "pixelIndex") {
+      pixel_index = static_cast<bool>(std::stoi(value));
+    } else if (key == "computeGeometry") {
+      compute_geometry = static_cast<bool>(std::stoi(value));
+    } else if (key == "maxFramesInFlight") {
+      max_frames_in_flight = std::stoi(value);
+    } else if (key == "pipelinedProcessing") {
+      pipelined_processing = static_cast<bool>(std::stoi(value));
     } else {
       std::cerr << "Unknown parameter name: " << key << '\n';
     }
   }
 }
 
+Config::Config(std::string const& config_path) : Config(readIniFile(config_path)) {}
+
+bool Config::operator==(Config const& other) const { return tieParameters(*this) == tieParameters(other); }
+
+bool Config::operator!=(Config const& other) const { return !(*this == other); }
+
+size_t ConfigHash::operator()(Config const& config) const {
+  auto parameters = tieParameters(config);
+  return hashTuple(parameters, std::make_index_sequence<std::tuple_size<decltype(parameters)>::value>());
+}
+
 }  // namespace config
-}  // namespace deplex
\ No newline at end of file
+}  // namespace deplex
@@ -0,0 +1,175 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "deplex/extractor_pool.h"
+
+#include <algorithm>
+#include <list>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace deplex {
+/**
+ * Pool data shared with leases, so that a lease may safely outlive the pool.
+ */
+struct ExtractorPool::Lease::State {
+  struct Key {
+    int32_t image_height;
+    int32_t image_width;
+    config::Config config;
+
+    bool operator==(Key const& other) const {
+      return image_height == other.image_height && image_width == other.image_width && config == other.config;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(Key const& key) const {
+      size_t seed = config::ConfigHash()(key.config);
+      seed ^= std::hash<int64_t>()(static_cast<int64_t>(key.image_height) << 32 | key.image_width) + 0x9e3779b9 +
+              (seed << 6) + (seed >> 2);
+      return seed;
+    }
+  };
+
+  struct Entry {
+    Key key;
+    std::unique_ptr<PlaneExtractor> extractor;
+    size_t workspace_size;
+  };
+
+  explicit State(size_t limit) : memory_limit(limit) {}
+
+  std::mutex mutex;
+  size_t memory_limit;
+  size_t memory_usage = 0;
+  // Idle extractors, most recently used first
+  std::list<Entry> lru;
+  std::unordered_map<Key, std::vector<std::list<Entry>::iterator>, KeyHash> idle;
+
+  /**
+   * Evict least recently used idle extractors until memory usage fits into limit.
+   * Has to be called with locked mutex.
+   */
+  void evict() {
+    while (memory_limit > 0 && memory_usage > memory_limit && !lru.empty()) {
+      auto victim = std::prev(lru.end());
+      auto& same_key = idle[victim->key];
+      same_key.erase(std::find(same_key.begin(), same_key.end(), victim));
+      if (same_key.empty()) {
+        idle.erase(victim->key);
+      }
+      memory_usage -= victim->workspace_size;
+      lru.erase(victim);
+    }
+  }
+};
+
+ExtractorPool::ExtractorPool(size_t memory_limit) : state_(std::make_shared<Lease::State>(memory_limit)) {}
+
+ExtractorPool::~ExtractorPool() = default;
+
+ExtractorPool::Lease ExtractorPool::acquire(int32_t image_height, int32_t image_width, config::Config const& config) {
+  Lease::State::Key key{image_height, image_width, config};
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    auto same_key = state_->idle.find(key);
+    if (same_key != state_->idle.end()) {
+      auto entry = same_key->second.back();
+      same_key->second.pop_back();
+      if (same_key->second.empty()) {
+        state_->idle.erase(same_key);
+      }
+      std::unique_ptr<PlaneExtractor> extractor = std::move(entry->extractor);
+      state_->lru.erase(entry);
+      return Lease(state_, std::move(extractor), image_height, image_width, config);
+    }
+  }
+
+  // Construction may take a while, so it runs without holding the lock
+  std::unique_ptr<PlaneExtractor> extractor(new PlaneExtractor(image_height, image_width, config));
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->memory_usage += extractor->getWorkspaceSize();
+    state_->evict();
+  }
+  return Lease(state_, std::move(extractor), image_height, image_width, config);
+}
+
+size_t ExtractorPool::size() const {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  return state_->lru.size();
+}
+
+size_t ExtractorPool::getMemoryUsage() const {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  return state_->memory_usage;
+}
+
+void ExtractorPool::clear() {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  for (auto const& entry : state_->lru) {
+    state_->memory_usage -= entry.workspace_size;
+  }
+  state_->lru.clear();
+  state_->idle.clear();
+}
+
+ExtractorPool::Lease::Lease(std::shared_ptr<State> state, std::unique_ptr<PlaneExtractor> extractor,
+                            int32_t image_height, int32_t image_width, config::Config const& config)
+    : state_(std::move(state)),
+      extractor_(std::move(extractor)),
+      image_height_(image_height),
+      image_width_(image_width),
+      config_(config) {}
+
+ExtractorPool::Lease::Lease(Lease&& op) noexcept = default;
+
+ExtractorPool::Lease& ExtractorPool::Lease::operator=(Lease&& op) noexcept {
+  std::swap(state_, op.state_);
+  std::swap(extractor_, op.extractor_);
+  std::swap(image_height_, op.image_height_);
+  std::swap(image_width_, op.image_width_);
+  std::swap(config_, op.config_);
+  return *this;
+}
+
+ExtractorPool::Lease::~Lease() {
+  if (!extractor_) {
+    return;
+  }
+  // Next lease gets extractor as constructed
+  try {
+    extractor_->reset();
+  } catch (std::exception const&) {
+    // Released from completion callback of the extractor, it can't be pooled
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->memory_usage -= extractor_->getWorkspaceSize();
+    return;
+  }
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  size_t workspace_size = extractor_->getWorkspaceSize();
+  State::Key key{image_height_, image_width_, config_};
+  state_->lru.push_front({key, std::move(extractor_), workspace_size});
+  state_->idle[key].push_back(state_->lru.begin());
+  state_->evict();
+}
+
+PlaneExtractor& ExtractorPool::Lease::operator*() const { return *extractor_; }
+
+PlaneExtractor* ExtractorPool::Lease::operator->() const { return extractor_.get(); }
+}  // namespace deplex
@@ -0,0 +1,85 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "manhattan_frame.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <Eigen/Geometry>
+
+#include "normals_histogram.h"
+
+namespace deplex {
+namespace {
+/**
+ * Mean of sign-aligned normals of the most frequent histogram bin.
+ *
+ * @returns Zero vector if histogram bin has less than min_nr_cells normals.
+ */
+Eigen::Vector3f getDominantDirection(Eigen::MatrixX3f const& normals, int32_t nr_bins_per_coord,
+                                     int32_t min_nr_cells) {
+  NormalsHistogram hist(nr_bins_per_coord, normals);
+  std::vector<int32_t> cell_ids = hist.getPointsFromMostFrequentBin();
+  if (cell_ids.empty() || static_cast<int32_t>(cell_ids.size()) < min_nr_cells) {
+    return Eigen::Vector3f::Zero();
+  }
+  Eigen::Vector3f reference = normals.row(cell_ids.front());
+  Eigen::Vector3f direction = Eigen::Vector3f::Zero();
+  for (int32_t cell_id : cell_ids) {
+    Eigen::Vector3f normal = normals.row(cell_id);
+    direction += (normal.dot(reference) >= 0 ? normal : Eigen::Vector3f(-normal));
+  }
+  return direction.normalized();
+}
+
+/**
+ * Arbitrary unit vector orthogonal to given one.
+ */
+Eigen::Vector3f getOrthogonal(Eigen::Vector3f const& axis) {
+  Eigen::Vector3f helper = (std::abs(axis.x()) < 0.9f ? Eigen::Vector3f::UnitX() : Eigen::Vector3f::UnitY());
+  return axis.cross(helper).normalized();
+}
+}  // namespace
+
+bool estimateManhattanFrame(Eigen::MatrixX3f const& normals, int32_t nr_bins_per_coord, float min_cos_angle,
+                            int32_t min_nr_cells, Eigen::Vector3f const* gravity, Eigen::Matrix3f* frame) {
+  Eigen::Vector3f first_axis =
+      (gravity != nullptr ? *gravity : getDominantDirection(normals, nr_bins_per_coord, min_nr_cells));
+  if (first_axis.isZero()) {
+    return false;
+  }
+
+  // Normals orthogonal to the first axis, projected onto its orthogonal plane
+  float max_orthogonal_cos = std::sqrt(std::max(1 - min_cos_angle * min_cos_angle, 0.f));
+  Eigen::MatrixX3f orthogonal_normals = Eigen::MatrixX3f::Zero(normals.rows(), 3);
+  for (Eigen::Index i = 0; i < normals.rows(); ++i) {
+    Eigen::Vector3f normal = normals.row(i);
+    float cos_angle = normal.dot(first_axis);
+    if (!normal.isZero() && std::abs(cos_angle) <= max_orthogonal_cos) {
+      orthogonal_normals.row(i) = (normal - cos_angle * first_axis).normalized();
+    }
+  }
+  Eigen::Vector3f second_axis = getDominantDirection(orthogonal_normals, nr_bins_per_coord, min_nr_cells);
+  second_axis = (second_axis.isZero() ? getOrthogonal(first_axis)
+                                      : (second_axis - second_axis.dot(first_axis) * first_axis).normalized());
+
+  frame->col(0) = first_axis;
+  frame->col(1) = second_axis;
+  frame->col(2) = first_axis.cross(second_axis);
+  return true;
+}
+}  // namespace deplex
@@ -0,0 +1,38 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <Eigen/Core>
+
+namespace deplex {
+/**
+ * Estimate dominant Manhattan frame (three orthogonal directions) from cell normals.
+ *
+ * The first axis is gravity if given, otherwise the mean normal of the most frequent NormalsHistogram bin.
+ * The second axis is the most frequent direction among normals orthogonal to the first one, the third axis
+ * completes right-handed frame.
+ *
+ * @param normals Cell normals [Nx3], zero rows are ignored.
+ * @param nr_bins_per_coord Granularity of normals histogram.
+ * @param min_cos_angle Cosine of maximum deviation of normal from axis.
+ * @param min_nr_cells Minimum number of cells supporting an axis.
+ * @param gravity Unit gravity direction, nullptr if unknown.
+ * @param frame Output frame, axes are columns.
+ * @returns false if the first axis has less than min_nr_cells supporting cells.
+ */
+bool estimateManhattanFrame(Eigen::MatrixX3f const& normals, int32_t nr_bins_per_coord, float min_cos_angle,
+                            int32_t min_nr_cells, Eigen::Vector3f const* gravity, Eigen::Matrix3f* frame);
+}  // namespace deplex
@@ -16,6 +16,7 @@
 #include "normals_histogram.h"
 
 #include <cmath>
+#include <utility>
 
 namespace deplex {
 NormalsHistogram::NormalsHistogram(int32_t nr_bins_per_coord, Eigen::MatrixX3f const& normals)
@@ -48,6 +49,16 @@ NormalsHistogram::NormalsHistogram(int32_t nr_bins_per_coord, Eigen::MatrixX3f c
   }
 }
 
+NormalsHistogram::NormalsHistogram(int32_t nr_bins, std::vector<int32_t> bins)
+    : bins_(std::move(bins)),
+      hist_(nr_bins, 0),
+      nr_bins_per_coord_(0),
+      nr_points_(static_cast<int32_t>(bins_.size())) {
+  for (int32_t bin : bins_) {
+    if (bin >= 0) ++hist_[bin];
+  }
+}
+
 std::vector<int32_t> NormalsHistogram::getPointsFromMostFrequentBin() const {
   std::vector<int32_t> point_ids;
 
@@ -67,6 +78,7 @@ std::vector<int32_t> NormalsHistogram::getPointsFromMostFrequentBin() const {
 }
 
 void NormalsHistogram::removePoint(int32_t point_id) {
+  if (bins_[point_id] < 0) return;
   --hist_[bins_[point_id]];
   bins_[point_id] = -1;
 }
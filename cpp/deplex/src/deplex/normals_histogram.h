@@ -35,6 +35,15 @@ class NormalsHistogram {
    */
   NormalsHistogram(int32_t nr_bins_per_coord, Eigen::MatrixX3f const& normals);
 
+  /**
+   * NormalsHistogram constructor.
+   * Build histogram from precomputed bins of cells, e.g. Manhattan axes.
+   *
+   * @param nr_bins Total number of bins.
+   * @param bins Bin of each cell, -1 excludes cell from histogram.
+   */
+  NormalsHistogram(int32_t nr_bins, std::vector<int32_t> bins);
+
   /**
    * Get the id's of cells whose normals lie in the dominant direction.
    *
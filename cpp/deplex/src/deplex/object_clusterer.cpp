@@ -0,0 +1,151 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "deplex/object_clusterer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "plane_geometry.h"
+
+namespace deplex {
+ObjectClusterer::ObjectClusterer(int32_t image_height, int32_t image_width, float depth_discontinuity_threshold,
+                                 int32_t min_cluster_size)
+    : image_height_(image_height),
+      image_width_(image_width),
+      depth_discontinuity_threshold_(depth_discontinuity_threshold),
+      min_cluster_size_(min_cluster_size) {}
+
+int32_t ObjectClusterer::findRoot(int32_t component) {
+  while (parents_[component] != component) {
+    parents_[component] = parents_[parents_[component]];
+    component = parents_[component];
+  }
+  return component;
+}
+
+std::vector<ObjectCluster> ObjectClusterer::cluster(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array,
+                                                    ExtractionResult const& result, int32_t support_label,
+                                                    float min_height, float max_height) {
+  if (pcd_array.rows() != static_cast<Eigen::Index>(image_height_) * image_width_ ||
+      result.labels.size() != pcd_array.rows()) {
+    throw std::runtime_error("Error! Number of points doesn't match image shape: " +
+                             std::to_string(pcd_array.rows()) + " != " + std::to_string(image_height_) + " x " +
+                             std::to_string(image_width_));
+  }
+  auto support = std::find_if(result.planes.begin(), result.planes.end(),
+                              [support_label](PlaneModel const& plane) { return plane.label == support_label; });
+  if (support == result.planes.end()) {
+    throw std::runtime_error("Error! No plane with label " + std::to_string(support_label));
+  }
+  if (support->contours.empty()) {
+    throw std::runtime_error("Error! Support plane has no geometry, set Config::compute_geometry to cluster objects.");
+  }
+
+  Eigen::Vector3f const& normal = support->normal;
+  Eigen::Vector3f const& origin = support->box.center;
+  Eigen::Vector3f u_axis = support->box.axes.col(0);
+  Eigen::Vector3f v_axis = support->box.axes.col(1);
+  Eigen::Matrix2Xf hull(2, static_cast<Eigen::Index>(support->convex_hull.size()));
+  for (size_t i = 0; i < support->convex_hull.size(); ++i) {
+    Eigen::Vector3f offset = support->convex_hull[i] - origin;
+    hull.col(i) << u_axis.dot(offset), v_axis.dot(offset);
+  }
+
+  // 1. Select points above support plane, heights are computed for whole cloud at once
+  Eigen::ArrayXf heights = (pcd_array * normal).array() + support->d;
+  components_.assign(pcd_array.rows(), -1);
+  parents_.clear();
+  auto isSelected = [&](Eigen::Index i) {
+    if (pcd_array(i, 2) <= 0 || result.labels[i] == support_label || heights[i] < min_height ||
+        heights[i] > max_height) {
+      return false;
+    }
+    Eigen::Vector3f offset = pcd_array.row(i).transpose() - origin;
+    return hull.cols() >= 3 && isInsideConvexPolygon(hull, Eigen::Vector2f(u_axis.dot(offset), v_axis.dot(offset)));
+  };
+
+  // 2. First raster pass: provisional components, merged through union-find
+  for (int32_t row = 0; row < image_height_; ++row) {
+    for (int32_t col = 0; col < image_width_; ++col) {
+      Eigen::Index i = static_cast<Eigen::Index>(row) * image_width_ + col;
+      if (!isSelected(i)) {
+        continue;
+      }
+      float depth = pcd_array(i, 2);
+      int32_t left = -1, up = -1;
+      if (col > 0 && components_[i - 1] >= 0 &&
+          std::abs(pcd_array(i - 1, 2) - depth) <= depth_discontinuity_threshold_) {
+        left = findRoot(components_[i - 1]);
+      }
+      if (row > 0 && components_[i - image_width_] >= 0 &&
+          std::abs(pcd_array(i - image_width_, 2) - depth) <= depth_discontinuity_threshold_) {
+        up = findRoot(components_[i - image_width_]);
+      }
+      if (left < 0 && up < 0) {
+        components_[i] = static_cast<int32_t>(parents_.size());
+        parents_.push_back(components_[i]);
+      } else if (left < 0 || up < 0) {
+        components_[i] = std::max(left, up);
+      } else {
+        components_[i] = std::min(left, up);
+        parents_[std::max(left, up)] = components_[i];
+      }
+    }
+  }
+
+  // 3. Second raster pass: resolve roots, collect pixels of clusters in order of their first pixel
+  std::vector<int32_t> cluster_by_root(parents_.size(), -1);
+  std::vector<ObjectCluster> clusters;
+  for (Eigen::Index i = 0; i < static_cast<Eigen::Index>(components_.size()); ++i) {
+    if (components_[i] < 0) {
+      continue;
+    }
+    int32_t root = findRoot(components_[i]);
+    if (cluster_by_root[root] < 0) {
+      cluster_by_root[root] = static_cast<int32_t>(clusters.size());
+      clusters.emplace_back();
+    }
+    clusters[cluster_by_root[root]].pixels.push_back(static_cast<int32_t>(i));
+  }
+  clusters.erase(std::remove_if(clusters.begin(), clusters.end(),
+                                [this](ObjectCluster const& cluster) {
+                                  return static_cast<int32_t>(cluster.pixels.size()) < min_cluster_size_;
+                                }),
+                 clusters.end());
+
+  // 4. Bounding boxes in support plane frame
+  Eigen::Matrix3f axes;
+  axes << u_axis, v_axis, normal;
+  for (auto& cluster : clusters) {
+    Eigen::Vector3f min_coords = Eigen::Vector3f::Constant(std::numeric_limits<float>::max());
+    Eigen::Vector3f max_coords = Eigen::Vector3f::Constant(std::numeric_limits<float>::lowest());
+    for (int32_t pixel : cluster.pixels) {
+      Eigen::Vector3f coords = axes.transpose() * (pcd_array.row(pixel).transpose() - origin);
+      min_coords = min_coords.cwiseMin(coords);
+      max_coords = max_coords.cwiseMax(coords);
+    }
+    // Objects stand on support plane: box spans from plane to the highest point
+    min_coords.z() = std::min(min_coords.z(), -(normal.dot(origin) + support->d));
+    cluster.box.axes = axes;
+    cluster.box.center = origin + axes * ((min_coords + max_coords) / 2);
+    cluster.box.half_extents = (max_coords - min_coords) / 2;
+  }
+  return clusters;
+}
+}  // namespace deplex
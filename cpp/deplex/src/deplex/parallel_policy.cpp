@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "parallel_policy.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace deplex {
+namespace {
+// Minimal amount of work in one chunk, unit: nanoseconds
+constexpr double kMinChunkNs = 20000;
+// Weight of a new measurement in per-pixel cost and serial fraction moving averages
+constexpr float kCostUpdateWeight = 0.2f;
+// Decay of serial fraction by each serial run, so that a transient slowdown of parallel runs
+// doesn't keep the stage serial for good
+constexpr float kSerialFractionDecay = 0.05f;
+// Initial costs, unit: nanoseconds (measured on x86-64 desktop, refined at runtime)
+constexpr float kDefaultForkJoinNs = 3000;
+constexpr float kDefaultPixelCostNs[] = {0.5f, 3.0f, 0.5f, 1.0f, 1.0f};
+
+thread_local bool force_serial_execution = false;
+
+double forkJoinTime(double fork_join_ns, int32_t nr_threads) {
+  return nr_threads > 1 ? fork_join_ns * std::ceil(std::log2(nr_threads)) : 0;
+}
+}  // namespace
+
+ParallelPolicy::ParallelPolicy() : max_threads_(1), fork_join_ns_(kDefaultForkJoinNs) {
+#ifdef _OPENMP
+  max_threads_ = omp_get_max_threads();
+#endif
+  for (size_t i = 0; i < pixel_cost_ns_.size(); ++i) {
+    pixel_cost_ns_[i] = kDefaultPixelCostNs[i];
+    serial_fraction_[i] = 0;
+  }
+}
+
+ParallelPolicy& ParallelPolicy::global() {
+  static ParallelPolicy policy;
+  return policy;
+}
+
+ParallelPolicy::Schedule ParallelPolicy::getSchedule(ParallelStage stage, int64_t nr_items,
+                                                     int64_t pixels_per_item) const {
+  if (nr_items <= 1 || max_threads_ <= 1 || force_serial_execution) {
+    return {1, static_cast<int32_t>(std::max<int64_t>(nr_items, 1))};
+  }
+  double item_ns = std::max(getPixelCost(stage) * pixels_per_item, 1e-3f);
+  double work_ns = item_ns * nr_items;
+  double fork_join_ns = getForkJoinCost();
+  double serial_fraction = getSerialFraction(stage);
+
+  int32_t nr_threads = 1;
+  double best_time_ns = work_ns;
+  auto max_threads = static_cast<int32_t>(std::min<int64_t>(max_threads_, nr_items));
+  for (int32_t p = 2; p <= max_threads; ++p) {
+    double time_ns = forkJoinTime(fork_join_ns, p) + work_ns * (serial_fraction + (1 - serial_fraction) / p);
+    if (time_ns < best_time_ns) {
+      best_time_ns = time_ns;
+      nr_threads = p;
+    }
+  }
+
+  int64_t items_per_thread = (nr_items + nr_threads - 1) / nr_threads;
+  auto grain_size = static_cast<int64_t>(std::ceil(kMinChunkNs / item_ns));
+  return {nr_threads, static_cast<int32_t>(std::min(std::max<int64_t>(grain_size, 1), items_per_thread))};
+}
+
+void ParallelPolicy::recordStageTime(ParallelStage stage, Schedule schedule, int64_t nr_pixels, double elapsed_ns) {
+  if (nr_pixels <= 0) {
+    return;
+  }
+  double compute_ns = elapsed_ns - forkJoinTime(getForkJoinCost(), schedule.nr_threads);
+  if (compute_ns <= 0) {
+    return;
+  }
+  auto& serial_fraction = serial_fraction_[static_cast<size_t>(stage)];
+  if (schedule.nr_threads <= 1) {
+    auto sample = static_cast<float>(compute_ns / nr_pixels);
+    auto& cost = pixel_cost_ns_[static_cast<size_t>(stage)];
+    cost.store((1 - kCostUpdateWeight) * cost.load(std::memory_order_relaxed) + kCostUpdateWeight * sample,
+               std::memory_order_relaxed);
+    serial_fraction.store((1 - kSerialFractionDecay) * serial_fraction.load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+    return;
+  }
+  // Solve compute time = work * (s + (1 - s) / p) for s, given per-pixel cost measured serially
+  double work_ns = static_cast<double>(getPixelCost(stage)) * nr_pixels;
+  double inverse_threads = 1. / schedule.nr_threads;
+  double sample = std::min(std::max((compute_ns / work_ns - inverse_threads) / (1 - inverse_threads), 0.), 1.);
+  serial_fraction.store((1 - kCostUpdateWeight) * serial_fraction.load(std::memory_order_relaxed) +
+                            kCostUpdateWeight * static_cast<float>(sample),
+                        std::memory_order_relaxed);
+}
+
+void ParallelPolicy::calibrateForkJoin() {
+#ifdef _OPENMP
+  constexpr int kNrRuns = 50;
+  // Regions must have a visible side effect, otherwise the compiler drops empty ones entirely
+  std::atomic<int32_t> nr_entered_threads{0};
+  // Warm up thread team
+#pragma omp parallel num_threads(max_threads_) default(none) shared(nr_entered_threads)
+  nr_entered_threads.fetch_add(1, std::memory_order_relaxed);
+  auto start_time = std::chrono::steady_clock::now();
+  for (int run = 0; run < kNrRuns; ++run) {
+#pragma omp parallel num_threads(max_threads_) default(none) shared(nr_entered_threads)
+    nr_entered_threads.fetch_add(1, std::memory_order_relaxed);
+  }
+  double elapsed_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start_time).count();
+  fork_join_ns_ = static_cast<float>(elapsed_ns / kNrRuns / std::max(std::ceil(std::log2(max_threads_)), 1.));
+#endif
+}
+
+void ParallelPolicy::setForceSerial(bool force_serial) { force_serial_execution = force_serial; }
+
+bool ParallelPolicy::isForceSerial() { return force_serial_execution; }
+
+float ParallelPolicy::getPixelCost(ParallelStage stage) const {
+  return pixel_cost_ns_[static_cast<size_t>(stage)].load(std::memory_order_relaxed);
+}
+
+float ParallelPolicy::getSerialFraction(ParallelStage stage) const {
+  return serial_fraction_[static_cast<size_t>(stage)].load(std::memory_order_relaxed);
+}
+
+float ParallelPolicy::getForkJoinCost() const { return fork_join_ns_.load(std::memory_order_relaxed); }
+
+ParallelPolicy::StageTimer::StageTimer(ParallelStage stage, Schedule schedule, int64_t nr_pixels)
+    : stage_(stage), schedule_(schedule), nr_pixels_(nr_pixels), start_time_(std::chrono::steady_clock::now()) {}
+
+ParallelPolicy::StageTimer::~StageTimer() {
+  double elapsed_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start_time_).count();
+  ParallelPolicy::global().recordStageTime(stage_, schedule_, nr_pixels_, elapsed_ns);
+}
+}  // namespace deplex
@@ -0,0 +1,118 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace deplex {
+/**
+ * Data-parallel stages of the algorithm.
+ */
+enum class ParallelStage : int32_t {
+  kCellOrganize = 0,
+  kCellStatistics,
+  kImageLabels,
+  kDenoise,
+  kResiduals,
+  kNrStages
+};
+
+/**
+ * Process-wide cost model deciding how OpenMP loops of each stage are executed.
+ *
+ * Execution time with p threads is modelled as fork_join_cost * ceil(log2(p)) + work * (s + (1 - s) / p),
+ * where work = pixels * pixel_cost(stage) and s = serial_fraction(stage) accounts for sublinear scaling
+ * (memory bandwidth, shared cores). Per-pixel costs are refined online from serial stage times and serial
+ * fractions from parallel ones, so small frames stay serial, while large frames use as many cores as pay off.
+ */
+class ParallelPolicy {
+ public:
+  struct Schedule {
+    // Number of OpenMP threads, 1 means serial execution
+    int32_t nr_threads;
+    // Number of consecutive loop iterations per chunk
+    int32_t grain_size;
+  };
+
+  /**
+   * RAII helper measuring stage execution time and feeding it back into the cost model.
+   */
+  class StageTimer {
+   public:
+    StageTimer(ParallelStage stage, Schedule schedule, int64_t nr_pixels);
+    ~StageTimer();
+
+   private:
+    ParallelStage stage_;
+    Schedule schedule_;
+    int64_t nr_pixels_;
+    std::chrono::steady_clock::time_point start_time_;
+  };
+
+  /**
+   * Create cost model with default per-pixel costs. Stage loops use global(), separate instances
+   * don't affect their schedules.
+   */
+  ParallelPolicy();
+
+  static ParallelPolicy& global();
+
+  /**
+   * Choose schedule of a stage loop.
+   *
+   * @param stage Algorithm stage.
+   * @param nr_items Number of loop iterations.
+   * @param pixels_per_item Number of pixels processed by one iteration.
+   * @returns Number of threads and chunk size.
+   */
+  Schedule getSchedule(ParallelStage stage, int64_t nr_items, int64_t pixels_per_item) const;
+
+  /**
+   * Update cost model of a stage with measured execution time: per-pixel cost if the stage ran serially,
+   * serial fraction otherwise. Parallel times never change per-pixel cost, since with sublinear scaling
+   * it would grow with the number of threads and make the model choose even more threads.
+   */
+  void recordStageTime(ParallelStage stage, Schedule schedule, int64_t nr_pixels, double elapsed_ns);
+
+  /**
+   * Measure OpenMP fork/join overhead of this machine. Called once per process.
+   */
+  void calibrateForkJoin();
+
+  /**
+   * Force serial execution of all stages in the calling thread, while flag is set.
+   * Used for calibrating per-pixel costs and by threads of a caller which parallelizes over frames itself.
+   */
+  static void setForceSerial(bool force_serial);
+
+  static bool isForceSerial();
+
+  float getPixelCost(ParallelStage stage) const;
+
+  float getSerialFraction(ParallelStage stage) const;
+
+  float getForkJoinCost() const;
+
+ private:
+  int32_t max_threads_;
+  std::atomic<float> fork_join_ns_;
+  std::array<std::atomic<float>, static_cast<size_t>(ParallelStage::kNrStages)> pixel_cost_ns_;
+  std::array<std::atomic<float>, static_cast<size_t>(ParallelStage::kNrStages)> serial_fraction_;
+};
+}  // namespace deplex
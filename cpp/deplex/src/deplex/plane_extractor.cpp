@@ -16,8 +16,16 @@
 #include "deplex/plane_extractor.h"
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <mutex>
 #include <numeric>
 #include <queue>
+#include <thread>
+#include <unordered_map>
 
 #if defined(DEBUG_DEPLEX) || defined(BENCHMARK_LOGGING)
 #include <fstream>
@@ -28,7 +36,12 @@
 #endif
 
 #include "cell_grid.h"
+#include "manhattan_frame.h"
 #include "normals_histogram.h"
+#include "parallel_policy.h"
+#include "plane_geometry.h"
+#include "robust_refit.h"
+#include "thread_placement.h"
 
 #include <rtl/Plane.hpp>
 #include <rtl/RANSAC.hpp>
@@ -39,10 +52,73 @@ template <typename T, typename Time>
 inline size_t get_benchmark_time(Time start_time) {
   return std::chrono::duration_cast<T>(std::chrono::high_resolution_clock::now() - start_time).count();
 }
+
+// Names of PipelineStage values
+char const* const kStageNames[] = {"Cell Grid Initialization", "Candidate Selection", "Region Growing", "Merge Planes",
+                                   "Labels creation", "Labels refinement", "Plane models"};
 }  // namespace
 #endif
 
 namespace deplex {
+namespace {
+/**
+ * Validate config and fit patch size into image.
+ *
+ * @param config Parameters of plane extraction algorithm.
+ * @param image_height Image height in pixels.
+ * @param image_width Image width in pixels.
+ * @returns Config with patch size not exceeding image size.
+ */
+config::Config fitConfigToImage(config::Config config, int32_t image_height, int32_t image_width) {
+  if (config.patch_size == 0) {
+    throw std::runtime_error("Error! Invalid config parameter: patchSize(" + std::to_string(config.patch_size) +
+                             "). patchSize has to be positive.");
+  }
+  if (config.realtime_priority < 0) {
+    throw std::runtime_error("Error! Invalid config parameter: realtimePriority(" +
+                             std::to_string(config.realtime_priority) + "). realtimePriority has to be non-negative.");
+  }
+  if (config.robust_refit_iterations < 0) {
+    throw std::runtime_error("Error! Invalid config parameter: robustRefitIterations(" +
+                             std::to_string(config.robust_refit_iterations) +
+                             "). robustRefitIterations has to be non-negative.");
+  }
+  if (config.max_frames_in_flight < 1) {
+    throw std::runtime_error("Error! Invalid config parameter: maxFramesInFlight(" +
+                             std::to_string(config.max_frames_in_flight) + "). maxFramesInFlight has to be positive.");
+  }
+  if (config.pipelined_processing && parseCpuList(config.cpu_affinity).size() == 1) {
+    throw std::runtime_error("Error! Invalid config parameter: cpuAffinity(" + config.cpu_affinity +
+                             "). pipelinedProcessing needs at least 2 CPUs to overlap frames.");
+  }
+  if (config.cell_connectivity != 4 && config.cell_connectivity != 8) {
+    throw std::runtime_error("Error! Invalid config parameter: cellConnectivity(" +
+                             std::to_string(config.cell_connectivity) + "). cellConnectivity has to be 4 or 8.");
+  }
+  config.patch_size = std::min(config.patch_size, std::min(image_height, image_width));
+  return config;
+}
+
+std::once_flag fork_join_calibrated;
+// Width of plane offset bucket of global merge, in units of maximum merge distance
+constexpr float kOffsetBucketScale = 8;
+
+/**
+ * Closest normal of horizontal or vertical plane.
+ *
+ * @param normal Unit plane normal.
+ * @param gravity Unit gravity direction.
+ * @returns Gravity direction for close to horizontal planes, normal projected onto horizontal plane otherwise.
+ */
+Eigen::Vector3f snapToGravity(Eigen::Vector3f const& normal, Eigen::Vector3f const& gravity) {
+  float cos_angle = normal.dot(gravity);
+  if (std::abs(cos_angle) >= static_cast<float>(M_SQRT1_2)) {
+    return cos_angle > 0 ? gravity : Eigen::Vector3f(-gravity);
+  }
+  return (normal - cos_angle * gravity).normalized();
+}
+}  // namespace
+
 /**
  * Class with encapsulated PlaneExtractor logic (see PIMPL idiom)
  */
@@ -57,6 +133,11 @@ class PlaneExtractor::Impl {
    */
   Impl(int32_t image_height, int32_t image_width, config::Config config);
 
+  /**
+   * Stop worker thread after processing all asynchronous frames.
+   */
+  ~Impl();
+
   /**
    * Extract planes from given image.
    *
@@ -65,7 +146,47 @@ class PlaneExtractor::Impl {
    * @returns 1D Array, where i-th value is plane number to which refers i-th point of point cloud.
    * 0-value label refers to non-planar segment.
    */
-  Eigen::VectorXi process(Eigen::MatrixX3f const& pcd_array);
+  Eigen::VectorXi process(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array);
+
+  /**
+   * Extract planes from given image, optionally using gravity prior.
+   *
+   * @param pcd_array Points matrix [Nx3] of ORGANIZED point cloud.
+   * @param gravity Unit gravity direction in camera coordinates, nullptr if unknown.
+   * @returns Point labels and plane models.
+   */
+  ExtractionResult extract(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array, Eigen::Vector3f const* gravity);
+
+  /**
+   * Size of memory allocated for intermediate per-frame data.
+   *
+   * @returns Workspace size, unit: bytes.
+   */
+  size_t getWorkspaceSize() const;
+
+  void setIntrinsics(Eigen::Matrix3f const& intrinsics);
+
+  /**
+   * Enqueue asynchronous frame, start worker thread on first call.
+   *
+   * @param pcd_array Reference-counted points matrix [Nx3] of ORGANIZED point cloud.
+   * @param callback Completion callback, called on worker thread.
+   */
+  void enqueue(PointCloudBuffer pcd_array, ExtractionCallback callback);
+
+  size_t getFramesInFlight() const;
+
+  void setStageEnabled(PipelineStage stage, bool enabled);
+
+  bool isStageEnabled(PipelineStage stage) const;
+
+  void addStageHook(PipelineStage stage, StageHook hook);
+
+  void clearStageHooks();
+
+  std::vector<double> getStageTimings() const;
+
+  void reset();
 
  private:
   config::Config config_;
@@ -73,16 +194,124 @@ class PlaneExtractor::Impl {
   int32_t nr_vertical_cells_;
   int32_t image_height_;
   int32_t image_width_;
+  CellLayout layout_;
+  CellGrid cell_grid_;
   Eigen::MatrixXi labels_map_;
-  std::vector<std::vector<Eigen::Index>> neighbours_;
+  std::vector<int32_t> affinity_cpus_;
+  // CPU of prefetch thread, taken from Config::cpu_affinity in pipelined mode
+  std::vector<int32_t> prefetch_cpus_;
+  bool calibration_pending_;
+  // Gravity prior and Manhattan frame of the frame being processed
+  bool has_gravity_;
+  Eigen::Vector3f gravity_;
+  bool has_manhattan_frame_;
+  Eigen::Matrix3f manhattan_frame_;
+  bool has_intrinsics_;
+  Eigen::Matrix3f intrinsics_;
+  std::array<bool, kNrPipelineStages> stage_enabled_;
+  std::array<std::vector<StageHook>, kNrPipelineStages> stage_hooks_;
+  // Stage durations of the last frame, unit: microseconds
+  std::array<double, kNrPipelineStages> stage_timings_;
+
+  struct AsyncFrame {
+    PointCloudBuffer pcd_array;
+    ExtractionCallback callback;
+    // Cell grid of the frame is computed by prefetch thread (pipelined processing)
+    bool prefetched;
+  };
+  // Serializes synchronous calls, worker thread and changes of stages and intrinsics, since they share workspace
+  mutable std::mutex extract_mutex_;
+  mutable std::mutex queue_mutex_;
+  std::condition_variable queue_condition_;
+  // Notified when a frame leaves flight
+  std::condition_variable drained_condition_;
+  std::deque<AsyncFrame> queue_;
+  size_t nr_frames_in_flight_;
+  bool stop_worker_;
+  std::thread worker_;
+  // Set by destructor called from completion callback, worker loop then returns without touching the extractor
+  bool* worker_destroyed_;
+  // Worker thread is owned by extractor, so it is placed once by the first frame
+  bool worker_placed_;
+  // Pipelined processing: second cell grid is filled with the next frame by prefetch thread
+  CellGrid next_cell_grid_;
+  std::mutex prefetch_mutex_;
+  std::condition_variable prefetch_condition_;
+  // Points of the frame to prefetch, the frame stays queued until prefetch is done
+  float const* prefetch_points_;
+  Eigen::Index nr_prefetch_points_;
+  bool prefetch_pending_;
+  std::exception_ptr prefetch_error_;
+  bool stop_prefetch_;
+  std::thread prefetch_thread_;
+
+  /**
+   * Worker thread loop: process queued frames in order until stopped and queue is drained.
+   */
+  void runWorker();
+
+  /**
+   * Extract planes of queued frame, optionally using prefetched cell grid and starting prefetch of the next frame.
+   *
+   * @param pcd_array Points matrix [Nx3] of ORGANIZED point cloud.
+   * @param prefetched true if cell grid of the frame was requested from prefetch thread.
+   * @param next_points Points of the next frame to prefetch, nullptr if there is none.
+   * @returns Point labels and plane models.
+   */
+  ExtractionResult extractQueued(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array, bool prefetched,
+                                 Eigen::Map<const Eigen::MatrixX3f> const* next_points);
+
+  /**
+   * Prefetch thread loop: update next_cell_grid_ with requested frame until stopped.
+   */
+  void runPrefetch();
+
+  /**
+   * Extract planes from given image, gravity prior is taken from has_gravity_ and gravity_.
+   *
+   * @param pcd_array Points matrix [Nx3] of ORGANIZED point cloud.
+   * @param has_cell_grid true if cell_grid_ is already updated with the frame.
+   * @returns Point labels and plane models.
+   */
+  ExtractionResult extractPlanes(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array, bool has_cell_grid = false);
+
+  /**
+   * Select cells that may seed or join a plane: planar cells, which are compatible with gravity prior (if any).
+   *
+   * @param cell_grid Cell Grid.
+   * @returns Boolean mask of candidate cells.
+   */
+  std::vector<bool> getCandidateCells(CellGrid const& cell_grid) const;
 
   /**
-   * Initialize histogram from planar cells of cell grid.
+   * Initialize histogram from candidate cells of cell grid.
+   * In Manhattan mode estimates Manhattan frame, histogram bins are then frame axes and cells
+   * not aligned with any axis are removed from candidates.
    *
    * @param cell_grid Cell Grid.
+   * @param candidate_mask Mask of cells to put into histogram.
    * @returns Histogram of cells' normals.
    */
-  NormalsHistogram initializeHistogram(CellGrid const& cell_grid);
+  NormalsHistogram initializeHistogram(CellGrid const& cell_grid, std::vector<bool>* candidate_mask);
+
+  /**
+   * Get Manhattan axis closest to normal.
+   *
+   * @param normal Unit normal.
+   * @param min_cos_angle Cosine of maximum deviation of normal from axis.
+   * @returns Column of manhattan_frame_, -1 if normal deviates from all axes more than allowed.
+   */
+  int32_t getManhattanAxis(Eigen::Vector3f const& normal, float min_cos_angle) const;
+
+  /**
+   * Collect models of planes remaining after merge.
+   *
+   * @param plane_segments Vector of merged cell segments.
+   * @param merge_labels Vector of merge labels.
+   * @returns Plane models in ascending order of label.
+   */
+  std::vector<PlaneModel> getPlaneModels(std::vector<CellSegment> const& plane_segments,
+                                         std::vector<int32_t> const& merge_labels) const;
 
   /**
    * Region Growing:
@@ -91,10 +320,12 @@ class PlaneExtractor::Impl {
    * 3. Push to cell segment.
    *
    * @param cell_grid Cell Grid.
+   * @param candidate_mask Mask of cells allowed to seed and join planes.
    * @param hist Histogram of cells' normals.
    * @returns Vector of grown cell segments.
    */
-  std::vector<CellSegment> createPlaneSegments(CellGrid const& cell_grid, NormalsHistogram hist);
+  std::vector<CellSegment> createPlaneSegments(CellGrid const& cell_grid, std::vector<bool> const& candidate_mask,
+                                               NormalsHistogram hist);
 
   /**
    * Find labels of cells, which can be merged.
@@ -104,6 +335,24 @@ class PlaneExtractor::Impl {
    */
   std::vector<int32_t> findMergedLabels(std::vector<CellSegment>* plane_segments);
 
+  /**
+   * Merge coplanar segments regardless of adjacency.
+   * Planes are hashed by quantized normal and offset, only planes of buckets within merge tolerance are compared.
+   *
+   * @param plane_segments Vector of merged cell segments.
+   * @param merge_labels Vector of merge labels, updated with new merges.
+   */
+  void mergeCoplanarSegments(std::vector<CellSegment>* plane_segments, std::vector<int32_t>* merge_labels) const;
+
+  /**
+   * Check merge criteria of two planes: normal angle, distance of candidate mean to plane and Manhattan axis.
+   *
+   * @param plane Plane to merge into.
+   * @param candidate Plane to be merged.
+   * @returns true if candidate can be merged into plane.
+   */
+  bool areMergeable(CellSegment const& plane, CellSegment const& candidate) const;
+
   /**
    * Transform merge label information into 1D label array of image size.
    *
@@ -112,6 +361,27 @@ class PlaneExtractor::Impl {
    */
   Eigen::VectorXi toImageLabels(std::vector<int32_t> const& merge_labels);
 
+  /**
+   * Resolve merge labels of cells.
+   *
+   * @param merge_labels Vector of merge labels.
+   * @returns Final plane label of each cell [nr_vertical_cells x nr_horizontal_cells], 0 - no plane.
+   */
+  Eigen::MatrixXi getCellLabels(std::vector<int32_t> const& merge_labels) const;
+
+  /**
+   * Label pixels of non-planar cells bordering planes: each pixel takes the closest plane of 4-neighbour cells,
+   * if its distance is within depth-dependent noise threshold.
+   *
+   * @param pcd_array Points matrix [Nx3] of ORGANIZED point cloud.
+   * @param plane_segments Vector of merged cell segments.
+   * @param cell_labels Final plane label of each cell.
+   * @param labels Flatten array of planes labels.
+   */
+  void refineBoundaries(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array,
+                        std::vector<CellSegment> const& plane_segments, Eigen::MatrixXi const& cell_labels,
+                        Eigen::VectorXi* labels) const;
+
   /**
    * Refines planes using RANSAC algorithm.
    *
@@ -119,7 +389,117 @@ class PlaneExtractor::Impl {
    * i.e. points that refer to organized image structure.
    * @param labels Flatten array of coarse planes labels
    */
-  void refineLabels(Eigen::MatrixX3f const& pcd_array, Eigen::VectorXi* labels);
+  void refineLabels(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array, Eigen::VectorXi* labels);
+
+  /**
+   * Build pixel index of planes (ExtractionResult::plane_offsets, plane_pixels) from final labels
+   * by counting sort: one pass counts plane sizes, one pass scatters pixel indices.
+   *
+   * @param result Extraction result with final labels and plane models.
+   */
+  static void buildPixelIndex(ExtractionResult* result);
+
+  /**
+   * Refit plane models to final plane pixels with robust loss (see Config::robust_loss).
+   *
+   * @param pcd_array Points matrix [Nx3] of ORGANIZED point cloud.
+   * @param result Extraction result with plane models to refit and pixel index.
+   */
+  void refitPlaneModels(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array, ExtractionResult* result) const;
+
+  /**
+   * Write residual map (ExtractionResult::residuals) and residual histograms of planes. Unlabelled pixels are
+   * evaluated against planes of adjacent cells only if Config::residual_map_unlabelled is set.
+   * Rows are processed in parallel with per-thread histograms, runs of equally labelled pixels are evaluated
+   * as vectorized blocks. Pixels filled by denoising have no measurement (zero input depth) and are skipped.
+   *
+   * @param pcd_array Points matrix [Nx3] of ORGANIZED point cloud.
+   * @param cell_labels Final plane label of each cell.
+   * @param result Extraction result with final labels and plane models.
+   */
+  void computeResiduals(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array, Eigen::MatrixXi const& cell_labels,
+                        ExtractionResult* result) const;
+
+  /**
+   * Write denoised point cloud (ExtractionResult::points): plane points are moved onto their plane along viewing ray.
+   * With intrinsics, zero-depth points of plane cells and of non-planar cells enclosed by one plane
+   * (all 4 neighbour cells) are filled by ray-plane intersection and labelled.
+   * Rows are processed in parallel, runs of equally labelled pixels are projected as vectorized blocks.
+   *
+   * @param pcd_array Points matrix [Nx3] of ORGANIZED point cloud.
+   * @param cell_labels Final plane label of each cell.
+   * @param result Extraction result with final labels and plane models.
+   */
+  void denoisePoints(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array, Eigen::MatrixXi const& cell_labels,
+                     ExtractionResult* result) const;
+
+  /**
+   * Compute outputs based on final pixel labels: robust refit, residual map, denoised points and pixel index.
+   *
+   * @param pcd_array Points matrix [Nx3] of ORGANIZED point cloud.
+   * @param cell_labels Final plane label of each cell.
+   * @param result Extraction result with final labels and plane models.
+   */
+  void computePixelOutputs(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array, Eigen::MatrixXi const& cell_labels,
+                           ExtractionResult* result) const;
+
+  /**
+   * Check if stage runs, called under extract_mutex_.
+   */
+  bool isEnabled(PipelineStage stage) const;
+
+  /**
+   * Check if output of stage has to be exported to pipeline frame: there are hooks at this or any later stage.
+   */
+  bool isExported(PipelineStage stage) const;
+
+  /**
+   * Call hooks of stage.
+   *
+   * @returns true if stage has hooks, i.e. frame data may be changed.
+   */
+  bool runHooks(PipelineStage stage, Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array, PipelineFrame* frame) const;
+
+  /**
+   * Record duration of stage and start timing of the next one.
+   *
+   * @param stage Finished stage.
+   * @param stage_start Start time of stage, set to current time.
+   */
+  void finishStage(PipelineStage stage, std::chrono::high_resolution_clock::time_point* stage_start);
+
+  /**
+   * Convert cell id of layout to row-major index of pipeline frame.
+   */
+  size_t toRowMajor(size_t cell_id) const;
+
+  /**
+   * Write planarity and statistics of cells to pipeline frame.
+   */
+  void exportCells(PipelineFrame* frame) const;
+
+  /**
+   * Compare cell labels written by hook with labels exported to it.
+   *
+   * @param hook_labels Cell labels after hooks, shape is validated.
+   * @param labels Exported cell labels.
+   * @returns true if labels are equal.
+   */
+  bool isUnchanged(Eigen::MatrixXi const& hook_labels, Eigen::MatrixXi const& labels) const;
+
+  /**
+   * Replace plane segments with segments of cell labels given by hook. Segments are summed from cells
+   * of cell grid, labels are compacted in ascending order and written to labels_map_.
+   *
+   * @param cell_segments Segment id of each cell, 0 - no segment.
+   * @returns Vector of cell segments.
+   */
+  std::vector<CellSegment> importSegments(Eigen::MatrixXi const& cell_segments);
+
+  /**
+   * Validate pixel labels given by hook: empty or of image size, every label is 0 or label of existing plane.
+   */
+  void checkLabels(Eigen::VectorXi const& labels, std::vector<int32_t> const& merge_labels) const;
 
   /**
    * Clean all used data for sufficient sequential image computing.
@@ -145,36 +525,83 @@ class PlaneExtractor::Impl {
    */
   std::vector<std::vector<bool>> getConnectedComponents(size_t nr_planes) const;
 
+  /**
+   * Feed parallel cost model with serial timings of synthetic frames of this image shape.
+   */
+  void calibrateParallelism();
+
 #ifdef DEBUG_DEPLEX
   void planarCellsToLabels(std::vector<bool> const& planar_flags, std::string const& save_path);
 #endif
 };
 
 PlaneExtractor::Impl::Impl(int32_t image_height, int32_t image_width, config::Config config)
-    : config_(config),
+    : config_(fitConfigToImage(config, image_height, image_width)),
       nr_horizontal_cells_(image_width / std::max(config.patch_size, 1)),
       nr_vertical_cells_(image_height / std::max(config.patch_size, 1)),
       image_height_(image_height),
       image_width_(image_width),
-      labels_map_(Eigen::MatrixXi::Zero(nr_vertical_cells_, nr_horizontal_cells_)) {
-  config_.patch_size = std::min(config_.patch_size, std::min(image_height_, image_width_));
-  if (config.patch_size == 0) {
-    throw std::runtime_error("Error! Invalid config parameter: patchSize(" + std::to_string(config.patch_size) +
-                             "). patchSize has to be positive.");
+      layout_(config_.cell_order, nr_vertical_cells_, nr_horizontal_cells_, config_.cell_connectivity),
+      cell_grid_(config_, layout_, image_width),
+      labels_map_(Eigen::MatrixXi::Zero(nr_vertical_cells_, nr_horizontal_cells_)),
+      affinity_cpus_(parseCpuList(config_.cpu_affinity)),
+      calibration_pending_(config_.parallel_calibration),
+      has_gravity_(false),
+      gravity_(Eigen::Vector3f::Zero()),
+      has_manhattan_frame_(false),
+      manhattan_frame_(Eigen::Matrix3f::Identity()),
+      has_intrinsics_(false),
+      intrinsics_(Eigen::Matrix3f::Identity()),
+      stage_timings_(),
+      nr_frames_in_flight_(0),
+      stop_worker_(false),
+      worker_destroyed_(nullptr),
+      worker_placed_(false),
+      next_cell_grid_(config_, layout_, image_width),
+      prefetch_points_(nullptr),
+      nr_prefetch_points_(0),
+      prefetch_pending_(false),
+      stop_prefetch_(false) {
+  stage_enabled_.fill(true);
+  stage_timings_.fill(0);
+  if (config_.pipelined_processing && !affinity_cpus_.empty()) {
+    // Prefetch thread gets a CPU of its own, so that it runs alongside real-time worker thread
+    prefetch_cpus_.push_back(affinity_cpus_.back());
+    affinity_cpus_.pop_back();
   }
+}
 
-  neighbours_.resize(nr_horizontal_cells_ * nr_vertical_cells_);
-
-  for (Eigen::Index i = 0; i < nr_horizontal_cells_ * nr_vertical_cells_; ++i) {
-    size_t x = i / nr_horizontal_cells_;
-    size_t y = i % nr_horizontal_cells_;
-    if (x >= 1) neighbours_[i].push_back(i - nr_horizontal_cells_);
-    if (x + 1 < nr_vertical_cells_) neighbours_[i].push_back(i + nr_horizontal_cells_);
-    if (y >= 1) neighbours_[i].push_back(i - 1);
-    if (y + 1 < nr_horizontal_cells_) neighbours_[i].push_back(i + 1);
+PlaneExtractor::Impl::~Impl() {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    stop_worker_ = true;
+  }
+  queue_condition_.notify_one();
+  if (worker_.joinable() && worker_.get_id() == std::this_thread::get_id()) {
+    // Destroyed from completion callback: process the rest of the queue here, worker loop returns afterwards
+    bool* worker_destroyed = worker_destroyed_;
+    runWorker();
+    *worker_destroyed = true;
+    worker_.detach();
+  } else if (worker_.joinable()) {
+    worker_.join();
+  }
+  {
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    stop_prefetch_ = true;
+  }
+  prefetch_condition_.notify_all();
+  if (prefetch_thread_.joinable()) {
+    prefetch_thread_.join();
   }
 }
 
+PointCloudBuffer::PointCloudBuffer(std::shared_ptr<const Eigen::MatrixX3f> matrix)
+    : points(matrix ? matrix->data() : nullptr, matrix ? matrix->rows() : 0, 3), owner(std::move(matrix)) {}
+
+PointCloudBuffer::PointCloudBuffer(Eigen::Map<const Eigen::MatrixX3f> points, std::shared_ptr<const void> owner)
+    : points(points), owner(std::move(owner)) {}
+
 PlaneExtractor::~PlaneExtractor() = default;
 PlaneExtractor::PlaneExtractor(PlaneExtractor&&) noexcept = default;
 PlaneExtractor& PlaneExtractor::operator=(PlaneExtractor&& op) noexcept = default;
@@ -182,9 +609,293 @@ PlaneExtractor& PlaneExtractor::operator=(PlaneExtractor&& op) noexcept = defaul
 PlaneExtractor::PlaneExtractor(int32_t image_height, int32_t image_width, config::Config config)
     : impl_(new Impl(image_height, image_width, config)) {}
 
-Eigen::VectorXi PlaneExtractor::process(Eigen::MatrixX3f const& pcd_array) { return impl_->process(pcd_array); }
+Eigen::VectorXi PlaneExtractor::process(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array) {
+  return impl_->process(pcd_array);
+}
+
+Eigen::VectorXi PlaneExtractor::process(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array,
+                                        Eigen::Vector3f const& gravity) {
+  return extract(pcd_array, gravity).labels;
+}
+
+ExtractionResult PlaneExtractor::extract(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array) {
+  return impl_->extract(pcd_array, nullptr);
+}
+
+ExtractionResult PlaneExtractor::extract(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array,
+                                         Eigen::Vector3f const& gravity) {
+  if (!(gravity.norm() > 0) || !gravity.allFinite()) {
+    throw std::runtime_error("Error! Gravity vector has to be finite and non-zero.");
+  }
+  Eigen::Vector3f unit_gravity = gravity.normalized();
+  return impl_->extract(pcd_array, &unit_gravity);
+}
+
+size_t PlaneExtractor::getWorkspaceSize() const { return impl_->getWorkspaceSize(); }
 
-Eigen::VectorXi PlaneExtractor::Impl::process(Eigen::MatrixX3f const& pcd_array) {
+void PlaneExtractor::setIntrinsics(Eigen::Matrix3f const& intrinsics) { impl_->setIntrinsics(intrinsics); }
+
+std::future<Eigen::VectorXi> PlaneExtractor::processAsync(PointCloudBuffer pcd_array) {
+  auto promise = std::make_shared<std::promise<Eigen::VectorXi>>();
+  std::future<Eigen::VectorXi> labels = promise->get_future();
+  impl_->enqueue(std::move(pcd_array), [promise](ExtractionResult result, std::exception_ptr error) {
+    if (error) {
+      promise->set_exception(error);
+    } else {
+      promise->set_value(std::move(result.labels));
+    }
+  });
+  return labels;
+}
+
+std::future<ExtractionResult> PlaneExtractor::extractAsync(PointCloudBuffer pcd_array) {
+  auto promise = std::make_shared<std::promise<ExtractionResult>>();
+  std::future<ExtractionResult> result = promise->get_future();
+  impl_->enqueue(std::move(pcd_array), [promise](ExtractionResult result, std::exception_ptr error) {
+    if (error) {
+      promise->set_exception(error);
+    } else {
+      promise->set_value(std::move(result));
+    }
+  });
+  return result;
+}
+
+void PlaneExtractor::extractAsync(PointCloudBuffer pcd_array, ExtractionCallback callback) {
+  if (!callback) {
+    throw std::runtime_error("Error! Completion callback is empty.");
+  }
+  impl_->enqueue(std::move(pcd_array), std::move(callback));
+}
+
+size_t PlaneExtractor::getFramesInFlight() const { return impl_->getFramesInFlight(); }
+
+void PlaneExtractor::setStageEnabled(PipelineStage stage, bool enabled) { impl_->setStageEnabled(stage, enabled); }
+
+bool PlaneExtractor::isStageEnabled(PipelineStage stage) const { return impl_->isStageEnabled(stage); }
+
+void PlaneExtractor::addStageHook(PipelineStage stage, StageHook hook) { impl_->addStageHook(stage, std::move(hook)); }
+
+void PlaneExtractor::clearStageHooks() { impl_->clearStageHooks(); }
+
+std::vector<double> PlaneExtractor::getStageTimings() const { return impl_->getStageTimings(); }
+
+void PlaneExtractor::reset() { impl_->reset(); }
+
+void PlaneExtractor::Impl::setIntrinsics(Eigen::Matrix3f const& intrinsics) {
+  if (!(intrinsics(0, 0) > 0) || !(intrinsics(1, 1) > 0)) {
+    throw std::runtime_error("Error! Focal lengths of intrinsics have to be positive.");
+  }
+  std::lock_guard<std::mutex> lock(extract_mutex_);
+  intrinsics_ = intrinsics;
+  has_intrinsics_ = true;
+}
+
+void PlaneExtractor::Impl::enqueue(PointCloudBuffer pcd_array, ExtractionCallback callback) {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (nr_frames_in_flight_ >= static_cast<size_t>(config_.max_frames_in_flight)) {
+      throw std::runtime_error("Error! Number of frames in flight exceeds maxFramesInFlight(" +
+                               std::to_string(config_.max_frames_in_flight) + ").");
+    }
+    if (!worker_.joinable()) {
+      worker_ = std::thread(&Impl::runWorker, this);
+      if (config_.pipelined_processing) {
+        prefetch_thread_ = std::thread(&Impl::runPrefetch, this);
+      }
+    }
+    queue_.push_back(AsyncFrame{std::move(pcd_array), std::move(callback), false});
+    ++nr_frames_in_flight_;
+  }
+  queue_condition_.notify_one();
+}
+
+size_t PlaneExtractor::Impl::getFramesInFlight() const {
+  std::lock_guard<std::mutex> lock(queue_mutex_);
+  return nr_frames_in_flight_;
+}
+
+void PlaneExtractor::Impl::runWorker() {
+  bool destroyed = false;
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  worker_destroyed_ = &destroyed;
+  while (true) {
+    queue_condition_.wait(lock, [this] { return stop_worker_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      return;
+    }
+    ExtractionCallback callback = std::move(queue_.front().callback);
+    PointCloudBuffer pcd_array = std::move(queue_.front().pcd_array);
+    bool prefetched = queue_.front().prefetched;
+    queue_.pop_front();
+    // Queued frame stays in place until it is popped, so its points outlive prefetching
+    Eigen::Map<const Eigen::MatrixX3f> const* next_points = nullptr;
+    if (config_.pipelined_processing && !queue_.empty() &&
+        queue_.front().pcd_array.points.rows() == static_cast<Eigen::Index>(image_height_) * image_width_) {
+      next_points = &queue_.front().pcd_array.points;
+      queue_.front().prefetched = true;
+    }
+    lock.unlock();
+
+    ExtractionResult result;
+    std::exception_ptr error;
+    try {
+      result = extractQueued(pcd_array.points, prefetched, next_points);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    // Frame leaves flight before completion, so that the callback may enqueue the next one
+    pcd_array.owner.reset();
+    lock.lock();
+    --nr_frames_in_flight_;
+    lock.unlock();
+    drained_condition_.notify_all();
+    try {
+      callback(std::move(result), error);
+    } catch (...) {
+      // Worker thread has no caller to report exceptions of callback to
+    }
+    if (destroyed) {
+      return;
+    }
+    lock.lock();
+  }
+}
+
+ExtractionResult PlaneExtractor::Impl::extractQueued(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array,
+                                                     bool prefetched,
+                                                     Eigen::Map<const Eigen::MatrixX3f> const* next_points) {
+  std::lock_guard<std::mutex> lock(extract_mutex_);
+  std::exception_ptr prefetch_error;
+  {
+    std::unique_lock<std::mutex> prefetch_lock(prefetch_mutex_);
+    prefetch_condition_.wait(prefetch_lock, [this] { return !prefetch_pending_; });
+    if (prefetched) {
+      std::swap(cell_grid_, next_cell_grid_);
+      std::swap(prefetch_error, prefetch_error_);
+    }
+    if (next_points != nullptr) {
+      prefetch_points_ = next_points->data();
+      nr_prefetch_points_ = next_points->rows();
+      prefetch_pending_ = true;
+    }
+  }
+  if (next_points != nullptr) {
+    prefetch_condition_.notify_all();
+  }
+  if (prefetch_error) {
+    std::rethrow_exception(prefetch_error);
+  }
+  if (!worker_placed_) {
+    applyThreadPlacement(affinity_cpus_, config_.realtime_priority);
+    worker_placed_ = true;
+  }
+  has_gravity_ = false;
+  return extractPlanes(pcd_array, prefetched);
+}
+
+void PlaneExtractor::Impl::runPrefetch() {
+  bool placed = false;
+  std::unique_lock<std::mutex> lock(prefetch_mutex_);
+  while (true) {
+    prefetch_condition_.wait(lock, [this] { return stop_prefetch_ || prefetch_pending_; });
+    if (!prefetch_pending_) {
+      return;
+    }
+    Eigen::Map<const Eigen::MatrixX3f> points(prefetch_points_, nr_prefetch_points_, 3);
+    lock.unlock();
+    std::exception_ptr error;
+    try {
+      if (!placed) {
+        applyThreadPlacement(prefetch_cpus_, config_.realtime_priority);
+        placed = true;
+      }
+      next_cell_grid_.update(points);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    lock.lock();
+    prefetch_error_ = error;
+    prefetch_pending_ = false;
+    prefetch_condition_.notify_all();
+  }
+}
+
+void PlaneExtractor::Impl::setStageEnabled(PipelineStage stage, bool enabled) {
+  if (stage == PipelineStage::kCellGrid && !enabled) {
+    throw std::runtime_error("Error! Cell grid stage can't be disabled.");
+  }
+  std::lock_guard<std::mutex> lock(extract_mutex_);
+  stage_enabled_.at(static_cast<size_t>(stage)) = enabled;
+}
+
+bool PlaneExtractor::Impl::isStageEnabled(PipelineStage stage) const {
+  std::lock_guard<std::mutex> lock(extract_mutex_);
+  return stage_enabled_.at(static_cast<size_t>(stage));
+}
+
+void PlaneExtractor::Impl::addStageHook(PipelineStage stage, StageHook hook) {
+  if (!hook) {
+    throw std::runtime_error("Error! Stage hook is empty.");
+  }
+  std::lock_guard<std::mutex> lock(extract_mutex_);
+  stage_hooks_.at(static_cast<size_t>(stage)).push_back(std::move(hook));
+}
+
+void PlaneExtractor::Impl::clearStageHooks() {
+  std::lock_guard<std::mutex> lock(extract_mutex_);
+  for (auto& hooks : stage_hooks_) {
+    hooks.clear();
+  }
+}
+
+std::vector<double> PlaneExtractor::Impl::getStageTimings() const {
+  std::lock_guard<std::mutex> lock(extract_mutex_);
+  return std::vector<double>(stage_timings_.begin(), stage_timings_.end());
+}
+
+void PlaneExtractor::Impl::reset() {
+  {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    if (worker_.get_id() == std::this_thread::get_id()) {
+      throw std::runtime_error("Error! Extractor can't be reset from completion callback.");
+    }
+    drained_condition_.wait(lock, [this] { return nr_frames_in_flight_ == 0; });
+  }
+  std::lock_guard<std::mutex> lock(extract_mutex_);
+  has_intrinsics_ = false;
+  intrinsics_ = Eigen::Matrix3f::Identity();
+  stage_enabled_.fill(true);
+  for (auto& hooks : stage_hooks_) {
+    hooks.clear();
+  }
+  stage_timings_.fill(0);
+}
+
+size_t PlaneExtractor::Impl::getWorkspaceSize() const {
+  // Computed from grid shape only: cell grids are swapped and updated by worker and prefetch threads
+  size_t cell_grid_size = CellGrid::getWorkspaceSize(layout_, config_.patch_size);
+  return cell_grid_size * (config_.pipelined_processing ? 2 : 1) +
+         static_cast<size_t>(nr_vertical_cells_) * nr_horizontal_cells_ * sizeof(int);
+}
+
+Eigen::VectorXi PlaneExtractor::Impl::process(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array) {
+  return extract(pcd_array, nullptr).labels;
+}
+
+ExtractionResult PlaneExtractor::Impl::extract(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array,
+                                               Eigen::Vector3f const* gravity) {
+  std::lock_guard<std::mutex> lock(extract_mutex_);
+  ScopedThreadPlacement placement(affinity_cpus_, config_.realtime_priority);
+  has_gravity_ = (gravity != nullptr);
+  if (has_gravity_) {
+    gravity_ = *gravity;
+  }
+  return extractPlanes(pcd_array);
+}
+
+ExtractionResult PlaneExtractor::Impl::extractPlanes(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array,
+                                                     bool has_cell_grid) {
   if (pcd_array.rows() != image_width_ * image_height_) {
     std::string msg_points_size = std::to_string(pcd_array.rows());
     std::string msg_width = std::to_string(image_width_);
@@ -192,53 +903,99 @@ Eigen::VectorXi PlaneExtractor::Impl::process(Eigen::MatrixX3f const& pcd_array)
     throw std::runtime_error("Error! Number of points doesn't match image shape: " + msg_points_size +
                              " != " + msg_height + " x " + msg_width);
   }
+  if (calibration_pending_) {
+    calibration_pending_ = false;
+    calibrateParallelism();
+  }
+  stage_timings_.fill(0);
+  PipelineFrame frame;
+  frame.nr_cell_rows = nr_vertical_cells_;
+  frame.nr_cell_cols = nr_horizontal_cells_;
+  ExtractionResult& result = frame.result;
+  auto stage_start = std::chrono::high_resolution_clock::now();
   // 1. Initialize cell grid (Planarity estimation)
-#ifdef BENCHMARK_LOGGING
-  auto time_init_cell_grid = std::chrono::high_resolution_clock::now();
-#endif
-  CellGrid cell_grid(pcd_array, config_, nr_horizontal_cells_, nr_vertical_cells_);
-#ifdef BENCHMARK_LOGGING
-  std::clog << "[BenchmarkLogging] Cell Grid Initialization: "
-            << get_benchmark_time<decltype(std::chrono::microseconds())>(time_init_cell_grid) << '\n';
-#endif
+  if (!has_cell_grid) {
+    cell_grid_.update(pcd_array);
+  }
+  CellGrid const& cell_grid = cell_grid_;
+  if (isExported(PipelineStage::kCellGrid)) {
+    exportCells(&frame);
+  }
+  runHooks(PipelineStage::kCellGrid, pcd_array, &frame);
+  finishStage(PipelineStage::kCellGrid, &stage_start);
 #ifdef DEBUG_DEPLEX
   planarCellsToLabels(cell_grid.getPlanarMask(), "dbg_1_planar_cells.csv");
   std::clog << "[DebugInfo] Planar cell found: "
             << std::count(cell_grid.getPlanarMask().begin(), cell_grid.getPlanarMask().end(), true) << '\n';
 #endif
-  // 2. Find dominant cell normals
-#ifdef BENCHMARK_LOGGING
-  auto time_init_histogram = std::chrono::high_resolution_clock::now();
-#endif
-  NormalsHistogram hist = initializeHistogram(cell_grid);
-#ifdef BENCHMARK_LOGGING
-  std::clog << "[BenchmarkLogging] Histogram Initialization: "
-            << get_benchmark_time<decltype(std::chrono::microseconds())>(time_init_histogram) << '\n';
-#endif
+  // 2. Select candidate cells
+  std::vector<bool> candidate_mask =
+      isEnabled(PipelineStage::kCandidateSelection) ? getCandidateCells(cell_grid) : cell_grid.getPlanarMask();
+  if (isExported(PipelineStage::kCandidateSelection)) {
+    frame.candidate_cells.assign(candidate_mask.size(), false);
+    for (size_t cell_id = 0; cell_id < candidate_mask.size(); ++cell_id) {
+      frame.candidate_cells[toRowMajor(cell_id)] = candidate_mask[cell_id];
+    }
+  }
+  if (runHooks(PipelineStage::kCandidateSelection, pcd_array, &frame)) {
+    if (frame.candidate_cells.size() != candidate_mask.size()) {
+      throw std::runtime_error("Error! Size of candidate cells doesn't match number of cells: " +
+                               std::to_string(frame.candidate_cells.size()) +
+                               " != " + std::to_string(candidate_mask.size()));
+    }
+    for (size_t cell_id = 0; cell_id < candidate_mask.size(); ++cell_id) {
+      candidate_mask[cell_id] = frame.candidate_cells[toRowMajor(cell_id)];
+    }
+  }
+  finishStage(PipelineStage::kCandidateSelection, &stage_start);
   // 3. Region growing
-#ifdef BENCHMARK_LOGGING
-  auto time_region_growing = std::chrono::high_resolution_clock::now();
-#endif
-  auto plane_segments = createPlaneSegments(cell_grid, hist);
-#ifdef BENCHMARK_LOGGING
-  std::clog << "[BenchmarkLogging] Region Growing: "
-            << get_benchmark_time<decltype(std::chrono::microseconds())>(time_region_growing) << '\n';
-#endif
+  std::vector<CellSegment> plane_segments;
+  has_manhattan_frame_ = false;
+  if (isEnabled(PipelineStage::kRegionGrowing)) {
+    NormalsHistogram hist = initializeHistogram(cell_grid, &candidate_mask);
+    plane_segments = createPlaneSegments(cell_grid, candidate_mask, hist);
+  }
+  if (isExported(PipelineStage::kRegionGrowing)) {
+    frame.cell_segments = labels_map_;
+  }
+  if (runHooks(PipelineStage::kRegionGrowing, pcd_array, &frame) && !isUnchanged(frame.cell_segments, labels_map_)) {
+    plane_segments = importSegments(frame.cell_segments);
+  }
+  finishStage(PipelineStage::kRegionGrowing, &stage_start);
 #ifdef DEBUG_DEPLEX
   std::clog << "[DebugInfo] Plane segments found: " << (plane_segments.empty() ? 0 : plane_segments.size() - 1) << '\n';
 #endif
+  result.has_manhattan_frame = has_manhattan_frame_;
+  result.manhattan_frame = manhattan_frame_;
   if (plane_segments.empty()) {
-    return Eigen::VectorXi::Zero(pcd_array.rows());
+    if (isEnabled(PipelineStage::kLabels)) {
+      result.labels = Eigen::VectorXi::Zero(pcd_array.rows());
+    }
+    cleanArtifacts();
+    return std::move(result);
   }
-  // 5. Merge planes
-#ifdef BENCHMARK_LOGGING
-  auto time_merge_planes = std::chrono::high_resolution_clock::now();
-#endif
-  std::vector<int32_t> merge_labels = findMergedLabels(&plane_segments);
-#ifdef BENCHMARK_LOGGING
-  std::clog << "[BenchmarkLogging] Merge Planes: "
-            << get_benchmark_time<decltype(std::chrono::microseconds())>(time_merge_planes) << '\n';
-#endif
+  // 4. Merge planes
+  std::vector<int32_t> merge_labels(plane_segments.size());
+  std::iota(merge_labels.begin(), merge_labels.end(), 0);
+  if (isEnabled(PipelineStage::kMerge)) {
+    merge_labels = findMergedLabels(&plane_segments);
+    if (config_.global_merge) {
+      mergeCoplanarSegments(&plane_segments, &merge_labels);
+    }
+  }
+  Eigen::MatrixXi cell_labels;
+  if (config_.boundary_refinement || config_.compute_geometry || config_.denoise_points || config_.residual_map ||
+      isExported(PipelineStage::kMerge)) {
+    cell_labels = getCellLabels(merge_labels);
+    frame.cell_labels = cell_labels;
+  }
+  if (runHooks(PipelineStage::kMerge, pcd_array, &frame) && !isUnchanged(frame.cell_labels, cell_labels)) {
+    plane_segments = importSegments(frame.cell_labels);
+    merge_labels.resize(plane_segments.size());
+    std::iota(merge_labels.begin(), merge_labels.end(), 0);
+    cell_labels = labels_map_;
+  }
+  finishStage(PipelineStage::kMerge, &stage_start);
 #ifdef DEBUG_DEPLEX
   std::vector<int32_t> sorted_labels(merge_labels);
   std::sort(sorted_labels.begin(), sorted_labels.end());
@@ -247,56 +1004,290 @@ Eigen::VectorXi PlaneExtractor::Impl::process(Eigen::MatrixX3f const& pcd_array)
             << std::distance(sorted_labels.begin(), std::unique(sorted_labels.begin(), sorted_labels.end())) - 1
             << '\n';
 #endif
+  // 5. Labels creation
+  if (isEnabled(PipelineStage::kLabels)) {
+    result.labels = toImageLabels(merge_labels);
+  }
+  if (runHooks(PipelineStage::kLabels, pcd_array, &frame)) {
+    checkLabels(result.labels, merge_labels);
+  }
+  finishStage(PipelineStage::kLabels, &stage_start);
+  bool has_labels = (result.labels.size() != 0);
+  // 6. Refine labels
+  if (isEnabled(PipelineStage::kRefinement) && has_labels) {
+    if (config_.boundary_refinement) {
 #ifdef BENCHMARK_LOGGING
-  auto time_labels_creation = std::chrono::high_resolution_clock::now();
+      auto time_boundary_refinement = std::chrono::high_resolution_clock::now();
 #endif
-  Eigen::VectorXi labels = toImageLabels(merge_labels);
+      refineBoundaries(pcd_array, plane_segments, cell_labels, &result.labels);
 #ifdef BENCHMARK_LOGGING
-  std::clog << "[BenchmarkLogging] Labels creation: "
-            << get_benchmark_time<decltype(std::chrono::microseconds())>(time_labels_creation) << '\n';
+      std::clog << "[BenchmarkLogging] Boundary refinement: "
+                << get_benchmark_time<decltype(std::chrono::microseconds())>(time_boundary_refinement) << '\n';
 #endif
+    }
 #ifdef DEBUG_DEPLEX
-  std::ofstream of("dbg_3_labels.csv");
-  of << labels.reshaped<Eigen::RowMajor>(image_height_, image_width_)
-            .format(Eigen::IOFormat(Eigen::StreamPrecision, Eigen::DontAlignCols, ",", "\n"));
-  of.close();
+    std::ofstream of("dbg_3_labels.csv");
+    of << result.labels.reshaped<Eigen::RowMajor>(image_height_, image_width_)
+              .format(Eigen::IOFormat(Eigen::StreamPrecision, Eigen::DontAlignCols, ",", "\n"));
+    of.close();
 #endif
-  // 7. Refine planes
-  if (config_.ransac_refinement) {
+    if (config_.ransac_refinement) {
+      refineLabels(pcd_array, &result.labels);
+#ifdef DEBUG_DEPLEX
+      of.open("dbg_4_refined_labels.csv");
+      of << result.labels.reshaped<Eigen::RowMajor>(image_height_, image_width_)
+                .format(Eigen::IOFormat(Eigen::StreamPrecision, Eigen::DontAlignCols, ",", "\n"));
+#endif
+    }
+  }
+  if (runHooks(PipelineStage::kRefinement, pcd_array, &frame)) {
+    checkLabels(result.labels, merge_labels);
+    has_labels = (result.labels.size() != 0);
+  }
+  finishStage(PipelineStage::kRefinement, &stage_start);
+  // 7. Plane models
+  if (isEnabled(PipelineStage::kPlaneModels)) {
+    result.planes = getPlaneModels(plane_segments, merge_labels);
+    if (has_labels) {
+      computePixelOutputs(pcd_array, cell_labels, &result);
+    }
+    if (config_.compute_geometry) {
+      computePlaneGeometry(cell_labels, cell_grid_, plane_segments, &result.planes);
+    }
+  }
+  runHooks(PipelineStage::kPlaneModels, pcd_array, &frame);
+  finishStage(PipelineStage::kPlaneModels, &stage_start);
+  // 8. Cleanup
+  cleanArtifacts();
+  return std::move(result);
+}
+
+void PlaneExtractor::Impl::computePixelOutputs(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array,
+                                               Eigen::MatrixXi const& cell_labels, ExtractionResult* result) const {
+  if (config_.robust_loss != config::RobustLoss::kNone) {
+    buildPixelIndex(result);
 #ifdef BENCHMARK_LOGGING
-    auto time_refinement = std::chrono::high_resolution_clock::now();
+    auto time_refit = std::chrono::high_resolution_clock::now();
 #endif
-    refineLabels(pcd_array, &labels);
+    refitPlaneModels(pcd_array, result);
 #ifdef BENCHMARK_LOGGING
-    std::clog << "[BenchmarkLogging] Labels refinement: "
-              << get_benchmark_time<decltype(std::chrono::microseconds())>(time_labels_creation) << '\n';
+    std::clog << "[BenchmarkLogging] Robust refit: "
+              << get_benchmark_time<decltype(std::chrono::microseconds())>(time_refit) << '\n';
 #endif
-#ifdef DEBUG_DEPLEX
-    of.open("dbg_4_refined_labels.csv");
-    of << labels.reshaped<Eigen::RowMajor>(image_height_, image_width_)
-              .format(Eigen::IOFormat(Eigen::StreamPrecision, Eigen::DontAlignCols, ",", "\n"));
+  }
+  if (config_.denoise_points) {
+    denoisePoints(pcd_array, cell_labels, result);
+  }
+  // Residuals of input points after hole filling, so residual map covers final labels
+  if (config_.residual_map) {
+    computeResiduals(pcd_array, cell_labels, result);
+  }
+  if (!config_.pixel_index) {
+    result->plane_offsets.clear();
+    result->plane_pixels.clear();
+  } else if (config_.robust_loss == config::RobustLoss::kNone || config_.denoise_points) {
+    // Hole filling may label more pixels
+    buildPixelIndex(result);
+  }
+}
+
+bool PlaneExtractor::Impl::isEnabled(PipelineStage stage) const {
+  return stage_enabled_[static_cast<size_t>(stage)];
+}
+
+bool PlaneExtractor::Impl::isExported(PipelineStage stage) const {
+  for (auto i = static_cast<size_t>(stage); i < kNrPipelineStages; ++i) {
+    if (!stage_hooks_[i].empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool PlaneExtractor::Impl::runHooks(PipelineStage stage, Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array,
+                                    PipelineFrame* frame) const {
+  auto const& hooks = stage_hooks_[static_cast<size_t>(stage)];
+  for (auto const& hook : hooks) {
+    hook(pcd_array, frame);
+  }
+  return !hooks.empty();
+}
+
+void PlaneExtractor::Impl::finishStage(PipelineStage stage,
+                                       std::chrono::high_resolution_clock::time_point* stage_start) {
+  auto stage_end = std::chrono::high_resolution_clock::now();
+  stage_timings_[static_cast<size_t>(stage)] =
+      std::chrono::duration<double, std::micro>(stage_end - *stage_start).count();
+  *stage_start = stage_end;
+#ifdef BENCHMARK_LOGGING
+  std::clog << "[BenchmarkLogging] " << kStageNames[static_cast<size_t>(stage)] << ": "
+            << static_cast<int64_t>(stage_timings_[static_cast<size_t>(stage)]) << '\n';
 #endif
+}
+
+size_t PlaneExtractor::Impl::toRowMajor(size_t cell_id) const {
+  return static_cast<size_t>(layout_.getRow(cell_id)) * nr_horizontal_cells_ + layout_.getCol(cell_id);
+}
+
+void PlaneExtractor::Impl::exportCells(PipelineFrame* frame) const {
+  auto nr_cells = static_cast<Eigen::Index>(cell_grid_.size());
+  frame->cell_planar.assign(nr_cells, false);
+  frame->cell_normals.setZero(nr_cells, 3);
+  frame->cell_means.setZero(nr_cells, 3);
+  frame->cell_mse.setZero(nr_cells);
+  for (Eigen::Index cell_id = 0; cell_id < nr_cells; ++cell_id) {
+    CellSegment const& cell = cell_grid_[cell_id];
+    if (!cell.isPlanar()) {
+      continue;
+    }
+    size_t index = toRowMajor(cell_id);
+    frame->cell_planar[index] = true;
+    frame->cell_normals.row(index) = cell.getStat().getNormal();
+    frame->cell_means.row(index) = cell.getStat().getMean();
+    frame->cell_mse[index] = cell.getStat().getMSE();
+  }
+}
+
+bool PlaneExtractor::Impl::isUnchanged(Eigen::MatrixXi const& hook_labels, Eigen::MatrixXi const& labels) const {
+  if (hook_labels.rows() != nr_vertical_cells_ || hook_labels.cols() != nr_horizontal_cells_) {
+    throw std::runtime_error("Error! Cell labels shape doesn't match cell grid: " +
+                             std::to_string(hook_labels.rows()) + " x " + std::to_string(hook_labels.cols()) +
+                             " != " + std::to_string(nr_vertical_cells_) + " x " +
+                             std::to_string(nr_horizontal_cells_));
+  }
+  return hook_labels == labels;
+}
+
+std::vector<CellSegment> PlaneExtractor::Impl::importSegments(Eigen::MatrixXi const& cell_segments) {
+  if (cell_segments.minCoeff() < 0) {
+    throw std::runtime_error("Error! Cell labels have to be non-negative.");
+  }
+  std::vector<int32_t> ids(cell_segments.data(), cell_segments.data() + cell_segments.size());
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  ids.erase(std::remove(ids.begin(), ids.end(), 0), ids.end());
+
+  std::vector<CellSegment> plane_segments(ids.size());
+  for (int32_t row = 0; row < nr_vertical_cells_; ++row) {
+    for (int32_t col = 0; col < nr_horizontal_cells_; ++col) {
+      int32_t id = cell_segments(row, col);
+      if (id == 0) {
+        labels_map_(row, col) = 0;
+        continue;
+      }
+      auto label = static_cast<int32_t>(std::lower_bound(ids.begin(), ids.end(), id) - ids.begin()) + 1;
+      labels_map_(row, col) = label;
+      plane_segments[label - 1] += cell_grid_[layout_.toIndex(row, col)];
+    }
+  }
+  for (size_t segment_id = 0; segment_id < plane_segments.size(); ++segment_id) {
+    // Cells without enough valid points have no statistics, plane of such cells only would be NaN
+    if (plane_segments[segment_id].getStat().getNrPoints() == 0) {
+      throw std::runtime_error("Error! Cell label " + std::to_string(ids[segment_id]) +
+                               " covers only cells without valid points");
+    }
+    plane_segments[segment_id].calculateStats();
+  }
+  return plane_segments;
+}
+
+void PlaneExtractor::Impl::checkLabels(Eigen::VectorXi const& labels,
+                                       std::vector<int32_t> const& merge_labels) const {
+  if (labels.size() != 0 && labels.size() != static_cast<Eigen::Index>(image_height_) * image_width_) {
+    throw std::runtime_error("Error! Number of labels doesn't match image shape: " + std::to_string(labels.size()) +
+                             " != " + std::to_string(image_height_) + " x " + std::to_string(image_width_));
+  }
+  // Plane models are created for segments which are roots of merge, with label = segment id + 1
+  auto nr_segments = static_cast<int32_t>(merge_labels.size());
+  for (Eigen::Index i = 0; i < labels.size(); ++i) {
+    int32_t label = labels[i];
+    if (label != 0 && (label < 1 || label > nr_segments || merge_labels[label - 1] != label - 1)) {
+      throw std::runtime_error("Error! Label " + std::to_string(label) + " of pixel " + std::to_string(i) +
+                               " doesn't refer to any plane");
+    }
   }
-  // 8. Cleanup
-  cleanArtifacts();
-  return labels;
 }
 
-NormalsHistogram PlaneExtractor::Impl::initializeHistogram(CellGrid const& cell_grid) {
+std::vector<bool> PlaneExtractor::Impl::getCandidateCells(CellGrid const& cell_grid) const {
+  std::vector<bool> candidate_mask(cell_grid.getPlanarMask());
+  if (!has_gravity_) {
+    return candidate_mask;
+  }
+  float min_horizontal_cos = std::cos(config_.gravity_tolerance * static_cast<float>(M_PI) / 180);
+  float max_vertical_cos = std::sin(config_.gravity_tolerance * static_cast<float>(M_PI) / 180);
+  for (size_t i = 0; i < candidate_mask.size(); ++i) {
+    if (candidate_mask[i]) {
+      float cos_angle = std::abs(cell_grid[i].getStat().getNormal().dot(gravity_));
+      candidate_mask[i] = (cos_angle >= min_horizontal_cos || cos_angle <= max_vertical_cos);
+    }
+  }
+  return candidate_mask;
+}
+
+NormalsHistogram PlaneExtractor::Impl::initializeHistogram(CellGrid const& cell_grid,
+                                                           std::vector<bool>* candidate_mask) {
   Eigen::MatrixX3f normals = Eigen::MatrixX3f::Zero(cell_grid.size(), 3);
   for (Eigen::Index i = 0; i < cell_grid.size(); ++i) {
-    if (cell_grid.getPlanarMask()[i]) {
+    if ((*candidate_mask)[i]) {
       normals.row(i) = cell_grid[i].getStat().getNormal();
     }
   }
 
   int nr_bins_per_coord = config_.histogram_bins_per_coord;
+  has_manhattan_frame_ = false;
+  if (config_.manhattan_mode) {
+    float min_cos_angle = std::cos(config_.manhattan_tolerance * static_cast<float>(M_PI) / 180);
+    has_manhattan_frame_ =
+        estimateManhattanFrame(normals, nr_bins_per_coord, min_cos_angle, config_.min_region_growing_candidate_size,
+                               has_gravity_ ? &gravity_ : nullptr, &manhattan_frame_);
+    if (has_manhattan_frame_) {
+      std::vector<int32_t> cell_axes(normals.rows(), -1);
+      for (Eigen::Index i = 0; i < normals.rows(); ++i) {
+        if ((*candidate_mask)[i]) {
+          cell_axes[i] = getManhattanAxis(normals.row(i), min_cos_angle);
+          (*candidate_mask)[i] = (cell_axes[i] >= 0);
+        }
+      }
+      return NormalsHistogram{3, std::move(cell_axes)};
+    }
+  }
   return NormalsHistogram{nr_bins_per_coord, normals};
 }
 
-std::vector<CellSegment> PlaneExtractor::Impl::createPlaneSegments(CellGrid const& cell_grid, NormalsHistogram hist) {
+int32_t PlaneExtractor::Impl::getManhattanAxis(Eigen::Vector3f const& normal, float min_cos_angle) const {
+  Eigen::Index axis;
+  float cos_angle = (manhattan_frame_.transpose() * normal).cwiseAbs().maxCoeff(&axis);
+  return cos_angle >= min_cos_angle ? static_cast<int32_t>(axis) : -1;
+}
+
+std::vector<PlaneModel> PlaneExtractor::Impl::getPlaneModels(std::vector<CellSegment> const& plane_segments,
+                                                             std::vector<int32_t> const& merge_labels) const {
+  std::vector<PlaneModel> planes;
+  for (size_t plane_id = 0; plane_id < plane_segments.size(); ++plane_id) {
+    if (merge_labels[plane_id] != static_cast<int32_t>(plane_id)) {
+      continue;
+    }
+    CellSegmentStat const& stat = plane_segments[plane_id].getStat();
+    PlaneModel plane;
+    plane.label = static_cast<int32_t>(plane_id) + 1;
+    plane.normal = stat.getNormal();
+    plane.d = stat.getD();
+    plane.mean = stat.getMean();
+    plane.nr_points = stat.getNrPoints();
+    plane.mse = stat.getMSE();
+    plane.score = stat.getScore();
+    plane.covariance = stat.getParameterCovariance(config_.depth_sigma_coeff, config_.depth_sigma_margin);
+    plane.manhattan_axis = (has_manhattan_frame_ ? getManhattanAxis(plane.normal, -1) : -1);
+    planes.push_back(plane);
+  }
+  return planes;
+}
+
+std::vector<CellSegment> PlaneExtractor::Impl::createPlaneSegments(CellGrid const& cell_grid,
+                                                                   std::vector<bool> const& candidate_mask,
+                                                                   NormalsHistogram hist) {
   std::vector<CellSegment> plane_segments;
-  std::vector<bool> unassigned_mask(cell_grid.getPlanarMask());
+  std::vector<bool> unassigned_mask(candidate_mask);
   auto remaining_planar_cells = static_cast<int32_t>(std::count(unassigned_mask.begin(), unassigned_mask.end(), true));
 
   while (remaining_planar_cells > 0) {
@@ -305,13 +1296,18 @@ std::vector<CellSegment> PlaneExtractor::Impl::createPlaneSegments(CellGrid cons
     if (seed_candidates.size() < config_.min_region_growing_candidate_size) {
       return plane_segments;
     }
-    // 2. Select seed with minimum MSE
+    // 2. Select seed with minimum MSE, equal MSE (translated copies of cell) are resolved by row-major position
+    // to keep labels independent of cell order
     int32_t seed_id;
+    int32_t seed_position = 0;
     double min_mse = INT_MAX;
     for (int32_t seed_candidate : seed_candidates) {
-      if (cell_grid[seed_candidate].getStat().getMSE() < min_mse) {
+      double mse = cell_grid[seed_candidate].getStat().getMSE();
+      int32_t position = layout_.getRow(seed_candidate) * nr_horizontal_cells_ + layout_.getCol(seed_candidate);
+      if (mse < min_mse || (mse == min_mse && position < seed_position)) {
         seed_id = seed_candidate;
-        min_mse = cell_grid[seed_candidate].getStat().getMSE();
+        seed_position = position;
+        min_mse = mse;
       }
     }
     // 3. Grow seed
@@ -331,14 +1327,16 @@ std::vector<CellSegment> PlaneExtractor::Impl::createPlaneSegments(CellGrid cons
     }
 
     plane_candidate.calculateStats();
+    if (has_gravity_ && config_.gravity_snap) {
+      plane_candidate.setNormal(snapToGravity(plane_candidate.getStat().getNormal(), gravity_));
+    }
 
     // 5. Model fitting
     if (plane_candidate.getStat().getScore() > config_.min_region_planarity_score) {
       plane_segments.push_back(plane_candidate);
       auto nr_curr_planes = static_cast<int32_t>(plane_segments.size());
       for (auto v : cells_to_merge) {
-        labels_map_.row(static_cast<long>(v) / nr_horizontal_cells_)[static_cast<long>(v) % nr_horizontal_cells_] =
-            nr_curr_planes;
+        labels_map_(layout_.getRow(v), layout_.getCol(v)) = nr_curr_planes;
       }
     }
   }
@@ -369,9 +1367,9 @@ std::vector<size_t> PlaneExtractor::Impl::growSeed(Eigen::Index seed_id, std::ve
     double d_current = cell_grid[current_seed].getStat().getD();
     Eigen::Vector3f normal_current = cell_grid[current_seed].getStat().getNormal();
 
-    for (size_t neighbour : neighbours_[current_seed]) {
+    layout_.forEachNeighbour(current_seed, [&](size_t neighbour) {
       if (!unassigned[neighbour] || activation_map[neighbour]) {
-        continue;
+        return;
       }
 
       Eigen::Vector3f normal_neighbour = cell_grid[neighbour].getStat().getNormal();
@@ -385,7 +1383,7 @@ std::vector<size_t> PlaneExtractor::Impl::growSeed(Eigen::Index seed_id, std::ve
         cells_to_merge.push_back(neighbour);
         seed_queue.push(static_cast<Eigen::Index>(neighbour));
       }
-    }
+    });
   }
 
   return cells_to_merge;
@@ -404,13 +1402,7 @@ std::vector<int32_t> PlaneExtractor::Impl::findMergedLabels(std::vector<CellSegm
     bool plane_expanded = false;
     for (size_t col_id = row_id + 1; col_id != planes_association_mx[row_id].size(); ++col_id) {
       if (planes_association_mx[row_id][col_id]) {
-        double cos_angle =
-            plane_segments->at(plane_id).getStat().getNormal().dot(plane_segments->at(col_id).getStat().getNormal());
-        double distance =
-            pow(plane_segments->at(plane_id).getStat().getNormal().dot(plane_segments->at(col_id).getStat().getMean()) +
-                    plane_segments->at(plane_id).getStat().getD(),
-                2);
-        if (cos_angle > config_.min_cos_angle_merge && distance < config_.max_merge_dist) {
+        if (areMergeable(plane_segments->at(plane_id), plane_segments->at(col_id))) {
           plane_segments->at(plane_id) += plane_segments->at(col_id);
           plane_merge_labels[col_id] = plane_id;
           plane_expanded = true;
@@ -425,10 +1417,97 @@ std::vector<int32_t> PlaneExtractor::Impl::findMergedLabels(std::vector<CellSegm
   return plane_merge_labels;
 }
 
+bool PlaneExtractor::Impl::areMergeable(CellSegment const& plane, CellSegment const& candidate) const {
+  double cos_angle = plane.getStat().getNormal().dot(candidate.getStat().getNormal());
+  double distance = pow(plane.getStat().getNormal().dot(candidate.getStat().getMean()) + plane.getStat().getD(), 2);
+  bool same_axis = !has_manhattan_frame_ || getManhattanAxis(plane.getStat().getNormal(), -1) ==
+                                                getManhattanAxis(candidate.getStat().getNormal(), -1);
+  return cos_angle > config_.min_cos_angle_merge && distance < config_.max_merge_dist && same_axis;
+}
+
+void PlaneExtractor::Impl::mergeCoplanarSegments(std::vector<CellSegment>* plane_segments,
+                                                 std::vector<int32_t>* merge_labels) const {
+  // Normals of mergeable planes differ by at most chord of merge angle in each coordinate
+  float normal_step = std::sqrt(2 * (1 - config_.min_cos_angle_merge));
+  float offset_step = kOffsetBucketScale * std::sqrt(config_.max_merge_dist);
+  auto getBucket = [normal_step, offset_step](CellSegment const& plane) {
+    Eigen::Vector3f const& normal = plane.getStat().getNormal();
+    return Eigen::Vector4i(static_cast<int32_t>(std::floor(normal.x() / normal_step)),
+                           static_cast<int32_t>(std::floor(normal.y() / normal_step)),
+                           static_cast<int32_t>(std::floor(normal.z() / normal_step)),
+                           static_cast<int32_t>(std::floor(plane.getStat().getD() / offset_step)));
+  };
+  auto getBucketKey = [](Eigen::Vector4i const& bucket) {
+    uint64_t key = 0;
+    for (int32_t i = 0; i < 4; ++i) {
+      key = (key << 16) | static_cast<uint16_t>(bucket[i]);
+    }
+    return key;
+  };
+
+  // Current bucket of each plane, so that re-bucketed planes leave no stale entries
+  std::unordered_map<uint64_t, std::vector<int32_t>> buckets;
+  std::vector<uint64_t> plane_keys(plane_segments->size());
+  auto nr_planes = static_cast<int32_t>(plane_segments->size());
+  for (int32_t plane_id = 0; plane_id < nr_planes; ++plane_id) {
+    if ((*merge_labels)[plane_id] != plane_id) {
+      continue;
+    }
+    CellSegmentStat const& stat = plane_segments->at(plane_id).getStat();
+    Eigen::Vector4i bucket = getBucket(plane_segments->at(plane_id));
+    // Offset of mergeable plane differs by merge distance and by normal difference projected on the mean
+    float offset_range = std::sqrt(config_.max_merge_dist) + normal_step * stat.getMean().norm();
+    auto min_offset = static_cast<int32_t>(std::floor((stat.getD() - offset_range) / offset_step));
+    auto max_offset = static_cast<int32_t>(std::floor((stat.getD() + offset_range) / offset_step));
+    int32_t target_id = -1;
+    // Adjacent normal buckets: 3^3 combinations
+    for (int32_t shift = 0; shift < 27 && target_id < 0; ++shift) {
+      for (int32_t offset = min_offset; offset <= max_offset && target_id < 0; ++offset) {
+        Eigen::Vector4i shifted_bucket(bucket[0] + shift % 3 - 1, bucket[1] + shift / 3 % 3 - 1,
+                                       bucket[2] + shift / 9 - 1, offset);
+        auto candidates = buckets.find(getBucketKey(shifted_bucket));
+        if (candidates == buckets.end()) {
+          continue;
+        }
+        for (int32_t candidate_id : candidates->second) {
+          if (areMergeable(plane_segments->at(candidate_id), plane_segments->at(plane_id))) {
+            target_id = candidate_id;
+            break;
+          }
+        }
+      }
+    }
+
+    if (target_id < 0) {
+      plane_keys[plane_id] = getBucketKey(bucket);
+      buckets[plane_keys[plane_id]].push_back(plane_id);
+      continue;
+    }
+    plane_segments->at(target_id) += plane_segments->at(plane_id);
+    plane_segments->at(target_id).calculateStats();
+    // Union-find: merged plane points to its target, labels are resolved once after all merges
+    (*merge_labels)[plane_id] = target_id;
+    uint64_t target_key = getBucketKey(getBucket(plane_segments->at(target_id)));
+    if (target_key != plane_keys[target_id]) {
+      auto& old_bucket = buckets[plane_keys[target_id]];
+      old_bucket.erase(std::find(old_bucket.begin(), old_bucket.end(), target_id));
+      plane_keys[target_id] = target_key;
+      buckets[target_key].push_back(target_id);
+    }
+  }
+  // Targets are never merged themselves, so paths are at most two steps long
+  for (auto& label : *merge_labels) {
+    while ((*merge_labels)[label] != label) {
+      label = (*merge_labels)[label];
+    }
+  }
+}
+
 void PlaneExtractor::Impl::cleanArtifacts() { labels_map_.setZero(); }
 
 std::vector<std::vector<bool>> PlaneExtractor::Impl::getConnectedComponents(size_t nr_planes) const {
   std::vector<std::vector<bool>> planes_assoc_matrix(nr_planes, std::vector<bool>(nr_planes, false));
+  bool diagonal = config_.cell_connectivity == 8;
 
   for (int32_t row_id = 0; row_id < labels_map_.rows() - 1; ++row_id) {
     auto row = labels_map_.row(row_id);
@@ -440,7 +1519,13 @@ std::vector<std::vector<bool>> PlaneExtractor::Impl::getConnectedComponents(size
           planes_assoc_matrix[plane_id - 1][row[col_id + 1] - 1] = true;
         if (next_row[col_id] > 0 && plane_id != next_row[col_id])
           planes_assoc_matrix[plane_id - 1][next_row[col_id] - 1] = true;
+        if (diagonal && next_row[col_id + 1] > 0 && plane_id != next_row[col_id + 1])
+          planes_assoc_matrix[plane_id - 1][next_row[col_id + 1] - 1] = true;
       }
+      // Anti-diagonal pairs are checked from the upper-right cell
+      auto next_plane_id = row[col_id + 1];
+      if (diagonal && next_plane_id > 0 && next_row[col_id] > 0 && next_plane_id != next_row[col_id])
+        planes_assoc_matrix[next_plane_id - 1][next_row[col_id] - 1] = true;
     }
   }
   for (int32_t row_id = 0; row_id < planes_assoc_matrix.size(); ++row_id) {
@@ -457,10 +1542,19 @@ Eigen::VectorXi PlaneExtractor::Impl::toImageLabels(std::vector<int32_t> const&
 
   int32_t cell_width = config_.patch_size;
   int32_t cell_height = config_.patch_size;
-
-#pragma omp parallel for default(none) shared(labels, cell_height, cell_width, merge_labels)
-  for (auto row = 0; row < image_height_; ++row) {
-    for (auto col = 0; col < image_width_; ++col) {
+  // Trailing pixels of image sizes, that aren't a multiple of patch size, belong to no cell and stay unlabeled
+  int32_t nr_cell_pixel_rows = nr_vertical_cells_ * cell_height;
+  int32_t nr_cell_pixel_cols = nr_horizontal_cells_ * cell_width;
+
+  auto schedule =
+      ParallelPolicy::global().getSchedule(ParallelStage::kImageLabels, nr_cell_pixel_rows, nr_cell_pixel_cols);
+  ParallelPolicy::StageTimer timer(ParallelStage::kImageLabels, schedule,
+                                   static_cast<int64_t>(nr_cell_pixel_rows) * nr_cell_pixel_cols);
+#pragma omp parallel for default(none)                                                                  \
+    shared(labels, cell_height, cell_width, nr_cell_pixel_rows, nr_cell_pixel_cols, merge_labels, schedule) \
+    num_threads(schedule.nr_threads) schedule(static, schedule.grain_size) if (schedule.nr_threads > 1)
+  for (auto row = 0; row < nr_cell_pixel_rows; ++row) {
+    for (auto col = 0; col < nr_cell_pixel_cols; ++col) {
       auto label = labels_map_.row(row / cell_height)[col / cell_width];
       labels[row * image_width_ + col] = (label == 0 ? 0 : merge_labels[label - 1] + 1);
     }
@@ -469,7 +1563,81 @@ Eigen::VectorXi PlaneExtractor::Impl::toImageLabels(std::vector<int32_t> const&
   return labels;
 }
 
-void PlaneExtractor::Impl::refineLabels(Eigen::MatrixX3f const& pcd_array, Eigen::VectorXi* labels) {
+Eigen::MatrixXi PlaneExtractor::Impl::getCellLabels(std::vector<int32_t> const& merge_labels) const {
+  return labels_map_.unaryExpr(
+      [&merge_labels](int32_t label) { return label == 0 ? 0 : merge_labels[label - 1] + 1; });
+}
+
+void PlaneExtractor::Impl::refineBoundaries(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array,
+                                            std::vector<CellSegment> const& plane_segments,
+                                            Eigen::MatrixXi const& cell_labels, Eigen::VectorXi* labels) const {
+  constexpr int32_t kMaxCandidates = 4;
+  // Maximum point-to-plane distance in units of depth noise sigma
+  constexpr float kMaxSigmas = 3;
+  using CandidateNormals = Eigen::Matrix<float, 3, Eigen::Dynamic, Eigen::ColMajor, 3, kMaxCandidates>;
+  using CandidateOffsets = Eigen::Matrix<float, 1, Eigen::Dynamic, Eigen::RowMajor, 1, kMaxCandidates>;
+
+  int32_t cell_width = config_.patch_size;
+  int32_t cell_height = config_.patch_size;
+  auto nr_rows = static_cast<int32_t>(cell_labels.rows());
+  auto nr_cols = static_cast<int32_t>(cell_labels.cols());
+  int32_t neighbour_offsets[kMaxCandidates][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+  // Distances of span points to all candidate planes at once [cell_width x nr_candidates], allocated once per frame
+  Eigen::MatrixXf distances(cell_width, kMaxCandidates);
+
+  for (int32_t row = 0; row < nr_rows; ++row) {
+    for (int32_t col = 0; col < nr_cols; ++col) {
+      if (cell_labels(row, col) != 0) {
+        continue;
+      }
+      int32_t candidate_labels[kMaxCandidates];
+      int32_t nr_candidates = 0;
+      for (auto const& offset : neighbour_offsets) {
+        int32_t neighbour_row = row + offset[0], neighbour_col = col + offset[1];
+        if (neighbour_row < 0 || neighbour_row >= nr_rows || neighbour_col < 0 || neighbour_col >= nr_cols) {
+          continue;
+        }
+        int32_t label = cell_labels(neighbour_row, neighbour_col);
+        if (label != 0 && std::find(candidate_labels, candidate_labels + nr_candidates, label) ==
+                              candidate_labels + nr_candidates) {
+          candidate_labels[nr_candidates++] = label;
+        }
+      }
+      if (nr_candidates == 0) {
+        continue;
+      }
+
+      CandidateNormals normals(3, nr_candidates);
+      CandidateOffsets offsets(1, nr_candidates);
+      for (int32_t i = 0; i < nr_candidates; ++i) {
+        CellSegmentStat const& stat = plane_segments[candidate_labels[i] - 1].getStat();
+        normals.col(i) = stat.getNormal();
+        offsets[i] = stat.getD();
+      }
+      for (int32_t pixel_row = row * cell_height; pixel_row < (row + 1) * cell_height; ++pixel_row) {
+        Eigen::Index span_start = static_cast<Eigen::Index>(pixel_row) * image_width_ + col * cell_width;
+        auto span = pcd_array.middleRows(span_start, cell_width);
+        auto span_distances = distances.leftCols(nr_candidates);
+        span_distances.noalias() = span * normals;
+        span_distances = (span_distances.rowwise() + offsets).cwiseAbs();
+        for (int32_t i = 0; i < cell_width; ++i) {
+          float depth = span(i, 2);
+          if (depth <= 0) {
+            continue;
+          }
+          float sigma = config_.depth_sigma_coeff * depth * depth + config_.depth_sigma_margin;
+          Eigen::Index closest;
+          float distance = span_distances.row(i).minCoeff(&closest);
+          if (distance <= kMaxSigmas * sigma) {
+            (*labels)[span_start + i] = candidate_labels[closest];
+          }
+        }
+      }
+    }
+  }
+}
+
+void PlaneExtractor::Impl::refineLabels(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array, Eigen::VectorXi* labels) {
   std::vector<std::vector<int32_t>> labels_indices(labels->maxCoeff());
   for (int32_t i = 0; i < labels->size(); ++i) {
     if ((*labels)[i] != 0) {
@@ -508,6 +1676,255 @@ void PlaneExtractor::Impl::refineLabels(Eigen::MatrixX3f const& pcd_array, Eigen
   }
 }
 
+void PlaneExtractor::Impl::computeResiduals(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array,
+                                            Eigen::MatrixXi const& cell_labels, ExtractionResult* result) const {
+  std::vector<PlaneModel>& planes = result->planes;
+  Eigen::VectorXi const& labels = result->labels;
+  Eigen::VectorXf& residuals = result->residuals;
+  residuals.setConstant(labels.size(), std::numeric_limits<float>::quiet_NaN());
+  std::vector<int32_t> plane_by_label(planes.empty() ? 1 : planes.back().label + 1, -1);
+  for (size_t plane_id = 0; plane_id < planes.size(); ++plane_id) {
+    plane_by_label[planes[plane_id].label] = static_cast<int32_t>(plane_id);
+    planes[plane_id].residual_histogram.assign(kNrResidualBins, 0);
+  }
+
+  int32_t cell_size = config_.patch_size;
+  auto nr_cell_rows = static_cast<int32_t>(cell_labels.rows());
+  auto nr_cell_cols = static_cast<int32_t>(cell_labels.cols());
+  float sigma_coeff = config_.depth_sigma_coeff;
+  float sigma_margin = config_.depth_sigma_margin;
+  float residual_range = kResidualRange;
+  bool has_unlabelled_residuals = config_.residual_map_unlabelled;
+  auto schedule = ParallelPolicy::global().getSchedule(ParallelStage::kResiduals, image_height_, image_width_);
+  ParallelPolicy::StageTimer timer(ParallelStage::kResiduals, schedule, labels.size());
+#pragma omp parallel default(none)                                                                     \
+    shared(pcd_array, labels, residuals, planes, plane_by_label, cell_labels, cell_size, nr_cell_rows, nr_cell_cols, \
+           sigma_coeff, sigma_margin, residual_range, has_unlabelled_residuals, schedule)                         \
+        num_threads(schedule.nr_threads) if (schedule.nr_threads > 1)
+  {
+    std::vector<int32_t> histograms(planes.size() * kNrResidualBins, 0);
+#pragma omp for schedule(static, schedule.grain_size)
+    for (int32_t row = 0; row < image_height_; ++row) {
+      Eigen::Index row_start = static_cast<Eigen::Index>(row) * image_width_;
+      for (int32_t col = 0; col < image_width_;) {
+        int32_t label = labels[row_start + col];
+        int32_t run_end = col + 1;
+        while (run_end < image_width_ && labels[row_start + run_end] == label) {
+          ++run_end;
+        }
+        auto span = pcd_array.middleRows(row_start + col, run_end - col);
+        if (label != 0) {
+          int32_t plane_id = plane_by_label[label];
+          PlaneModel const& plane = planes[plane_id];
+          Eigen::ArrayXf span_residuals = (span * plane.normal).array() + plane.d;
+          Eigen::ArrayXf depths = span.col(2).array();
+          // Bin of residual in units of depth noise sigma
+          Eigen::ArrayXi bins = ((span_residuals / (sigma_coeff * depths.square() + sigma_margin) + residual_range) *
+                                 (kNrResidualBins / (2 * residual_range)))
+                                    .floor()
+                                    .max(0)
+                                    .min(kNrResidualBins - 1)
+                                    .cast<int32_t>();
+          for (int32_t i = 0; i < run_end - col; ++i) {
+            // Pixels filled by denoising keep NaN residual and stay out of histogram
+            if (depths[i] > 0) {
+              residuals[row_start + col + i] = span_residuals[i];
+              ++histograms[plane_id * kNrResidualBins + bins[i]];
+            }
+          }
+        } else if (has_unlabelled_residuals && row / cell_size < nr_cell_rows) {
+          for (int32_t i = col; i < run_end && i / cell_size < nr_cell_cols; ++i) {
+            if (span(i - col, 2) <= 0) {
+              continue;
+            }
+            // Closest plane of 4-neighbour cells
+            int32_t cell_row = row / cell_size, cell_col = i / cell_size;
+            int32_t neighbours[4][2] = {{cell_row - 1, cell_col}, {cell_row + 1, cell_col},
+                                        {cell_row, cell_col - 1}, {cell_row, cell_col + 1}};
+            for (auto const& neighbour : neighbours) {
+              if (neighbour[0] < 0 || neighbour[0] >= nr_cell_rows || neighbour[1] < 0 ||
+                  neighbour[1] >= nr_cell_cols || cell_labels(neighbour[0], neighbour[1]) == 0) {
+                continue;
+              }
+              PlaneModel const& plane = planes[plane_by_label[cell_labels(neighbour[0], neighbour[1])]];
+              float distance = plane.normal.dot(span.row(i - col).transpose()) + plane.d;
+              float& residual = residuals[row_start + i];
+              if (std::isnan(residual) || std::abs(distance) < std::abs(residual)) {
+                residual = distance;
+              }
+            }
+          }
+        }
+        col = run_end;
+      }
+    }
+#pragma omp critical
+    for (size_t plane_id = 0; plane_id < planes.size(); ++plane_id) {
+      for (int32_t bin = 0; bin < kNrResidualBins; ++bin) {
+        planes[plane_id].residual_histogram[bin] += histograms[plane_id * kNrResidualBins + bin];
+      }
+    }
+  }
+}
+
+void PlaneExtractor::Impl::denoisePoints(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array,
+                                         Eigen::MatrixXi const& cell_labels, ExtractionResult* result) const {
+  result->points = pcd_array;
+  if (result->planes.empty()) {
+    return;
+  }
+  std::vector<int32_t> plane_by_label(result->planes.back().label + 1, -1);
+  for (size_t plane_id = 0; plane_id < result->planes.size(); ++plane_id) {
+    plane_by_label[result->planes[plane_id].label] = static_cast<int32_t>(plane_id);
+  }
+
+  // Plane of zero-depth pixels of each cell: plane of the cell or of all its 4 neighbours
+  Eigen::MatrixXi fill_labels = cell_labels;
+  if (has_intrinsics_) {
+    for (Eigen::Index row = 1; row < cell_labels.rows() - 1; ++row) {
+      for (Eigen::Index col = 1; col < cell_labels.cols() - 1; ++col) {
+        int32_t label = cell_labels(row - 1, col);
+        if (cell_labels(row, col) == 0 && label != 0 && cell_labels(row + 1, col) == label &&
+            cell_labels(row, col - 1) == label && cell_labels(row, col + 1) == label) {
+          fill_labels(row, col) = label;
+        }
+      }
+    }
+  } else {
+    fill_labels.setZero();
+  }
+
+  Eigen::VectorXi& labels = result->labels;
+  Eigen::MatrixX3f& points = result->points;
+  std::vector<PlaneModel> const& planes = result->planes;
+  int32_t cell_size = config_.patch_size;
+  float fx = intrinsics_(0, 0), fy = intrinsics_(1, 1), cx = intrinsics_(0, 2), cy = intrinsics_(1, 2);
+
+  auto schedule = ParallelPolicy::global().getSchedule(ParallelStage::kDenoise, image_height_, image_width_);
+  ParallelPolicy::StageTimer timer(ParallelStage::kDenoise, schedule, labels.size());
+#pragma omp parallel for default(none) \
+    shared(labels, points, planes, plane_by_label, fill_labels, cell_size, fx, fy, cx, cy, schedule) \
+    num_threads(schedule.nr_threads) schedule(static, schedule.grain_size) if (schedule.nr_threads > 1)
+  for (int32_t row = 0; row < image_height_; ++row) {
+    Eigen::Index row_start = static_cast<Eigen::Index>(row) * image_width_;
+    bool in_cell_rows = row / cell_size < fill_labels.rows();
+    for (int32_t col = 0; col < image_width_;) {
+      int32_t label = labels[row_start + col];
+      int32_t run_end = col + 1;
+      while (run_end < image_width_ && labels[row_start + run_end] == label) {
+        ++run_end;
+      }
+      if (label != 0) {
+        PlaneModel const& plane = planes[plane_by_label[label]];
+        auto span = points.middleRows(row_start + col, run_end - col);
+        // Points on plane along viewing ray: p * (-d / n.dot(p)), valid depth only
+        Eigen::ArrayXf dots = span * plane.normal;
+        Eigen::ArrayXf scales = (dots < 0).select(-plane.d * dots.inverse(), 1.f);
+        span.array().colwise() *= scales;
+      }
+      for (int32_t i = col; i < run_end; ++i) {
+        if (points(row_start + i, 2) > 0 || !in_cell_rows || i / cell_size >= fill_labels.cols()) {
+          continue;
+        }
+        int32_t fill_label = fill_labels(row / cell_size, i / cell_size);
+        if (fill_label == 0 || (label != 0 && label != fill_label)) {
+          continue;
+        }
+        PlaneModel const& plane = planes[plane_by_label[fill_label]];
+        Eigen::Vector3f ray((static_cast<float>(i) - cx) / fx, (static_cast<float>(row) - cy) / fy, 1);
+        float dot = plane.normal.dot(ray);
+        if (dot < 0) {
+          points.row(row_start + i) = ray * (-plane.d / dot);
+          labels[row_start + i] = fill_label;
+        }
+      }
+      col = run_end;
+    }
+  }
+}
+
+void PlaneExtractor::Impl::buildPixelIndex(ExtractionResult* result) {
+  Eigen::VectorXi const& labels = result->labels;
+  std::vector<int32_t> plane_by_label(result->planes.empty() ? 1 : result->planes.back().label + 1, -1);
+  for (size_t plane_id = 0; plane_id < result->planes.size(); ++plane_id) {
+    plane_by_label[result->planes[plane_id].label] = static_cast<int32_t>(plane_id);
+  }
+
+  std::vector<int32_t>& offsets = result->plane_offsets;
+  offsets.assign(result->planes.size() + 1, 0);
+  for (Eigen::Index i = 0; i < labels.size(); ++i) {
+    if (labels[i] != 0) {
+      ++offsets[plane_by_label[labels[i]] + 1];
+    }
+  }
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  result->plane_pixels.resize(offsets.back());
+  std::vector<int32_t> positions(offsets.begin(), offsets.end() - 1);
+  for (Eigen::Index i = 0; i < labels.size(); ++i) {
+    if (labels[i] != 0) {
+      result->plane_pixels[positions[plane_by_label[labels[i]]]++] = static_cast<int32_t>(i);
+    }
+  }
+}
+
+void PlaneExtractor::Impl::refitPlaneModels(Eigen::Ref<const Eigen::MatrixX3f> const& pcd_array,
+                                            ExtractionResult* result) const {
+  for (size_t plane_id = 0; plane_id < result->planes.size(); ++plane_id) {
+    int32_t begin = result->plane_offsets[plane_id];
+    int32_t end = result->plane_offsets[plane_id + 1];
+    // Labeled pixels may have no measurement (zero depth), they would pull the plane towards the camera
+    Eigen::MatrixX3f plane_pcd(end - begin, 3);
+    Eigen::Index nr_valid_points = 0;
+    for (int32_t pixel_id = begin; pixel_id < end; ++pixel_id) {
+      auto point = pcd_array.row(result->plane_pixels[pixel_id]);
+      if (point.z() > 0) {
+        plane_pcd.row(nr_valid_points++) = point;
+      }
+    }
+    plane_pcd.conservativeResize(nr_valid_points, Eigen::NoChange);
+    refitPlane(plane_pcd, config_.robust_loss, config_.robust_refit_iterations, config_.depth_sigma_coeff,
+               config_.depth_sigma_margin, &result->planes[plane_id]);
+  }
+}
+
+void PlaneExtractor::Impl::calibrateParallelism() {
+  // Serial threads don't fork, their OpenMP team would only be created for calibration
+  if (!ParallelPolicy::isForceSerial()) {
+    std::call_once(fork_join_calibrated, [] { ParallelPolicy::global().calibrateForkJoin(); });
+  }
+
+  constexpr int32_t kNrWarmupFrames = 3;
+  // Fronto-parallel plane 1m away from camera
+  Eigen::MatrixX3f points(image_height_ * image_width_, 3);
+  for (Eigen::Index i = 0; i < points.rows(); ++i) {
+    points.row(i) << static_cast<float>(i % image_width_), static_cast<float>(i / image_width_), 1000.f;
+  }
+  // Synthetic frames are not passed to user hooks, settings are restored even if warmup fails
+  struct WarmupScope {
+    Impl* impl;
+    bool has_gravity;
+    bool force_serial;
+    decltype(stage_hooks_) stage_hooks;
+
+    explicit WarmupScope(Impl* impl)
+        : impl(impl), has_gravity(impl->has_gravity_), force_serial(ParallelPolicy::isForceSerial()) {
+      std::swap(stage_hooks, impl->stage_hooks_);
+      impl->has_gravity_ = false;
+      ParallelPolicy::setForceSerial(true);
+    }
+
+    ~WarmupScope() {
+      ParallelPolicy::setForceSerial(force_serial);
+      std::swap(stage_hooks, impl->stage_hooks_);
+      impl->has_gravity_ = has_gravity;
+    }
+  } warmup_scope(this);
+  for (int32_t i = 0; i < kNrWarmupFrames; ++i) {
+    extractPlanes(points);
+  }
+}
+
 #ifdef DEBUG_DEPLEX
 
 template <typename T>
@@ -532,8 +1949,8 @@ void PlaneExtractor::Impl::planarCellsToLabels(std::vector<bool> const& planar_f
 
   for (auto cell_id = 0; cell_id < planar_flags.size(); ++cell_id) {
     if (planar_flags[cell_id]) {
-      auto cell_row = cell_id / nr_horizontal_cells_;
-      auto cell_col = cell_id % nr_horizontal_cells_;
+      auto cell_row = layout_.getRow(cell_id);
+      auto cell_col = layout_.getCol(cell_id);
       // Fill cell with label
       auto label_row = cell_row * cell_height;
       auto label_col = cell_col * cell_width;
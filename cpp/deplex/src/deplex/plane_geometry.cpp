@@ -0,0 +1,234 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "plane_geometry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+#include <Eigen/Eigenvalues>
+#include <Eigen/Geometry>
+
+namespace deplex {
+namespace {
+struct BoundaryEdge {
+  // Label of region
+  int32_t label;
+  // Grid corners, id = y * (nr_cols + 1) + x
+  int32_t start;
+  int32_t end;
+  // Cell inside region
+  int32_t row;
+  int32_t col;
+  bool visited;
+};
+
+/**
+ * Trace boundaries of all labelled cell regions by following boundary edges, region is on the right of walking
+ * direction. Equivalent to marching squares on cell grid. Edges of all regions are collected in one pass over grid.
+ *
+ * @param cell_labels Label of each cell, 0 - no region.
+ * @returns Outer boundaries of each label as sequences of boundary cells (row, col), holes are skipped.
+ */
+std::unordered_map<int32_t, std::vector<std::vector<Eigen::Vector2i>>> traceOuterBoundaries(
+    Eigen::MatrixXi const& cell_labels) {
+  auto nr_rows = static_cast<int32_t>(cell_labels.rows());
+  auto nr_cols = static_cast<int32_t>(cell_labels.cols());
+  auto nr_corners = static_cast<int64_t>(nr_rows + 1) * (nr_cols + 1);
+  auto corner = [nr_cols](int32_t y, int32_t x) { return y * (nr_cols + 1) + x; };
+  // Edges of different regions may start at the same corner
+  auto edgeKey = [nr_corners](int32_t label, int32_t corner_id) { return label * nr_corners + corner_id; };
+  auto isOutside = [&](int32_t row, int32_t col, int32_t label) {
+    return row < 0 || col < 0 || row >= nr_rows || col >= nr_cols || cell_labels(row, col) != label;
+  };
+
+  std::vector<BoundaryEdge> edges;
+  std::unordered_multimap<int64_t, size_t> edges_by_start;
+  for (int32_t row = 0; row < nr_rows; ++row) {
+    for (int32_t col = 0; col < nr_cols; ++col) {
+      int32_t label = cell_labels(row, col);
+      if (label == 0) continue;
+      if (isOutside(row - 1, col, label)) {
+        edges.push_back({label, corner(row, col), corner(row, col + 1), row, col, false});
+      }
+      if (isOutside(row, col + 1, label)) {
+        edges.push_back({label, corner(row, col + 1), corner(row + 1, col + 1), row, col, false});
+      }
+      if (isOutside(row + 1, col, label)) {
+        edges.push_back({label, corner(row + 1, col + 1), corner(row + 1, col), row, col, false});
+      }
+      if (isOutside(row, col - 1, label)) {
+        edges.push_back({label, corner(row + 1, col), corner(row, col), row, col, false});
+      }
+    }
+  }
+  edges_by_start.reserve(edges.size());
+  for (size_t i = 0; i < edges.size(); ++i) {
+    edges_by_start.emplace(edgeKey(edges[i].label, edges[i].start), i);
+  }
+
+  std::unordered_map<int32_t, std::vector<std::vector<Eigen::Vector2i>>> boundaries;
+  for (auto& first_edge : edges) {
+    if (first_edge.visited) continue;
+    std::vector<Eigen::Vector2i> cells;
+    int64_t doubled_area = 0;
+    BoundaryEdge* edge = &first_edge;
+    while (edge != nullptr) {
+      edge->visited = true;
+      Eigen::Vector2i cell(edge->row, edge->col);
+      if (cells.empty() || cells.back() != cell) cells.push_back(cell);
+      int32_t start_y = edge->start / (nr_cols + 1), start_x = edge->start % (nr_cols + 1);
+      int32_t end_y = edge->end / (nr_cols + 1), end_x = edge->end % (nr_cols + 1);
+      doubled_area += static_cast<int64_t>(start_x) * end_y - static_cast<int64_t>(end_x) * start_y;
+
+      edge = nullptr;
+      auto next_edges = edges_by_start.equal_range(edgeKey(first_edge.label, corner(end_y, end_x)));
+      for (auto next = next_edges.first; next != next_edges.second; ++next) {
+        if (!edges[next->second].visited) {
+          edge = &edges[next->second];
+          break;
+        }
+      }
+    }
+    if (cells.size() > 1 && cells.front() == cells.back()) cells.pop_back();
+    // Outer boundaries are clockwise in image (positive area), holes are counter-clockwise
+    if (doubled_area > 0) boundaries[first_edge.label].push_back(std::move(cells));
+  }
+  return boundaries;
+}
+
+/**
+ * Area of cell footprint, assuming points uniformly cover rectangle: side = sqrt(12 * variance).
+ */
+float getCellFootprint(CellSegmentStat const& stat) {
+  Eigen::SelfAdjointEigenSolver<Eigen::Matrix3f> solver;
+  solver.computeDirect(stat.getCovariance(), Eigen::EigenvaluesOnly);
+  Eigen::Vector3f eigenvalues = solver.eigenvalues().cwiseMax(0);
+  return 12 * std::sqrt(eigenvalues[1] * eigenvalues[2]);
+}
+
+// Sine of minimal turn angle of hull vertex, smaller turns are treated as collinear points
+constexpr float kMinTurnSine = 1e-3f;
+
+/**
+ * Check if o -> a -> b turns counter-clockwise by more than rounding noise.
+ */
+bool isLeftTurn(Eigen::Vector2f const& o, Eigen::Vector2f const& a, Eigen::Vector2f const& b) {
+  Eigen::Vector2f oa = a - o, ob = b - o;
+  return oa.x() * ob.y() - oa.y() * ob.x() > kMinTurnSine * oa.norm() * ob.norm();
+}
+
+/**
+ * Andrew's monotone chain.
+ *
+ * @returns Hull vertices in counter-clockwise order.
+ */
+std::vector<Eigen::Vector2f> getConvexHull(std::vector<Eigen::Vector2f> points) {
+  std::sort(points.begin(), points.end(), [](Eigen::Vector2f const& a, Eigen::Vector2f const& b) {
+    return a.x() < b.x() || (a.x() == b.x() && a.y() < b.y());
+  });
+  if (points.size() < 3) return points;
+  std::vector<Eigen::Vector2f> hull(2 * points.size());
+  size_t k = 0;
+  for (size_t i = 0; i < points.size(); ++i) {
+    while (k >= 2 && !isLeftTurn(hull[k - 2], hull[k - 1], points[i])) --k;
+    hull[k++] = points[i];
+  }
+  for (size_t i = points.size() - 1, lower_size = k + 1; i > 0; --i) {
+    while (k >= lower_size && !isLeftTurn(hull[k - 2], hull[k - 1], points[i - 1])) --k;
+    hull[k++] = points[i - 1];
+  }
+  hull.resize(k - 1);
+  return hull;
+}
+}  // namespace
+
+bool isInsideConvexPolygon(Eigen::Matrix2Xf const& polygon, Eigen::Vector2f const& point) {
+  auto nr_vertices = polygon.cols();
+  for (Eigen::Index i = 0; i < nr_vertices; ++i) {
+    Eigen::Vector2f edge = polygon.col((i + 1) % nr_vertices) - polygon.col(i);
+    Eigen::Vector2f to_point = point - polygon.col(i);
+    if (edge.x() * to_point.y() - edge.y() * to_point.x() < 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void computePlaneGeometry(Eigen::MatrixXi const& cell_labels, CellGrid const& cell_grid,
+                          std::vector<CellSegment> const& plane_segments, std::vector<PlaneModel>* planes) {
+  CellLayout const& layout = cell_grid.getLayout();
+  std::unordered_map<int32_t, PlaneModel*> plane_by_label;
+  for (auto& plane : *planes) {
+    plane_by_label[plane.label] = &plane;
+    plane.area = 0;
+  }
+  for (int32_t row = 0; row < cell_labels.rows(); ++row) {
+    for (int32_t col = 0; col < cell_labels.cols(); ++col) {
+      auto plane = plane_by_label.find(cell_labels(row, col));
+      if (plane != plane_by_label.end()) {
+        plane->second->area += getCellFootprint(cell_grid[layout.toIndex(row, col)].getStat());
+      }
+    }
+  }
+
+  auto const boundaries = traceOuterBoundaries(cell_labels);
+  std::vector<std::vector<Eigen::Vector2i>> const no_boundaries;
+  for (auto& plane : *planes) {
+    CellSegmentStat const& stat = plane_segments[plane.label - 1].getStat();
+    // In-plane axes: principal directions of plane points
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3f> solver;
+    solver.computeDirect(stat.getCovariance());
+    Eigen::Vector3f major_axis = solver.eigenvectors().col(2);
+    major_axis = (major_axis - major_axis.dot(plane.normal) * plane.normal).normalized();
+    Eigen::Vector3f minor_axis = plane.normal.cross(major_axis);
+
+    plane.contours.clear();
+    std::vector<Eigen::Vector2f> plane_points;
+    auto plane_boundaries = boundaries.find(plane.label);
+    for (auto const& boundary : (plane_boundaries != boundaries.end() ? plane_boundaries->second : no_boundaries)) {
+      std::vector<Eigen::Vector3f> contour;
+      contour.reserve(boundary.size());
+      for (auto const& cell : boundary) {
+        Eigen::Vector3f point = cell_grid[layout.toIndex(cell.x(), cell.y())].getStat().getMean();
+        point -= (plane.normal.dot(point) + plane.d) * plane.normal;
+        contour.push_back(point);
+        plane_points.emplace_back(major_axis.dot(point - plane.mean), minor_axis.dot(point - plane.mean));
+      }
+      plane.contours.push_back(std::move(contour));
+    }
+
+    plane.convex_hull.clear();
+    Eigen::Vector2f min_coords = Eigen::Vector2f::Constant(std::numeric_limits<float>::max());
+    Eigen::Vector2f max_coords = Eigen::Vector2f::Constant(std::numeric_limits<float>::lowest());
+    for (auto const& hull_point : getConvexHull(plane_points)) {
+      plane.convex_hull.push_back(plane.mean + hull_point.x() * major_axis + hull_point.y() * minor_axis);
+      min_coords = min_coords.cwiseMin(hull_point);
+      max_coords = max_coords.cwiseMax(hull_point);
+    }
+    if (plane.convex_hull.empty()) {
+      min_coords.setZero();
+      max_coords.setZero();
+    }
+
+    Eigen::Vector2f center = (min_coords + max_coords) / 2;
+    plane.box.center = plane.mean + center.x() * major_axis + center.y() * minor_axis;
+    plane.box.axes << major_axis, minor_axis, plane.normal;
+    plane.box.half_extents << (max_coords - min_coords) / 2, std::sqrt(std::max(plane.mse, 0.f));
+  }
+}
+}  // namespace deplex
@@ -0,0 +1,48 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "deplex/extraction_result.h"
+
+#include "cell_grid.h"
+#include "cell_segment.h"
+
+namespace deplex {
+/**
+ * Compute boundary polygons, convex hull, area and oriented bounding box of planes.
+ * Works on cell level: O(cells) instead of O(pixels).
+ *
+ * @param cell_labels Final plane label of each cell [nr_vertical_cells x nr_horizontal_cells], 0 - no plane.
+ * @param cell_grid Cell Grid.
+ * @param plane_segments Merged plane segments, segment label - 1 corresponds to plane label.
+ * @param planes Plane models to fill geometry of.
+ */
+void computePlaneGeometry(Eigen::MatrixXi const& cell_labels, CellGrid const& cell_grid,
+                          std::vector<CellSegment> const& plane_segments, std::vector<PlaneModel>* planes);
+
+/**
+ * Check if point lies inside convex polygon, e.g. projection of point onto plane inside plane's convex hull.
+ *
+ * @param polygon Counter-clockwise vertices [2 x N] in in-plane coordinates.
+ * @param point Point in the same in-plane coordinates.
+ * @returns true if point is inside polygon or on its boundary.
+ */
+bool isInsideConvexPolygon(Eigen::Matrix2Xf const& polygon, Eigen::Vector2f const& point);
+}  // namespace deplex
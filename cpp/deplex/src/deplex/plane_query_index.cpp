@@ -0,0 +1,346 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "deplex/plane_query_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#include <Eigen/Geometry>
+
+#include "plane_geometry.h"
+
+namespace deplex {
+namespace {
+// Maximum number of planes in BVH leaf
+constexpr int32_t kMaxLeafSize = 2;
+// Maximum size of BVH traversal stack: it holds at most one pending node per tree level plus one
+constexpr int32_t kMaxStackSize = 64;
+// Rays almost parallel to plane don't hit it
+constexpr float kMinRayCos = 1e-6f;
+
+/**
+ * Slab test of ray segment against box. Axes the ray is parallel to (infinite inverse direction) don't bound
+ * the ray parameter, instead the origin has to lie within their slabs. This avoids 0 * inf = NaN for origins
+ * on slab planes.
+ *
+ * @param box Axis-aligned box.
+ * @param origin Ray origin.
+ * @param inv_direction Component-wise inverse of ray direction.
+ * @param max_distance Ray parameter of segment end.
+ * @returns true if segment [0, max_distance] of ray intersects box.
+ */
+bool intersectsBox(Eigen::AlignedBox3f const& box, Eigen::Vector3f const& origin, Eigen::Array3f const& inv_direction,
+                   float max_distance) {
+  float t_enter = 0;
+  float t_exit = max_distance;
+  for (int32_t axis = 0; axis < 3; ++axis) {
+    if (std::isinf(inv_direction[axis])) {
+      if (origin[axis] < box.min()[axis] || origin[axis] > box.max()[axis]) {
+        return false;
+      }
+      continue;
+    }
+    float t0 = (box.min()[axis] - origin[axis]) * inv_direction[axis];
+    float t1 = (box.max()[axis] - origin[axis]) * inv_direction[axis];
+    t_enter = std::max(t_enter, std::min(t0, t1));
+    t_exit = std::min(t_exit, std::max(t0, t1));
+  }
+  return t_enter <= t_exit;
+}
+}  // namespace
+
+class PlaneQueryIndex::Impl {
+ public:
+  Impl(ExtractionResult const& result, int32_t image_height, int32_t image_width, Eigen::Matrix3f const& intrinsics);
+
+  RayHit castRay(Eigen::Vector3f const& origin, Eigen::Vector3f const& direction, float max_distance) const;
+
+  int32_t assignPoint(Eigen::Vector3f const& point, float max_distance) const;
+
+  size_t size() const;
+
+ private:
+  /**
+   * Convex plane polygon, vertices are stored in in-plane coordinates.
+   */
+  struct Polygon {
+    int32_t label;
+    Eigen::Vector3f normal;
+    float d;
+    Eigen::Vector3f origin;
+    Eigen::Vector3f u_axis;
+    Eigen::Vector3f v_axis;
+    // Counter-clockwise vertices [2, N]
+    Eigen::Matrix2Xf vertices;
+    Eigen::AlignedBox3f bounds;
+  };
+
+  struct Node {
+    Eigen::AlignedBox3f bounds;
+    // Leaf: first polygon index, inner node: index of right child (left child follows node)
+    int32_t offset;
+    // Number of polygons in leaf, 0 for inner node
+    int32_t nr_polygons;
+  };
+
+  std::vector<Polygon> polygons_;
+  std::vector<Node> nodes_;
+  // Index of polygon by plane label, -1 if plane isn't indexed
+  std::vector<int32_t> polygon_by_label_;
+
+  Eigen::VectorXi labels_;
+  int32_t image_height_;
+  int32_t image_width_;
+  Eigen::Matrix3f intrinsics_;
+
+  /**
+   * Build subtree over polygons [begin, end) with median split along the longest axis of polygon centers.
+   *
+   * @param depth Depth of subtree root, bounded by size of traversal stack.
+   */
+  void buildNode(int32_t begin, int32_t end, int32_t depth = 0);
+
+  /**
+   * Check if point projection lies inside polygon.
+   */
+  static bool containsProjection(Polygon const& polygon, Eigen::Vector3f const& point);
+};
+
+PlaneQueryIndex::Impl::Impl(ExtractionResult const& result, int32_t image_height, int32_t image_width,
+                            Eigen::Matrix3f const& intrinsics)
+    : image_height_(image_height), image_width_(image_width), intrinsics_(intrinsics) {
+  int32_t max_label = 0;
+  for (auto const& plane : result.planes) {
+    if (plane.contours.empty()) {
+      throw std::runtime_error("Error! Plane " + std::to_string(plane.label) +
+                               " has no geometry, set Config::compute_geometry to build query index.");
+    }
+    max_label = std::max(max_label, plane.label);
+    if (plane.convex_hull.size() < 3) {
+      continue;
+    }
+    Polygon polygon;
+    polygon.label = plane.label;
+    polygon.normal = plane.normal;
+    polygon.d = plane.d;
+    polygon.origin = plane.box.center;
+    polygon.u_axis = plane.box.axes.col(0);
+    polygon.v_axis = plane.box.axes.col(1);
+    polygon.vertices.resize(2, static_cast<Eigen::Index>(plane.convex_hull.size()));
+    polygon.bounds.setEmpty();
+    for (size_t i = 0; i < plane.convex_hull.size(); ++i) {
+      Eigen::Vector3f offset = plane.convex_hull[i] - polygon.origin;
+      polygon.vertices.col(i) << polygon.u_axis.dot(offset), polygon.v_axis.dot(offset);
+      polygon.bounds.extend(plane.convex_hull[i]);
+    }
+    // Flat boxes of axis-aligned planes are inflated to keep slab test robust
+    float margin = 1e-4f * polygon.bounds.diagonal().norm() + 1e-6f;
+    polygon.bounds.min().array() -= margin;
+    polygon.bounds.max().array() += margin;
+    polygons_.push_back(std::move(polygon));
+  }
+
+  polygon_by_label_.assign(max_label + 1, -1);
+  if (!polygons_.empty()) {
+    nodes_.reserve(2 * polygons_.size());
+    buildNode(0, static_cast<int32_t>(polygons_.size()));
+  }
+  for (size_t i = 0; i < polygons_.size(); ++i) {
+    polygon_by_label_[polygons_[i].label] = static_cast<int32_t>(i);
+  }
+  if (image_height_ > 0 && image_width_ > 0) {
+    if (result.labels.size() != static_cast<Eigen::Index>(image_height_) * image_width_) {
+      throw std::runtime_error("Error! Labels size " + std::to_string(result.labels.size()) +
+                               " doesn't match image shape.");
+    }
+    labels_ = result.labels;
+  }
+}
+
+void PlaneQueryIndex::Impl::buildNode(int32_t begin, int32_t end, int32_t depth) {
+  // Median split keeps depth logarithmic, so this guards traversal stack against future changes of split
+  if (depth + 1 >= kMaxStackSize) {
+    throw std::runtime_error("Error! Plane query index is deeper than traversal stack: " + std::to_string(depth));
+  }
+  auto node_id = static_cast<int32_t>(nodes_.size());
+  nodes_.push_back({Eigen::AlignedBox3f(), begin, end - begin});
+  Eigen::AlignedBox3f centers;
+  for (int32_t i = begin; i < end; ++i) {
+    nodes_[node_id].bounds.extend(polygons_[i].bounds);
+    centers.extend(polygons_[i].bounds.center());
+  }
+  if (end - begin <= kMaxLeafSize) {
+    return;
+  }
+
+  Eigen::Index axis;
+  centers.sizes().maxCoeff(&axis);
+  int32_t middle = begin + (end - begin) / 2;
+  std::nth_element(polygons_.begin() + begin, polygons_.begin() + middle, polygons_.begin() + end,
+                   [axis](Polygon const& a, Polygon const& b) {
+                     return a.bounds.center()[axis] < b.bounds.center()[axis];
+                   });
+  buildNode(begin, middle, depth + 1);
+  nodes_[node_id].offset = static_cast<int32_t>(nodes_.size());
+  nodes_[node_id].nr_polygons = 0;
+  buildNode(middle, end, depth + 1);
+}
+
+bool PlaneQueryIndex::Impl::containsProjection(Polygon const& polygon, Eigen::Vector3f const& point) {
+  Eigen::Vector3f offset = point - polygon.origin;
+  Eigen::Vector2f projection(polygon.u_axis.dot(offset), polygon.v_axis.dot(offset));
+  return isInsideConvexPolygon(polygon.vertices, projection);
+}
+
+RayHit PlaneQueryIndex::Impl::castRay(Eigen::Vector3f const& origin, Eigen::Vector3f const& direction,
+                                      float max_distance) const {
+  RayHit hit;
+  if (nodes_.empty()) {
+    return hit;
+  }
+  Eigen::Array3f inv_direction = direction.array().inverse();
+  float closest = max_distance;
+
+  int32_t stack[kMaxStackSize];
+  int32_t stack_size = 0;
+  stack[stack_size++] = 0;
+  while (stack_size > 0) {
+    Node const& node = nodes_[stack[--stack_size]];
+    if (!intersectsBox(node.bounds, origin, inv_direction, closest)) {
+      continue;
+    }
+    if (node.nr_polygons == 0) {
+      stack[stack_size++] = node.offset;
+      stack[stack_size++] = static_cast<int32_t>(&node - nodes_.data()) + 1;
+      continue;
+    }
+    for (int32_t i = node.offset; i < node.offset + node.nr_polygons; ++i) {
+      Polygon const& polygon = polygons_[i];
+      float cos = polygon.normal.dot(direction);
+      if (std::abs(cos) < kMinRayCos) {
+        continue;
+      }
+      float t = -(polygon.normal.dot(origin) + polygon.d) / cos;
+      if (t < 0 || t > closest) {
+        continue;
+      }
+      Eigen::Vector3f point = origin + t * direction;
+      if (containsProjection(polygon, point)) {
+        closest = t;
+        hit = {polygon.label, t, point};
+      }
+    }
+  }
+  return hit;
+}
+
+int32_t PlaneQueryIndex::Impl::assignPoint(Eigen::Vector3f const& point, float max_distance) const {
+  // Label lookup: plane of the pixel point projects to
+  if (labels_.size() > 0 && point.z() > 0) {
+    Eigen::Vector3f pixel = intrinsics_ * (point / point.z());
+    auto col = static_cast<int32_t>(std::lround(pixel.x()));
+    auto row = static_cast<int32_t>(std::lround(pixel.y()));
+    if (row >= 0 && row < image_height_ && col >= 0 && col < image_width_) {
+      int32_t label = labels_[row * image_width_ + col];
+      if (label > 0 && label < static_cast<int32_t>(polygon_by_label_.size()) && polygon_by_label_[label] >= 0) {
+        Polygon const& polygon = polygons_[polygon_by_label_[label]];
+        if (std::abs(polygon.normal.dot(point) + polygon.d) <= max_distance) {
+          return label;
+        }
+      }
+    }
+  }
+
+  int32_t label = 0;
+  if (nodes_.empty()) {
+    return label;
+  }
+  float closest = max_distance;
+  int32_t stack[kMaxStackSize];
+  int32_t stack_size = 0;
+  stack[stack_size++] = 0;
+  while (stack_size > 0) {
+    Node const& node = nodes_[stack[--stack_size]];
+    if (node.bounds.exteriorDistance(point) > closest) {
+      continue;
+    }
+    if (node.nr_polygons == 0) {
+      stack[stack_size++] = node.offset;
+      stack[stack_size++] = static_cast<int32_t>(&node - nodes_.data()) + 1;
+      continue;
+    }
+    for (int32_t i = node.offset; i < node.offset + node.nr_polygons; ++i) {
+      Polygon const& polygon = polygons_[i];
+      float distance = std::abs(polygon.normal.dot(point) + polygon.d);
+      if (distance <= closest && containsProjection(polygon, point)) {
+        closest = distance;
+        label = polygon.label;
+      }
+    }
+  }
+  return label;
+}
+
+size_t PlaneQueryIndex::Impl::size() const { return polygons_.size(); }
+
+PlaneQueryIndex::PlaneQueryIndex(ExtractionResult const& result)
+    : impl_(new Impl(result, 0, 0, Eigen::Matrix3f::Identity())) {}
+
+PlaneQueryIndex::PlaneQueryIndex(ExtractionResult const& result, int32_t image_height, int32_t image_width,
+                                 Eigen::Matrix3f const& intrinsics)
+    : impl_(new Impl(result, image_height, image_width, intrinsics)) {}
+
+PlaneQueryIndex::PlaneQueryIndex(PlaneQueryIndex&&) noexcept = default;
+PlaneQueryIndex& PlaneQueryIndex::operator=(PlaneQueryIndex&& op) noexcept = default;
+PlaneQueryIndex::~PlaneQueryIndex() = default;
+
+RayHit PlaneQueryIndex::castRay(Eigen::Vector3f const& origin, Eigen::Vector3f const& direction,
+                                float max_distance) const {
+  return impl_->castRay(origin, direction, max_distance);
+}
+
+std::vector<RayHit> PlaneQueryIndex::castRays(Eigen::Ref<const Eigen::MatrixX3f> const& origins,
+                                              Eigen::Ref<const Eigen::MatrixX3f> const& directions,
+                                              float max_distance) const {
+  if (origins.rows() != directions.rows()) {
+    throw std::runtime_error("Error! Number of ray origins " + std::to_string(origins.rows()) +
+                             " doesn't match number of directions " + std::to_string(directions.rows()));
+  }
+  std::vector<RayHit> hits(origins.rows());
+  for (Eigen::Index i = 0; i < origins.rows(); ++i) {
+    hits[i] = impl_->castRay(origins.row(i).transpose(), directions.row(i).transpose(), max_distance);
+  }
+  return hits;
+}
+
+int32_t PlaneQueryIndex::assignPoint(Eigen::Vector3f const& point, float max_distance) const {
+  return impl_->assignPoint(point, max_distance);
+}
+
+Eigen::VectorXi PlaneQueryIndex::assignPoints(Eigen::Ref<const Eigen::MatrixX3f> const& points,
+                                              float max_distance) const {
+  Eigen::VectorXi labels(points.rows());
+  for (Eigen::Index i = 0; i < points.rows(); ++i) {
+    labels[i] = impl_->assignPoint(points.row(i).transpose(), max_distance);
+  }
+  return labels;
+}
+
+size_t PlaneQueryIndex::size() const { return impl_->size(); }
+}  // namespace deplex
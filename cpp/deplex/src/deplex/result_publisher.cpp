@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "deplex/result_publisher.h"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace deplex {
+ResultPublisher::Snapshot::Snapshot(Snapshot&& op) noexcept : slot_(op.slot_) { op.slot_ = nullptr; }
+
+ResultPublisher::Snapshot& ResultPublisher::Snapshot::operator=(Snapshot&& op) noexcept {
+  if (this != &op) {
+    if (slot_ != nullptr) {
+      slot_->nr_readers.fetch_sub(1);
+    }
+    slot_ = op.slot_;
+    op.slot_ = nullptr;
+  }
+  return *this;
+}
+
+ResultPublisher::Snapshot::~Snapshot() {
+  if (slot_ != nullptr) {
+    slot_->nr_readers.fetch_sub(1);
+  }
+}
+
+ResultPublisher::ResultPublisher(int32_t max_snapshots) : latest_(-1), nr_published_(0) {
+  if (max_snapshots < 1) {
+    throw std::runtime_error("Error! Maximum number of snapshots has to be positive: " +
+                             std::to_string(max_snapshots));
+  }
+  // Latest result and result being written are never pinned by the producer
+  nr_slots_ = max_snapshots + 2;
+  slots_.reset(new Slot[nr_slots_]);
+}
+
+bool ResultPublisher::publish(ExtractionResult result, std::vector<double> stage_timings) {
+  int32_t latest = latest_.load();
+  for (int32_t slot_id = 0; slot_id < nr_slots_; ++slot_id) {
+    Slot& slot = slots_[slot_id];
+    // Reader pinning free slot after this check sees it is not the latest one and unpins it without reading
+    if (slot_id == latest || slot.nr_readers.load() != 0) {
+      continue;
+    }
+    slot.published.result = std::move(result);
+    slot.published.stage_timings = std::move(stage_timings);
+    slot.published.sequence_number = nr_published_.load() + 1;
+    latest_.store(slot_id);
+    nr_published_.fetch_add(1);
+    return true;
+  }
+  return false;
+}
+
+ResultPublisher::Snapshot ResultPublisher::getLatest() const {
+  while (true) {
+    int32_t latest = latest_.load();
+    if (latest < 0) {
+      return Snapshot();
+    }
+    Slot& slot = slots_[latest];
+    slot.nr_readers.fetch_add(1);
+    // Slot may have been reused by producer before it was pinned
+    if (latest_.load() == latest) {
+      return Snapshot(&slot);
+    }
+    slot.nr_readers.fetch_sub(1);
+  }
+}
+
+uint64_t ResultPublisher::getNrPublished() const { return nr_published_.load(); }
+}  // namespace deplex
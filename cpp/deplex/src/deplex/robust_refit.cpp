@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "robust_refit.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "cell_segment_stat.h"
+
+extern "C" {
+#include <dsyevh3.h>
+}
+
+namespace deplex {
+namespace {
+// Tuning constants giving 95% efficiency on Gaussian noise
+constexpr float kHuberThreshold = 1.345f;
+constexpr float kTukeyThreshold = 4.685f;
+
+/**
+ * Weights of scaled residuals.
+ */
+Eigen::ArrayXf getWeights(Eigen::ArrayXf const& scaled_residuals, config::RobustLoss loss) {
+  Eigen::ArrayXf abs_residuals = scaled_residuals.abs();
+  if (loss == config::RobustLoss::kHuber) {
+    return (kHuberThreshold / abs_residuals.max(kHuberThreshold)).eval();
+  }
+  Eigen::ArrayXf ratios = (abs_residuals / kTukeyThreshold).min(1);
+  return (1 - ratios.square()).square();
+}
+}  // namespace
+
+void refitPlane(Eigen::MatrixX3f const& points, config::RobustLoss loss, int32_t nr_iterations,
+                float depth_sigma_coeff, float depth_sigma_margin, PlaneModel* plane) {
+  if (loss == config::RobustLoss::kNone || points.rows() < 3) {
+    return;
+  }
+  // Points are centered at initial mean to keep float moments precise
+  Eigen::RowVector3f origin = points.colwise().mean();
+  Eigen::MatrixX3f centered = points.rowwise() - origin;
+  Eigen::ArrayXf inv_sigmas =
+      (depth_sigma_coeff * points.col(2).array().square() + depth_sigma_margin).max(1e-6f).inverse();
+
+  Eigen::Vector3f normal = plane->normal;
+  float offset = plane->d + normal.dot(origin.transpose());
+  Eigen::ArrayXf weights;
+  Eigen::Vector3f mean;
+  float weight_sum = 0;
+  for (int32_t iteration = 0; iteration < nr_iterations; ++iteration) {
+    Eigen::ArrayXf residuals = (centered * normal).array() + offset;
+    Eigen::ArrayXf new_weights = getWeights(residuals * inv_sigmas, loss);
+    float new_weight_sum = new_weights.sum();
+    if (new_weight_sum <= 0) {
+      break;
+    }
+    weights.swap(new_weights);
+    weight_sum = new_weight_sum;
+    mean = centered.transpose() * weights.matrix() / weight_sum;
+    Eigen::Matrix3f cov = centered.transpose() * (centered.array().colwise() * weights).matrix() / weight_sum -
+                          mean * mean.transpose();
+
+    double tmp_cov[3][3];
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        tmp_cov[i][j] = cov(i, j);
+      }
+    }
+    double eigenvectors[3][3];
+    double eigenvalues[3];
+    dsyevh3(tmp_cov, eigenvectors, eigenvalues);
+    Eigen::Index min_es_ind = std::distance(eigenvalues, std::min_element(eigenvalues, eigenvalues + 3));
+    for (int i = 0; i < 3; ++i) {
+      normal[i] = static_cast<float>(eigenvectors[i][min_es_ind]);
+    }
+    offset = -mean.dot(normal);
+    float noise_variance =
+        getNoiseVariance(normal.dot(cov * normal), origin.z() + mean.z(), depth_sigma_coeff, depth_sigma_margin);
+    plane->covariance = getPlaneCovariance(cov, mean + origin.transpose(), weight_sum, noise_variance);
+  }
+  if (weight_sum <= 0) {
+    return;
+  }
+
+  float d = offset - normal.dot(origin.transpose());
+  // Statistics use the weights of the final fit, so points rejected by the loss don't count
+  plane->mean = mean + origin.transpose();
+  plane->nr_points = static_cast<int32_t>((weights > 0).count());
+  // Enforce normal orientation
+  plane->normal = (d > 0 ? normal : -normal);
+  plane->d = std::abs(d);
+  plane->mse = (weights * ((centered * normal).array() + offset).square()).sum() / weight_sum;
+}
+}  // namespace deplex
@@ -0,0 +1,41 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <Eigen/Core>
+
+#include "deplex/config.h"
+#include "deplex/extraction_result.h"
+
+namespace deplex {
+/**
+ * Refit plane to points by iteratively reweighted PCA.
+ *
+ * Each iteration accumulates weighted sufficient statistics (weight sum, weighted first and second moments)
+ * and takes normal as eigenvector of the smallest eigenvalue of weighted covariance. Weights come from
+ * robust loss of residual scaled by depth noise sigma of the point: sigma = coeff * z^2 + margin.
+ *
+ * @param points Plane points [N, 3].
+ * @param loss Robust loss.
+ * @param nr_iterations Number of reweighting iterations.
+ * @param depth_sigma_coeff Quadratic coefficient of depth noise.
+ * @param depth_sigma_margin Constant term of depth noise.
+ * @param plane Plane model, initial normal and d on input. Normal, d, covariance, mean, number of points and MSE
+ * are refitted: mean and MSE are weighted by the final weights, points with zero weight are not counted.
+ */
+void refitPlane(Eigen::MatrixX3f const& points, config::RobustLoss loss, int32_t nr_iterations,
+                float depth_sigma_coeff, float depth_sigma_margin, PlaneModel* plane);
+}  // namespace deplex
@@ -0,0 +1,281 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "thread_placement.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace deplex {
+namespace {
+#ifdef __linux__
+struct ThreadState {
+  cpu_set_t cpu_set;
+  int policy;
+  sched_param param;
+};
+
+// Placement of calling thread before ScopedThreadPlacement
+thread_local bool has_saved_state = false;
+thread_local ThreadState saved_state;
+#endif
+
+// CPUs of OpenMP team of the thread, pinned by ScopedThreadPlacement. Team threads are kept alive by runtime,
+// so they are pinned once instead of opening one more parallel region on every frame
+thread_local bool has_team_placement = false;
+thread_local std::vector<int32_t> team_cpus;
+#ifdef __linux__
+// Affinity of the team before it was pinned, brought back by the first placement without CPUs
+thread_local cpu_set_t team_initial_cpu_set;
+#endif
+
+int32_t parseCpuId(std::string const& cpu_list, std::string const& token) {
+  if (token.empty() || token.find_first_not_of("0123456789") != std::string::npos) {
+    throw std::runtime_error("Error! Invalid CPU list: \"" + cpu_list + "\".");
+  }
+  return std::stoi(token);
+}
+
+/**
+ * Place calling thread.
+ *
+ * @returns Error description, empty on success.
+ */
+std::string placeCurrentThread(std::vector<int32_t> const& cpus, int32_t realtime_priority) {
+#ifdef __linux__
+  if (!cpus.empty()) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int32_t cpu : cpus) {
+      if (cpu >= CPU_SETSIZE) {
+        return "CPU id " + std::to_string(cpu) + " exceeds " + std::to_string(CPU_SETSIZE);
+      }
+      CPU_SET(cpu, &cpu_set);
+    }
+    if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+      return std::string("couldn't set CPU affinity: ") + std::strerror(errno);
+    }
+  }
+  if (realtime_priority > 0) {
+    sched_param param{};
+    param.sched_priority = realtime_priority;
+    int status = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (status != 0) {
+      return std::string("couldn't set real-time priority: ") + std::strerror(status);
+    }
+  }
+  return "";
+#else
+  return "thread placement is supported on Linux only";
+#endif
+}
+
+/**
+ * Save affinity and scheduling policy of calling thread, so that restoreCurrentThread brings them back.
+ */
+void saveCurrentThread() {
+#ifdef __linux__
+  CPU_ZERO(&saved_state.cpu_set);
+  has_saved_state = sched_getaffinity(0, sizeof(saved_state.cpu_set), &saved_state.cpu_set) == 0 &&
+                    pthread_getschedparam(pthread_self(), &saved_state.policy, &saved_state.param) == 0;
+#endif
+}
+
+/**
+ * Restore placement saved by saveCurrentThread, if any.
+ */
+void restoreCurrentThread() {
+#ifdef __linux__
+  if (has_saved_state) {
+    // Destructor can't report errors, the thread then keeps running with the current placement
+    sched_setaffinity(0, sizeof(saved_state.cpu_set), &saved_state.cpu_set);
+    pthread_setschedparam(pthread_self(), saved_state.policy, &saved_state.param);
+    has_saved_state = false;
+  }
+#endif
+}
+
+/**
+ * Run function on each thread of calling thread's OpenMP team except the calling thread itself.
+ * Worker threads of the team are kept alive by runtime, so their placement persists between parallel regions.
+ */
+template <typename Function>
+void forEachTeamThread(Function const& function) {
+#ifdef _OPENMP
+#pragma omp parallel num_threads(omp_get_max_threads()) default(none) shared(function)
+  {
+    if (omp_get_thread_num() != 0) {
+      function();
+    }
+  }
+#else
+  static_cast<void>(function);
+#endif
+}
+
+/**
+ * Place OpenMP team of calling thread, except the calling thread itself.
+ *
+ * @returns Error description of any thread, empty on success.
+ */
+std::string placeTeam(std::vector<int32_t> const& cpus, int32_t realtime_priority) {
+  std::string error;
+  forEachTeamThread([&] {
+    std::string thread_error = placeCurrentThread(cpus, realtime_priority);
+#ifdef _OPENMP
+#pragma omp critical(deplex_thread_placement)
+#endif
+    if (!thread_error.empty()) error = thread_error;
+  });
+  return error;
+}
+
+/**
+ * Bring OpenMP team of calling thread back to its affinity before pinTeam, if it is pinned.
+ */
+void unpinTeam() {
+  if (!has_team_placement) {
+    return;
+  }
+#ifdef __linux__
+  // Errors can't be reported from destructor path, team then keeps running with the current affinity
+  forEachTeamThread([] { sched_setaffinity(0, sizeof(team_initial_cpu_set), &team_initial_cpu_set); });
+#endif
+  has_team_placement = false;
+  team_cpus.clear();
+}
+
+/**
+ * Pin OpenMP team of calling thread to given CPUs, unless it is pinned to them already.
+ * Empty CPU list unpins the team.
+ *
+ * @returns Error description of any thread, empty on success.
+ */
+std::string pinTeam(std::vector<int32_t> const& cpus) {
+  if (cpus.empty()) {
+    unpinTeam();
+    return "";
+  }
+  if (has_team_placement && team_cpus == cpus) {
+    return "";
+  }
+#ifdef __linux__
+  // Team threads are created with affinity of the calling thread, which isn't pinned yet
+  if (!has_team_placement && sched_getaffinity(0, sizeof(team_initial_cpu_set), &team_initial_cpu_set) != 0) {
+    return std::string("couldn't get CPU affinity: ") + std::strerror(errno);
+  }
+#endif
+  has_team_placement = true;
+  std::string error = placeTeam(cpus, 0);
+  // Part of the team may be pinned after an error, so the next placement pins it again
+  team_cpus = (error.empty() ? cpus : std::vector<int32_t>());
+  return error;
+}
+
+/**
+ * Switch OpenMP team of calling thread back to default scheduling policy.
+ */
+void resetTeamScheduling() {
+#ifdef __linux__
+  forEachTeamThread([] {
+    sched_param param{};
+    pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+  });
+#endif
+}
+}  // namespace
+
+std::vector<int32_t> parseCpuList(std::string const& cpu_list) {
+  std::vector<int32_t> cpus;
+  size_t begin = 0;
+  while (begin < cpu_list.size()) {
+    size_t end = std::min(cpu_list.find(',', begin), cpu_list.size());
+    std::string token = cpu_list.substr(begin, end - begin);
+    size_t dash_pos = token.find('-');
+    int32_t first = parseCpuId(cpu_list, token.substr(0, dash_pos));
+    int32_t last = (dash_pos == std::string::npos ? first : parseCpuId(cpu_list, token.substr(dash_pos + 1)));
+    if (last < first) {
+      throw std::runtime_error("Error! Invalid CPU list: \"" + cpu_list + "\".");
+    }
+    for (int32_t cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+    begin = end + 1;
+  }
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return cpus;
+}
+
+void applyThreadPlacement(std::vector<int32_t> const& cpus, int32_t realtime_priority) {
+  if (cpus.empty() && realtime_priority == 0) {
+    return;
+  }
+  std::string error = placeCurrentThread(cpus, realtime_priority);
+  std::string team_error = placeTeam(cpus, realtime_priority);
+  if (!error.empty() || !team_error.empty()) {
+    throw std::runtime_error("Error! Thread placement failed: " + (error.empty() ? team_error : error) + ".");
+  }
+}
+
+ScopedThreadPlacement::ScopedThreadPlacement(std::vector<int32_t> const& cpus, int32_t realtime_priority)
+    : placed_(false), team_realtime_(false) {
+#ifdef __linux__
+  if (has_saved_state) {
+    return;
+  }
+#endif
+  if (cpus.empty() && realtime_priority == 0) {
+    // Team pinned by an earlier placement of this thread must not keep its CPUs
+    unpinTeam();
+    return;
+  }
+  saveCurrentThread();
+  std::string error = pinTeam(cpus);
+  if (error.empty() && realtime_priority > 0) {
+    team_realtime_ = true;
+    error = placeTeam({}, realtime_priority);
+  }
+  if (error.empty()) {
+    error = placeCurrentThread(cpus, realtime_priority);
+  }
+  if (!error.empty()) {
+    if (team_realtime_) {
+      resetTeamScheduling();
+    }
+    restoreCurrentThread();
+    throw std::runtime_error("Error! Thread placement failed: " + error + ".");
+  }
+  placed_ = true;
+}
+
+ScopedThreadPlacement::~ScopedThreadPlacement() {
+  if (team_realtime_) {
+    resetTeamScheduling();
+  }
+  if (placed_) {
+    restoreCurrentThread();
+  }
+}
+}  // namespace deplex
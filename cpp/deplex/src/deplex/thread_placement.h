@@ -0,0 +1,64 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace deplex {
+/**
+ * Parse CPU list in Linux cpuset format, e.g. "0-3,8,10-11".
+ *
+ * @param cpu_list Comma separated CPU ids and inclusive ranges.
+ * @returns Sorted unique CPU ids, empty for empty list.
+ */
+std::vector<int32_t> parseCpuList(std::string const& cpu_list);
+
+/**
+ * Pin calling thread and its OpenMP team to given CPUs and switch them to real-time scheduling for good.
+ * Meant for threads owned by the library, e.g. worker threads of asynchronous processing.
+ *
+ * @param cpus CPU ids, empty keeps current affinity.
+ * @param realtime_priority SCHED_FIFO priority, 0 keeps current scheduling policy.
+ */
+void applyThreadPlacement(std::vector<int32_t> const& cpus, int32_t realtime_priority);
+
+/**
+ * Placement of calling thread (see applyThreadPlacement) for the lifetime of the object, so that threads
+ * of library user are pinned only while they process frames. Destructor restores affinity and scheduling policy
+ * the thread had before. Real-time priority of OpenMP team of the thread is set and reset by every object.
+ * Team CPUs are pinned by the first object and kept until different CPUs are requested, so that frames
+ * without real-time priority don't pay for extra parallel regions. Placement without CPUs and priority unpins
+ * the team. Nested placement on the same thread is no-op.
+ */
+class ScopedThreadPlacement {
+ public:
+  /**
+   * @param cpus CPU ids, empty keeps current affinity.
+   * @param realtime_priority SCHED_FIFO priority, 0 keeps current scheduling policy.
+   */
+  ScopedThreadPlacement(std::vector<int32_t> const& cpus, int32_t realtime_priority);
+  ~ScopedThreadPlacement();
+
+  ScopedThreadPlacement(ScopedThreadPlacement const&) = delete;
+  ScopedThreadPlacement& operator=(ScopedThreadPlacement const&) = delete;
+
+ private:
+  bool placed_;
+  bool team_realtime_;
+};
+}  // namespace deplex
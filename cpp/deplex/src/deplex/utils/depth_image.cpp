@@ -23,6 +23,8 @@
 #define STBI_NO_FAILURE_STRINGS
 #include "stb_image/stb_image.h"
 
+#include "../parallel_policy.h"
+
 namespace deplex {
 namespace utils {
 DepthImage::DepthImage() : image_(nullptr), width_(0), height_(0) {}
@@ -63,7 +65,9 @@ Eigen::MatrixX3f DepthImage::toPointCloud(Eigen::Matrix3f const& intrinsics) con
   typedef std::remove_reference<decltype(*image_)>::type t_image;
   pcd_points.col(2) = Eigen::Map<Eigen::Vector<t_image, Eigen::Dynamic>>(image_.get(), width_ * height_).cast<float>();
 
-#pragma omp parallel default(none) shared(pcd_points, column_indices_, row_indices_, cx, cy, fx, fy)
+  // Team of two threads for two sections, none on threads running extraction serially
+#pragma omp parallel default(none) shared(pcd_points, column_indices_, row_indices_, cx, cy, fx, fy) num_threads(2) \
+    if (!ParallelPolicy::isForceSerial())
   {
 #pragma omp sections
     {
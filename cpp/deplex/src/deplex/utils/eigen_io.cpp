@@ -15,11 +15,17 @@
  */
 #include "deplex/utils/eigen_io.h"
 
+#include <cstring>
 #include <fstream>
 #include <vector>
 
 namespace deplex {
 namespace utils {
+namespace {
+constexpr char kLabelsSignature[] = "DPLXLBL1";
+constexpr size_t kLabelsSignatureSize = sizeof(kLabelsSignature) - 1;
+}  // namespace
+
 Eigen::MatrixXf readPointCloudCSV(std::string const& path, char delimiter) {
   std::vector<float> points;
 
@@ -58,5 +64,66 @@ void savePointCloudCSV(Eigen::MatrixXf const& pcd_points, std::string const& pat
   std::ofstream file(path);
   file << pcd_points.format(CSVFormat);
 }
+
+void saveLabelsBinary(Eigen::VectorXi const& labels, int32_t image_height, int32_t image_width,
+                      std::string const& path) {
+  if (labels.size() != static_cast<Eigen::Index>(image_height) * image_width) {
+    throw std::runtime_error("Error! Number of labels doesn't match image shape: " + std::to_string(labels.size()) +
+                             " != " + std::to_string(image_height) + " x " + std::to_string(image_width));
+  }
+  std::ofstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Error: Couldn't open labels file " + path);
+  }
+  file.write(kLabelsSignature, kLabelsSignatureSize);
+  file.write(reinterpret_cast<char const*>(&image_height), sizeof(image_height));
+  file.write(reinterpret_cast<char const*>(&image_width), sizeof(image_width));
+  file.write(reinterpret_cast<char const*>(labels.data()), labels.size() * sizeof(int32_t));
+  if (!file) {
+    throw std::runtime_error("Error: Couldn't write labels file " + path);
+  }
+}
+
+Eigen::VectorXi readLabelsBinary(std::string const& path, int32_t* image_height, int32_t* image_width) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Error: Couldn't open labels file " + path);
+  }
+  char signature[kLabelsSignatureSize];
+  int32_t height = 0, width = 0;
+  file.read(signature, kLabelsSignatureSize);
+  file.read(reinterpret_cast<char*>(&height), sizeof(height));
+  file.read(reinterpret_cast<char*>(&width), sizeof(width));
+  if (!file || std::memcmp(signature, kLabelsSignature, kLabelsSignatureSize) != 0 || height < 0 || width < 0) {
+    throw std::runtime_error("Error reading file: Invalid labels file " + path);
+  }
+  Eigen::VectorXi labels(static_cast<Eigen::Index>(height) * width);
+  file.read(reinterpret_cast<char*>(labels.data()), labels.size() * sizeof(int32_t));
+  if (!file) {
+    throw std::runtime_error("Error reading file: Truncated labels file " + path);
+  }
+  if (image_height != nullptr) *image_height = height;
+  if (image_width != nullptr) *image_width = width;
+  return labels;
+}
+
+bool isLabelsBinaryComplete(std::string const& path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file.is_open()) {
+    return false;
+  }
+  auto file_size = static_cast<uint64_t>(file.tellg());
+  file.seekg(0);
+  char signature[kLabelsSignatureSize];
+  int32_t height = 0, width = 0;
+  file.read(signature, kLabelsSignatureSize);
+  file.read(reinterpret_cast<char*>(&height), sizeof(height));
+  file.read(reinterpret_cast<char*>(&width), sizeof(width));
+  if (!file || std::memcmp(signature, kLabelsSignature, kLabelsSignatureSize) != 0 || height < 0 || width < 0) {
+    return false;
+  }
+  uint64_t labels_size = static_cast<uint64_t>(height) * static_cast<uint64_t>(width) * sizeof(int32_t);
+  return file_size == kLabelsSignatureSize + 2 * sizeof(int32_t) + labels_size;
+}
 }  // namespace utils
 }  // namespace deplex
\ No newline at end of file
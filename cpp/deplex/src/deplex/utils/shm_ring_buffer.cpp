@@ -0,0 +1,380 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "deplex/utils/shm_ring_buffer.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+              "Shared memory ring requires address-free lock-free atomics");
+
+namespace deplex {
+namespace utils {
+namespace {
+constexpr uint64_t kRingMagic = 0x58454c504544524eULL;  // "NRDEPLEX"
+constexpr uint32_t kRingVersion = 1;
+constexpr size_t kCacheLineSize = 64;
+
+// Polling of empty or full ring yields first, then sleeps with doubling period up to the limit
+constexpr int32_t kNrBackoffYields = 64;
+constexpr int64_t kMaxBackoffUs = 1000;
+
+size_t alignToCacheLine(size_t size) { return (size + kCacheLineSize - 1) / kCacheLineSize * kCacheLineSize; }
+
+/**
+ * Waiting strategy of ring polling, so that idle loop doesn't occupy a CPU.
+ */
+class Backoff {
+ public:
+  void wait() {
+    if (nr_yields_ < kNrBackoffYields) {
+      ++nr_yields_;
+      std::this_thread::yield();
+      return;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(delay_us_));
+    delay_us_ = std::min(delay_us_ * 2, kMaxBackoffUs);
+  }
+
+ private:
+  int32_t nr_yields_ = 0;
+  int64_t delay_us_ = 1;
+};
+
+/**
+ * Returns slot of the frame being read to producer on scope exit, also if frame processing throws.
+ */
+class ReadSlotGuard {
+ public:
+  explicit ReadSlotGuard(ShmRingBuffer* ring) : ring_(ring) {}
+
+  ~ReadSlotGuard() { ring_->releaseRead(); }
+
+  ReadSlotGuard(ReadSlotGuard const&) = delete;
+  ReadSlotGuard& operator=(ReadSlotGuard const&) = delete;
+
+ private:
+  ShmRingBuffer* ring_;
+};
+
+size_t getPointSize(FrameFormat format) {
+  switch (format) {
+    case FrameFormat::kDepthU16:
+      return sizeof(uint16_t);
+    case FrameFormat::kPointsF32:
+      return 3 * sizeof(float);
+    default:
+      throw std::runtime_error("Error! Unsupported frame format: " + std::to_string(static_cast<uint32_t>(format)));
+  }
+}
+
+/**
+ * Check that frame header describes payload lying within its ring slot.
+ *
+ * @param header Header of input frame, written by another process.
+ * @param slot_capacity Slot capacity of input ring, unit: bytes.
+ */
+void validateFrame(FrameHeader const& header, size_t slot_capacity) {
+  if (header.height <= 0 || header.width <= 0) {
+    throw std::runtime_error("Error! Invalid frame shape: " + std::to_string(header.height) + " x " +
+                             std::to_string(header.width));
+  }
+  size_t point_size = getPointSize(header.format);
+  auto nr_points = static_cast<uint64_t>(header.height) * static_cast<uint64_t>(header.width);
+  if (header.payload_size > slot_capacity || nr_points > header.payload_size / point_size) {
+    throw std::runtime_error("Error! Frame of " + std::to_string(nr_points) + " points doesn't fit its payload (" +
+                             std::to_string(header.payload_size) + " bytes) and ring slot capacity (" +
+                             std::to_string(slot_capacity) + " bytes).");
+  }
+}
+}  // namespace
+
+struct ShmRingBuffer::ControlBlock {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t nr_slots;
+  uint64_t slot_capacity;
+  uint64_t slot_stride;
+  // Number of frames ever published, written by producer only
+  alignas(kCacheLineSize) std::atomic<uint64_t> head;
+  // Number of frames ever released, written by consumer only
+  alignas(kCacheLineSize) std::atomic<uint64_t> tail;
+  alignas(kCacheLineSize) std::atomic<uint32_t> closed;
+};
+
+ShmRingBuffer::ShmRingBuffer(std::string name, void* mapping, size_t mapping_size, bool owner)
+    : name_(std::move(name)),
+      mapping_(mapping),
+      mapping_size_(mapping_size),
+      owner_(owner),
+      control_(static_cast<ControlBlock*>(mapping)),
+      slots_(static_cast<unsigned char*>(mapping) + alignToCacheLine(sizeof(ControlBlock))),
+      nr_slots_(control_->nr_slots),
+      slot_capacity_(control_->slot_capacity),
+      slot_stride_(control_->slot_stride) {}
+
+ShmRingBuffer ShmRingBuffer::create(std::string const& name, uint32_t nr_slots, size_t slot_capacity,
+                                    bool replace_existing) {
+  if (nr_slots == 0) {
+    throw std::runtime_error("Error! Shared memory ring " + name + " has to contain at least one slot.");
+  }
+  size_t slot_stride = alignToCacheLine(sizeof(FrameHeader) + slot_capacity);
+  size_t mapping_size = alignToCacheLine(sizeof(ControlBlock)) + slot_stride * nr_slots;
+
+  if (replace_existing) {
+    shm_unlink(name.c_str());
+  }
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0 && errno == EEXIST) {
+    throw std::runtime_error("Error! Shared memory object " + name +
+                             " already exists, another producer may use it. Stale ring has to be replaced explicitly.");
+  }
+  if (fd < 0) {
+    throw std::runtime_error("Error! Couldn't create shared memory object " + name + ": " + std::strerror(errno));
+  }
+  if (ftruncate(fd, static_cast<off_t>(mapping_size)) != 0) {
+    ::close(fd);
+    shm_unlink(name.c_str());
+    throw std::runtime_error("Error! Couldn't resize shared memory object " + name + ": " + std::strerror(errno));
+  }
+  void* mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    shm_unlink(name.c_str());
+    throw std::runtime_error("Error! Couldn't map shared memory object " + name + ": " + std::strerror(errno));
+  }
+
+  auto control = new (mapping) ControlBlock();
+  control->version = kRingVersion;
+  control->nr_slots = nr_slots;
+  control->slot_capacity = slot_capacity;
+  control->slot_stride = slot_stride;
+  control->head.store(0, std::memory_order_relaxed);
+  control->tail.store(0, std::memory_order_relaxed);
+  control->closed.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  control->magic = kRingMagic;
+
+  return ShmRingBuffer(name, mapping, mapping_size, true);
+}
+
+ShmRingBuffer ShmRingBuffer::open(std::string const& name) {
+  int fd = shm_open(name.c_str(), O_RDWR, 0600);
+  if (fd < 0) {
+    throw std::runtime_error("Error! Couldn't open shared memory object " + name + ": " + std::strerror(errno));
+  }
+  struct stat shm_stat {};
+  if (fstat(fd, &shm_stat) != 0 || static_cast<size_t>(shm_stat.st_size) < sizeof(ControlBlock)) {
+    ::close(fd);
+    throw std::runtime_error("Error! Shared memory object " + name + " is not a frame ring.");
+  }
+  auto mapping_size = static_cast<size_t>(shm_stat.st_size);
+  void* mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    throw std::runtime_error("Error! Couldn't map shared memory object " + name + ": " + std::strerror(errno));
+  }
+
+  // Geometry is validated against mapping size once and copied, other process can't make slots exceed mapping later
+  auto control = static_cast<ControlBlock*>(mapping);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  size_t slots_size = mapping_size - std::min(mapping_size, alignToCacheLine(sizeof(ControlBlock)));
+  if (control->magic != kRingMagic || control->version != kRingVersion || control->nr_slots == 0 ||
+      control->slot_capacity > slots_size ||
+      control->slot_stride < alignToCacheLine(sizeof(FrameHeader) + control->slot_capacity) ||
+      control->nr_slots > slots_size / control->slot_stride) {
+    munmap(mapping, mapping_size);
+    throw std::runtime_error("Error! Shared memory object " + name + " is not a frame ring.");
+  }
+
+  return ShmRingBuffer(name, mapping, mapping_size, false);
+}
+
+ShmRingBuffer::~ShmRingBuffer() {
+  if (mapping_ != nullptr) {
+    munmap(mapping_, mapping_size_);
+    if (owner_) {
+      shm_unlink(name_.c_str());
+    }
+  }
+}
+
+ShmRingBuffer::ShmRingBuffer(ShmRingBuffer&& op) noexcept
+    : name_(std::move(op.name_)),
+      mapping_(op.mapping_),
+      mapping_size_(op.mapping_size_),
+      owner_(op.owner_),
+      control_(op.control_),
+      slots_(op.slots_),
+      nr_slots_(op.nr_slots_),
+      slot_capacity_(op.slot_capacity_),
+      slot_stride_(op.slot_stride_) {
+  op.mapping_ = nullptr;
+  op.control_ = nullptr;
+  op.slots_ = nullptr;
+}
+
+ShmRingBuffer& ShmRingBuffer::operator=(ShmRingBuffer&& op) noexcept {
+  std::swap(name_, op.name_);
+  std::swap(mapping_, op.mapping_);
+  std::swap(mapping_size_, op.mapping_size_);
+  std::swap(owner_, op.owner_);
+  std::swap(control_, op.control_);
+  std::swap(slots_, op.slots_);
+  std::swap(nr_slots_, op.nr_slots_);
+  std::swap(slot_capacity_, op.slot_capacity_);
+  std::swap(slot_stride_, op.slot_stride_);
+  return *this;
+}
+
+void* ShmRingBuffer::tryAcquireWrite() {
+  uint64_t head = control_->head.load(std::memory_order_relaxed);
+  uint64_t tail = control_->tail.load(std::memory_order_acquire);
+  if (head - tail >= nr_slots_) {
+    return nullptr;
+  }
+  return slots_ + (head % nr_slots_) * slot_stride_ + sizeof(FrameHeader);
+}
+
+void ShmRingBuffer::commitWrite(FrameHeader const& header) {
+  if (header.payload_size > slot_capacity_) {
+    throw std::runtime_error("Error! Frame payload (" + std::to_string(header.payload_size) +
+                             " bytes) exceeds ring slot capacity (" + std::to_string(slot_capacity_) + ").");
+  }
+  uint64_t head = control_->head.load(std::memory_order_relaxed);
+  std::memcpy(slots_ + (head % nr_slots_) * slot_stride_, &header, sizeof(FrameHeader));
+  control_->head.store(head + 1, std::memory_order_release);
+}
+
+void const* ShmRingBuffer::tryAcquireRead(FrameHeader* header) {
+  uint64_t tail = control_->tail.load(std::memory_order_relaxed);
+  uint64_t head = control_->head.load(std::memory_order_acquire);
+  if (head == tail) {
+    return nullptr;
+  }
+  unsigned char const* slot = slots_ + (tail % nr_slots_) * slot_stride_;
+  std::memcpy(header, slot, sizeof(FrameHeader));
+  return slot + sizeof(FrameHeader);
+}
+
+void ShmRingBuffer::releaseRead() {
+  control_->tail.store(control_->tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void ShmRingBuffer::close() { control_->closed.store(1, std::memory_order_release); }
+
+bool ShmRingBuffer::isClosed() const { return control_->closed.load(std::memory_order_acquire) != 0; }
+
+size_t ShmRingBuffer::size() const {
+  return control_->head.load(std::memory_order_acquire) - control_->tail.load(std::memory_order_acquire);
+}
+
+uint32_t ShmRingBuffer::getSlotCount() const { return nr_slots_; }
+
+size_t ShmRingBuffer::getSlotCapacity() const { return slot_capacity_; }
+
+int64_t processShmFrames(PlaneExtractor* extractor, ShmRingBuffer* frames, ShmRingBuffer* results, int64_t max_frames,
+                         int64_t result_timeout_ms, int64_t* nr_rejected) {
+  Eigen::MatrixX3f depth_points;
+  int64_t nr_consumed = 0;
+  int64_t nr_processed = 0;
+  while (max_frames < 0 || nr_consumed < max_frames) {
+    FrameHeader header{};
+    void const* payload = nullptr;
+    Backoff frame_backoff;
+    while ((payload = frames->tryAcquireRead(&header)) == nullptr) {
+      // Producer closes the ring after its last commit, so an empty closed ring is drained
+      if (frames->isClosed() && frames->size() == 0) {
+        return nr_processed;
+      }
+      frame_backoff.wait();
+    }
+
+    ++nr_consumed;
+    Eigen::VectorXi labels;
+    {
+      ReadSlotGuard slot_guard(frames);
+      try {
+        validateFrame(header, frames->getSlotCapacity());
+      } catch (std::runtime_error const&) {
+        // Header comes from another process, one malformed frame shouldn't stop the stream
+        if (nr_rejected != nullptr) {
+          ++*nr_rejected;
+        }
+        continue;
+      }
+      Eigen::Index nr_points = static_cast<Eigen::Index>(header.height) * header.width;
+      if (header.format == FrameFormat::kPointsF32) {
+        labels =
+            extractor->process(Eigen::Map<const Eigen::MatrixX3f>(static_cast<float const*>(payload), nr_points, 3));
+      } else {
+        auto depth = static_cast<uint16_t const*>(payload);
+        depth_points.resize(nr_points, 3);
+        for (Eigen::Index row = 0; row < header.height; ++row) {
+          for (Eigen::Index col = 0; col < header.width; ++col) {
+            Eigen::Index i = row * header.width + col;
+            float z = static_cast<float>(depth[i]) * header.depth_scale;
+            depth_points(i, 0) = (static_cast<float>(col) - header.cx) * z / header.fx;
+            depth_points(i, 1) = (static_cast<float>(row) - header.cy) * z / header.fy;
+            depth_points(i, 2) = z;
+          }
+        }
+        labels = extractor->process(depth_points);
+      }
+    }
+
+    FrameHeader result_header = header;
+    result_header.format = FrameFormat::kLabelsI32;
+    result_header.payload_size = labels.size() * sizeof(int32_t);
+    if (result_header.payload_size > results->getSlotCapacity()) {
+      throw std::runtime_error("Error! Labels (" + std::to_string(result_header.payload_size) +
+                               " bytes) exceed results ring slot capacity (" +
+                               std::to_string(results->getSlotCapacity()) + ").");
+    }
+    void* output = nullptr;
+    Backoff result_backoff;
+    auto wait_start = std::chrono::steady_clock::now();
+    while ((output = results->tryAcquireWrite()) == nullptr) {
+      // Consumer closes results ring when it stops reading
+      if (results->isClosed()) {
+        return nr_processed;
+      }
+      if (result_timeout_ms >= 0 &&
+          std::chrono::steady_clock::now() - wait_start > std::chrono::milliseconds(result_timeout_ms)) {
+        throw std::runtime_error("Error! Results ring has no free slot for " + std::to_string(result_timeout_ms) +
+                                 " ms, consumer doesn't read results.");
+      }
+      result_backoff.wait();
+    }
+    std::memcpy(output, labels.data(), result_header.payload_size);
+    results->commitWrite(result_header);
+    ++nr_processed;
+  }
+  return nr_processed;
+}
+}  // namespace utils
+}  // namespace deplex
@@ -33,6 +33,13 @@ void pybind_extractor(py::module& m) {
   py::class_<PlaneExtractor>(m, "PlaneExtractor")
       .def(py::init<int, int, config::Config>(), py::arg("image_height"), py::arg("image_width"),
            py::arg("config") = config::Config())
-      .def("process", &PlaneExtractor::process, py::arg("pcd_array"));
+      .def("process",
+           static_cast<Eigen::VectorXi (PlaneExtractor::*)(Eigen::Ref<const Eigen::MatrixX3f> const&)>(
+               &PlaneExtractor::process),
+           py::arg("pcd_array"))
+      .def("process",
+           static_cast<Eigen::VectorXi (PlaneExtractor::*)(Eigen::Ref<const Eigen::MatrixX3f> const&,
+                                                           Eigen::Vector3f const&)>(&PlaneExtractor::process),
+           py::arg("pcd_array"), py::arg("gravity"));
 }
 }  // namespace deplex
\ No newline at end of file
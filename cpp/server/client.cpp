@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <deplex/utils/depth_image.h>
+#include <deplex/utils/eigen_io.h>
+#include <deplex/utils/shm_ring_buffer.h>
+
+#include "protocol.h"
+
+using namespace deplex::server;
+
+namespace {
+void writeMessage(int fd, MessageType type, std::string const& payload) {
+  MessageHeader header{type, static_cast<uint32_t>(payload.size())};
+  if (write(fd, &header, sizeof(header)) != sizeof(header) ||
+      write(fd, payload.data(), payload.size()) != static_cast<ssize_t>(payload.size())) {
+    throw std::runtime_error("Error! Couldn't send message to deplex-server");
+  }
+}
+
+std::string readMessage(int fd, MessageType* type) {
+  MessageHeader header{};
+  if (read(fd, &header, sizeof(header)) != sizeof(header)) {
+    throw std::runtime_error("Error! Connection to deplex-server closed");
+  }
+  std::string payload(header.payload_size, '\0');
+  size_t offset = 0;
+  while (offset < payload.size()) {
+    ssize_t nr_read = read(fd, &payload[offset], payload.size() - offset);
+    if (nr_read <= 0) throw std::runtime_error("Error! Connection to deplex-server closed");
+    offset += nr_read;
+  }
+  *type = header.type;
+  return payload;
+}
+}  // namespace
+
+/**
+ * Sample deplex-server client: sends one depth image several times and prints scheduling statistics.
+ *
+ * Usage: deplex-server-client <socket> <depth.png> <intrinsics.K> <config.ini> [frames] [priority] [deadline_us]
+ */
+int main(int argc, char* argv[]) {
+  if (argc < 5) {
+    std::cerr << "Usage: " << argv[0]
+              << " <socket> <depth.png> <intrinsics.K> <config.ini> [frames] [priority] [deadline_us]\n";
+    return 1;
+  }
+  int nr_frames = (argc > 5 ? std::stoi(argv[5]) : 10);
+  int32_t priority = (argc > 6 ? std::stoi(argv[6]) : 0);
+  uint64_t deadline_us = (argc > 7 ? std::stoull(argv[7]) : 0);
+
+  deplex::utils::DepthImage image(argv[2]);
+  Eigen::MatrixX3f points = image.toPointCloud(deplex::utils::readIntrinsics(argv[3]));
+  std::stringstream config_text;
+  config_text << std::ifstream(argv[4]).rdbuf();
+
+  std::string suffix = std::to_string(getpid());
+  std::string frames_name = "/deplex_frames_" + suffix;
+  std::string results_name = "/deplex_results_" + suffix;
+  size_t frame_size = points.size() * sizeof(float);
+  auto frames = deplex::utils::ShmRingBuffer::create(frames_name, 2, frame_size);
+  auto results = deplex::utils::ShmRingBuffer::create(results_name, 2, points.rows() * sizeof(int32_t));
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  std::strncpy(address.sun_path, argv[1], sizeof(address.sun_path) - 1);
+  if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+    std::cerr << "Couldn't connect to " << argv[1] << '\n';
+    return 1;
+  }
+
+  RegisterRequest request{};
+  request.version = kProtocolVersion;
+  request.image_height = image.getHeight();
+  request.image_width = image.getWidth();
+  request.priority = priority;
+  std::strncpy(request.frames_ring, frames_name.c_str(), kMaxRingNameLength - 1);
+  std::strncpy(request.results_ring, results_name.c_str(), kMaxRingNameLength - 1);
+  writeMessage(fd, MessageType::kRegister,
+               std::string(reinterpret_cast<char const*>(&request), sizeof(request)) + config_text.str());
+  MessageType type;
+  std::string reply = readMessage(fd, &type);
+  if (type != MessageType::kRegistered) {
+    std::cerr << "Registration failed: " << reply << '\n';
+    return 1;
+  }
+
+  for (int i = 0; i < nr_frames; ++i) {
+    void* slot = frames.tryAcquireWrite();
+    std::memcpy(slot, points.data(), frame_size);
+    deplex::utils::FrameHeader header{};
+    header.sequence = i;
+    header.height = image.getHeight();
+    header.width = image.getWidth();
+    header.format = deplex::utils::FrameFormat::kPointsF32;
+    header.payload_size = frame_size;
+    frames.commitWrite(header);
+
+    FrameRequest frame_request{static_cast<uint64_t>(i), deadline_us};
+    writeMessage(fd, MessageType::kFrame,
+                 std::string(reinterpret_cast<char const*>(&frame_request), sizeof(frame_request)));
+    reply = readMessage(fd, &type);
+    FrameResponse response{};
+    std::memcpy(&response, reply.data(), sizeof(response));
+
+    int32_t found_planes = 0;
+    if (response.status == FrameStatus::kProcessed) {
+      auto labels = static_cast<int32_t const*>(results.tryAcquireRead(&header));
+      found_planes = Eigen::Map<const Eigen::VectorXi>(labels, points.rows()).maxCoeff();
+      results.releaseRead();
+    }
+    std::cout << "Frame " << response.sequence << ": status " << static_cast<uint32_t>(response.status)
+              << ", planes " << found_planes << ", queue (mks) " << response.queue_us << ", process (mks) "
+              << response.process_us << '\n';
+  }
+  close(fd);
+
+  return 0;
+}
@@ -0,0 +1,46 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <csignal>
+#include <iostream>
+#include <thread>
+
+#include "server.h"
+
+namespace {
+deplex::server::Server* running_server = nullptr;
+
+void handleSignal(int) {
+  if (running_server != nullptr) running_server->stop();
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string socket_path = (argc > 1 ? argv[1] : "/tmp/deplex.sock");
+  size_t nr_workers = (argc > 2 ? std::stoul(argv[2]) : std::max(std::thread::hardware_concurrency(), 1u));
+  size_t memory_limit_mb = (argc > 3 ? std::stoul(argv[3]) : 0);
+  std::string cpu_affinity = (argc > 4 ? argv[4] : "");
+
+  deplex::server::Server server(socket_path, nr_workers, memory_limit_mb << 20, cpu_affinity);
+  running_server = &server;
+  std::signal(SIGINT, handleSignal);
+  std::signal(SIGTERM, handleSignal);
+
+  std::cout << "deplex-server: listening on " << socket_path << " with " << nr_workers << " workers" << std::endl;
+  server.run();
+  running_server = nullptr;
+
+  return 0;
+}
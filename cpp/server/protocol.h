@@ -0,0 +1,86 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+
+namespace deplex {
+namespace server {
+/**
+ * deplex-server wire protocol.
+ *
+ * Every message on the Unix domain socket is a MessageHeader followed by payload_size bytes.
+ * Frames and labels never go through the socket: client creates two utils::ShmRingBuffer rings
+ * (frames and results), writes a frame into the frames ring and notifies the server with kFrame.
+ * Server writes labels into the results ring and answers with kFrameDone.
+ */
+constexpr uint32_t kProtocolVersion = 1;
+constexpr uint32_t kMaxRingNameLength = 64;
+// Maximum payload size of socket message, unit: bytes
+constexpr uint32_t kMaxPayloadSize = 1 << 16;
+
+enum class MessageType : uint32_t {
+  // Client -> Server: RegisterRequest followed by config in "key=value\n" form (.ini parameter names)
+  kRegister = 1,
+  // Server -> Client: registration accepted, no payload
+  kRegistered = 2,
+  // Client -> Server: FrameRequest, frame is already committed to frames ring
+  kFrame = 3,
+  // Server -> Client: FrameResponse, labels are committed to results ring if status is kProcessed
+  kFrameDone = 4,
+  // Server -> Client: error description text, connection is closed afterwards
+  kError = 5
+};
+
+enum class FrameStatus : uint32_t {
+  kProcessed = 0,
+  // Frame was skipped, because its deadline expired before a worker picked it up
+  kDeadlineMissed = 1,
+  kFailed = 2
+};
+
+struct MessageHeader {
+  MessageType type;
+  uint32_t payload_size;
+};
+
+struct RegisterRequest {
+  uint32_t version;
+  int32_t image_height;
+  int32_t image_width;
+  // Bigger value is scheduled first
+  int32_t priority;
+  char frames_ring[kMaxRingNameLength];
+  char results_ring[kMaxRingNameLength];
+};
+
+struct FrameRequest {
+  uint64_t sequence;
+  // Time budget since the server received the request, unit: microseconds. 0 means no deadline
+  uint64_t deadline_us;
+};
+
+struct FrameResponse {
+  uint64_t sequence;
+  FrameStatus status;
+  uint32_t reserved;
+  // Time spent in scheduler queue, unit: microseconds
+  uint64_t queue_us;
+  // Time spent in plane extraction, unit: microseconds
+  uint64_t process_us;
+};
+}  // namespace server
+}  // namespace deplex
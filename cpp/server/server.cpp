@@ -0,0 +1,409 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "server.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <deplex/parallel_policy.h>
+#include <deplex/thread_placement.h>
+#include <deplex/utils/shm_ring_buffer.h>
+
+namespace deplex {
+namespace server {
+namespace {
+// Maximum time a client may keep its socket buffer full before the server gives up sending, unit: milliseconds
+constexpr int kSendTimeoutMs = 1000;
+constexpr size_t kReadChunkSize = 4096;
+
+/**
+ * Write whole buffer to non-blocking socket, waiting for a client not reading its socket at most kSendTimeoutMs.
+ */
+bool writeExact(int fd, void const* data, size_t size) {
+  auto buffer = static_cast<char const*>(data);
+  while (size > 0) {
+    ssize_t nr_written = ::send(fd, buffer, size, MSG_NOSIGNAL);
+    if (nr_written <= 0) {
+      if (nr_written < 0 && errno == EINTR) continue;
+      pollfd poll_fd{fd, POLLOUT, 0};
+      if (nr_written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) && poll(&poll_fd, 1, kSendTimeoutMs) > 0) {
+        continue;
+      }
+      return false;
+    }
+    buffer += nr_written;
+    size -= nr_written;
+  }
+  return true;
+}
+
+/**
+ * Parse "key=value" lines of config text.
+ */
+std::unordered_map<std::string, std::string> parseConfigText(std::string const& config_text) {
+  std::unordered_map<std::string, std::string> param_map;
+  std::istringstream stream(config_text);
+  std::string line;
+  while (std::getline(stream, line)) {
+    size_t eq_pos = line.find_first_of('=');
+    if (line.empty() || line[0] == '#' || eq_pos == std::string::npos || eq_pos == 0) continue;
+    param_map[line.substr(0, eq_pos)] = line.substr(eq_pos + 1);
+  }
+  return param_map;
+}
+
+uint64_t elapsedMicroseconds(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(to - from).count();
+}
+}  // namespace
+
+struct Server::Session {
+  explicit Session(int socket_fd) : fd(socket_fd) {}
+
+  ~Session() { ::close(fd); }
+
+  int fd;
+  // Bytes received from client, which don't form a complete message yet
+  std::string input;
+  bool registered = false;
+  bool busy = false;
+  int32_t priority = 0;
+  int32_t image_height = 0;
+  int32_t image_width = 0;
+  config::Config config;
+  std::unique_ptr<utils::ShmRingBuffer> frames;
+  std::unique_ptr<utils::ShmRingBuffer> results;
+  std::deque<PendingFrame> pending;
+  std::mutex send_mutex;
+
+  bool send(MessageType type, void const* payload, uint32_t payload_size) {
+    std::lock_guard<std::mutex> lock(send_mutex);
+    MessageHeader header{type, payload_size};
+    return writeExact(fd, &header, sizeof(header)) && writeExact(fd, payload, payload_size);
+  }
+};
+
+Server::Server(std::string socket_path, size_t nr_workers, size_t memory_limit, std::string cpu_affinity)
+    : socket_path_(std::move(socket_path)),
+      listen_fd_(-1),
+      running_(false),
+      workers_(std::max<size_t>(nr_workers, 1)),
+      extractors_(memory_limit),
+      cpus_(parseCpuList(cpu_affinity)) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (socket_path_.size() >= sizeof(address.sun_path)) {
+    throw std::runtime_error("Error! Socket path is too long: " + socket_path_);
+  }
+  std::strncpy(address.sun_path, socket_path_.c_str(), sizeof(address.sun_path) - 1);
+
+  listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listen_fd_ < 0) {
+    throw std::runtime_error(std::string("Error! Couldn't create socket: ") + std::strerror(errno));
+  }
+  unlink(socket_path_.c_str());
+  if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listen_fd_, 64) != 0) {
+    ::close(listen_fd_);
+    throw std::runtime_error("Error! Couldn't listen on " + socket_path_ + ": " + std::strerror(errno));
+  }
+}
+
+Server::~Server() {
+  stop();
+  for (auto& worker : workers_) {
+    if (worker.joinable()) worker.join();
+  }
+  ::close(listen_fd_);
+  unlink(socket_path_.c_str());
+}
+
+void Server::stop() { running_ = false; }
+
+void Server::run() {
+  running_ = true;
+  for (size_t worker_id = 0; worker_id < workers_.size(); ++worker_id) {
+    workers_[worker_id] = std::thread(&Server::workerLoop, this, worker_id);
+  }
+
+  while (running_) {
+    std::vector<pollfd> poll_fds{{listen_fd_, POLLIN, 0}};
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (auto const& session : sessions_) {
+        poll_fds.push_back({session.first, POLLIN, 0});
+      }
+    }
+    if (poll(poll_fds.data(), poll_fds.size(), 100) <= 0) {
+      continue;
+    }
+    if (poll_fds[0].revents & POLLIN) {
+      acceptClient();
+    }
+    for (size_t i = 1; i < poll_fds.size(); ++i) {
+      if (poll_fds[i].revents == 0) continue;
+      std::shared_ptr<Session> session;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        session = sessions_.at(poll_fds[i].fd);
+      }
+      if ((poll_fds[i].revents & POLLIN) == 0 || !receiveMessages(session.get())) {
+        closeSession(poll_fds[i].fd);
+      }
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    has_work_.notify_all();
+  }
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  sessions_.clear();
+}
+
+void Server::acceptClient() {
+  int client_fd = accept(listen_fd_, nullptr, nullptr);
+  if (client_fd < 0) {
+    return;
+  }
+  // Poll thread serves all clients, so it never blocks on a socket
+  if (fcntl(client_fd, F_SETFL, fcntl(client_fd, F_GETFL) | O_NONBLOCK) != 0) {
+    ::close(client_fd);
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  sessions_[client_fd] = std::make_shared<Session>(client_fd);
+}
+
+void Server::closeSession(int fd) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Socket is closed by Session destructor, after running frame (if any) is finished
+  sessions_.erase(fd);
+}
+
+bool Server::receiveMessages(Session* session) {
+  // One read per poll wakeup, so that a flooding client can't monopolize the poll thread
+  char buffer[kReadChunkSize];
+  ssize_t nr_read = ::read(session->fd, buffer, sizeof(buffer));
+  if (nr_read == 0) {
+    return false;
+  }
+  if (nr_read < 0) {
+    return errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK;
+  }
+  session->input.append(buffer, nr_read);
+
+  while (session->input.size() >= sizeof(MessageHeader)) {
+    MessageHeader header{};
+    std::memcpy(&header, session->input.data(), sizeof(header));
+    if (header.payload_size > kMaxPayloadSize) {
+      std::string message = "Error! Message payload exceeds " + std::to_string(kMaxPayloadSize) + " bytes.";
+      session->send(MessageType::kError, message.data(), message.size());
+      return false;
+    }
+    size_t message_size = sizeof(MessageHeader) + header.payload_size;
+    if (session->input.size() < message_size) {
+      break;
+    }
+    std::string payload = session->input.substr(sizeof(MessageHeader), header.payload_size);
+    session->input.erase(0, message_size);
+    if (!handleMessage(session, header, payload)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Server::handleMessage(Session* session, MessageHeader const& header, std::string const& payload) {
+  if (header.type == MessageType::kRegister && !session->registered && payload.size() >= sizeof(RegisterRequest)) {
+    RegisterRequest request{};
+    std::memcpy(&request, payload.data(), sizeof(request));
+    try {
+      registerClient(session, request, payload.substr(sizeof(RegisterRequest)));
+    } catch (std::exception const& e) {
+      std::string message = e.what();
+      session->send(MessageType::kError, message.data(), message.size());
+      return false;
+    }
+    return session->send(MessageType::kRegistered, nullptr, 0);
+  }
+  if (header.type == MessageType::kFrame && session->registered && payload.size() == sizeof(FrameRequest)) {
+    FrameRequest request{};
+    std::memcpy(&request, payload.data(), sizeof(request));
+    PendingFrame frame{request.sequence, Clock::now(), Clock::time_point::max()};
+    if (request.deadline_us > 0) {
+      frame.deadline = frame.arrival + std::chrono::microseconds(request.deadline_us);
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    session->pending.push_back(frame);
+    has_work_.notify_one();
+    return true;
+  }
+
+  std::string message = "Error! Unexpected message type: " + std::to_string(static_cast<uint32_t>(header.type));
+  session->send(MessageType::kError, message.data(), message.size());
+  return false;
+}
+
+void Server::registerClient(Session* session, RegisterRequest const& request, std::string const& config_text) {
+  if (request.version != kProtocolVersion) {
+    throw std::runtime_error("Error! Unsupported protocol version: " + std::to_string(request.version));
+  }
+  if (request.image_height <= 0 || request.image_width <= 0) {
+    throw std::runtime_error("Error! Invalid image shape: " + std::to_string(request.image_height) + " x " +
+                             std::to_string(request.image_width));
+  }
+  std::string frames_ring(request.frames_ring, strnlen(request.frames_ring, kMaxRingNameLength));
+  std::string results_ring(request.results_ring, strnlen(request.results_ring, kMaxRingNameLength));
+
+  session->config = config::Config(parseConfigText(config_text));
+  // Workers are placed once by the server, per-frame placement of extractor would override it
+  session->config.cpu_affinity.clear();
+  session->config.realtime_priority = 0;
+  // Rings validate their geometry against shared memory size, each frame is validated against slot capacity
+  session->frames.reset(new utils::ShmRingBuffer(utils::ShmRingBuffer::open(frames_ring)));
+  session->results.reset(new utils::ShmRingBuffer(utils::ShmRingBuffer::open(results_ring)));
+  auto nr_points = static_cast<size_t>(request.image_height) * static_cast<size_t>(request.image_width);
+  if (session->frames->getSlotCapacity() < nr_points * sizeof(uint16_t)) {
+    throw std::runtime_error("Error! Frames ring " + frames_ring + " can't hold one frame.");
+  }
+  if (session->results->getSlotCapacity() < nr_points * sizeof(int32_t)) {
+    throw std::runtime_error("Error! Results ring " + results_ring + " can't hold labels of one frame.");
+  }
+  session->image_height = request.image_height;
+  session->image_width = request.image_width;
+  session->priority = request.priority;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  session->registered = true;
+}
+
+std::vector<int32_t> Server::getWorkerCpus(size_t worker_id) const {
+  if (cpus_.size() < workers_.size()) {
+    return cpus_.empty() ? cpus_ : std::vector<int32_t>{cpus_[worker_id % cpus_.size()]};
+  }
+  std::vector<int32_t> worker_cpus;
+  for (size_t i = worker_id; i < cpus_.size(); i += workers_.size()) {
+    worker_cpus.push_back(cpus_[i]);
+  }
+  return worker_cpus;
+}
+
+void Server::workerLoop(size_t worker_id) {
+  // Parallelism of the server comes from workers, OpenMP teams of every worker would oversubscribe CPUs
+  ParallelPolicy::setForceSerial(true);
+  try {
+    applyThreadPlacement(getWorkerCpus(worker_id), 0);
+  } catch (std::exception const& e) {
+    std::cerr << "[deplex-server] Worker " << worker_id << " runs unpinned: " << e.what() << '\n';
+  }
+  while (true) {
+    std::shared_ptr<Session> session;
+    PendingFrame frame{};
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      has_work_.wait(lock, [&] { return !running_ || (session = pickSession()) != nullptr; });
+      if (!running_) {
+        return;
+      }
+      frame = session->pending.front();
+      session->pending.pop_front();
+      session->busy = true;
+    }
+
+    processFrame(session.get(), frame);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      session->busy = false;
+    }
+    has_work_.notify_all();
+  }
+}
+
+std::shared_ptr<Server::Session> Server::pickSession() {
+  std::shared_ptr<Session> best;
+  for (auto const& entry : sessions_) {
+    auto const& session = entry.second;
+    if (!session->registered || session->busy || session->pending.empty()) {
+      continue;
+    }
+    if (!best) {
+      best = session;
+      continue;
+    }
+    PendingFrame const& frame = session->pending.front();
+    PendingFrame const& best_frame = best->pending.front();
+    if (session->priority != best->priority) {
+      if (session->priority > best->priority) best = session;
+    } else if (frame.deadline != best_frame.deadline) {
+      if (frame.deadline < best_frame.deadline) best = session;
+    } else if (frame.arrival < best_frame.arrival) {
+      best = session;
+    }
+  }
+  return best;
+}
+
+void Server::processFrame(Session* session, PendingFrame const& frame) {
+  auto start_time = Clock::now();
+  FrameResponse response{};
+  response.sequence = frame.sequence;
+  response.queue_us = elapsedMicroseconds(frame.arrival, start_time);
+
+  if (start_time > frame.deadline) {
+    utils::FrameHeader header{};
+    if (session->frames->tryAcquireRead(&header) != nullptr) {
+      session->frames->releaseRead();
+    }
+    response.status = FrameStatus::kDeadlineMissed;
+  } else if (session->frames->size() == 0) {
+    response.status = FrameStatus::kFailed;
+  } else {
+    auto extractor = extractors_.acquire(session->image_height, session->image_width, session->config);
+    try {
+      // Nothing is published, if client closed its results ring or frame is malformed
+      int64_t nr_rejected = 0;
+      bool is_published = utils::processShmFrames(&*extractor, session->frames.get(), session->results.get(), 1,
+                                                  1000, &nr_rejected) == 1;
+      if (nr_rejected != 0) {
+        std::cerr << "[deplex-server] Frame " << frame.sequence
+                  << " rejected: shape doesn't fit its payload or ring slot\n";
+      }
+      response.status = (is_published ? FrameStatus::kProcessed : FrameStatus::kFailed);
+    } catch (std::exception const& e) {
+      std::cerr << "[deplex-server] Frame " << frame.sequence << " failed: " << e.what() << '\n';
+      response.status = FrameStatus::kFailed;
+    }
+  }
+
+  response.process_us = elapsedMicroseconds(start_time, Clock::now());
+  session->send(MessageType::kFrameDone, &response, sizeof(response));
+}
+}  // namespace server
+}  // namespace deplex
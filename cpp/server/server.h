@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <deplex/extractor_pool.h>
+
+#include "protocol.h"
+
+namespace deplex {
+namespace server {
+/**
+ * Local plane extraction daemon.
+ *
+ * Clients connect over Unix domain socket and exchange frames through shared memory rings (see protocol.h).
+ * Frames of all clients are scheduled on one pool of workers: higher priority first, then earliest deadline.
+ * Frames of one client are processed in order, one at a time. Extractors are kept warm in ExtractorPool
+ * between frames and clients.
+ *
+ * Workers are the only extraction threads: each runs extraction serially, so that a loaded server doesn't open
+ * an OpenMP team per worker. Worker placement is owned by the server, CPU affinity and real-time priority
+ * of client configs are ignored.
+ */
+class Server {
+ public:
+  /**
+   * Server constructor.
+   *
+   * @param socket_path Path of Unix domain socket to listen on.
+   * @param nr_workers Number of extraction threads.
+   * @param memory_limit Workspace memory limit of warm extractors, unit: bytes. 0 means no limit.
+   * @param cpu_affinity CPUs of extraction threads (see Config::cpu_affinity), split evenly between workers.
+   * Empty means any CPU.
+   */
+  Server(std::string socket_path, size_t nr_workers, size_t memory_limit = 0, std::string cpu_affinity = "");
+  ~Server();
+
+  /**
+   * Accept clients and serve frames until stop() is called.
+   */
+  void run();
+
+  /**
+   * Request run() to return. Safe to call from signal handler.
+   */
+  void stop();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+  struct Session;
+
+  struct PendingFrame {
+    uint64_t sequence;
+    Clock::time_point arrival;
+    Clock::time_point deadline;
+  };
+
+  std::string socket_path_;
+  int listen_fd_;
+  std::atomic<bool> running_;
+  std::vector<std::thread> workers_;
+
+  std::mutex mutex_;
+  std::condition_variable has_work_;
+  std::map<int, std::shared_ptr<Session>> sessions_;
+
+  ExtractorPool extractors_;
+  std::vector<int32_t> cpus_;
+
+  /**
+   * Worker thread loop.
+   *
+   * @param worker_id Index of worker, selects its share of CPUs.
+   */
+  void workerLoop(size_t worker_id);
+
+  /**
+   * CPUs of worker: every nr_workers-th CPU of server CPU list, or one CPU shared with other workers
+   * if there are fewer CPUs than workers.
+   */
+  std::vector<int32_t> getWorkerCpus(size_t worker_id) const;
+
+  /**
+   * Pick session whose next frame should be processed first.
+   *
+   * @returns Session with pending frames, nullptr if there is nothing to schedule.
+   */
+  std::shared_ptr<Session> pickSession();
+
+  void processFrame(Session* session, PendingFrame const& frame);
+
+  void acceptClient();
+
+  /**
+   * Read available bytes from client socket without blocking and handle all complete messages.
+   *
+   * @returns false if connection should be closed.
+   */
+  bool receiveMessages(Session* session);
+
+  /**
+   * Handle one message from client.
+   *
+   * @returns false if connection should be closed.
+   */
+  bool handleMessage(Session* session, MessageHeader const& header, std::string const& payload);
+
+  void registerClient(Session* session, RegisterRequest const& request, std::string const& config_text);
+
+  void closeSession(int fd);
+};
+}  // namespace server
+}  // namespace deplex
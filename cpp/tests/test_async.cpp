@@ -0,0 +1,174 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include <deplex/config.h>
+#include <deplex/plane_extractor.h>
+#include <deplex/utils/depth_image.h>
+#include <deplex/utils/eigen_io.h>
+
+#include "globals.hpp"
+
+namespace deplex {
+namespace {
+
+class AsyncProcessing : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    config_ = config::Config(test_globals::tum::config);
+    auto image = utils::DepthImage(test_globals::tum::sample_image);
+    height_ = image.getHeight();
+    width_ = image.getWidth();
+    points_ = std::make_shared<const Eigen::MatrixX3f>(
+        image.toPointCloud(utils::readIntrinsics(test_globals::tum::intrinsics)));
+    expected_labels_ = PlaneExtractor(height_, width_, config_).process(*points_);
+  }
+
+  config::Config config_;
+  int32_t height_;
+  int32_t width_;
+  std::shared_ptr<const Eigen::MatrixX3f> points_;
+  Eigen::VectorXi expected_labels_;
+};
+
+TEST_F(AsyncProcessing, FuturesMatchSyncResults) {
+  auto algorithm = PlaneExtractor(height_, width_, config_);
+  auto labels = algorithm.processAsync(points_);
+  auto result = algorithm.extractAsync(points_);
+  ASSERT_TRUE(labels.get() == expected_labels_);
+  ASSERT_TRUE(result.get().labels == expected_labels_);
+  ASSERT_EQ(algorithm.getFramesInFlight(), 0);
+  // Synchronous calls are still available
+  ASSERT_TRUE(algorithm.process(*points_) == expected_labels_);
+}
+
+TEST_F(AsyncProcessing, InFlightLimitAndOrder) {
+  config_.max_frames_in_flight = 2;
+  auto algorithm = PlaneExtractor(height_, width_, config_);
+  // Hold first frame inside the pipeline
+  std::promise<void> gate;
+  std::shared_future<void> gate_opened = gate.get_future().share();
+  algorithm.addStageHook(PipelineStage::kCellGrid, [gate_opened](Eigen::Ref<const Eigen::MatrixX3f> const&,
+                                                                 PipelineFrame*) { gate_opened.wait(); });
+
+  std::mutex order_mutex;
+  std::vector<int32_t> order;
+  std::vector<std::future<void>> done;
+  for (int32_t frame_id = 0; frame_id < 2; ++frame_id) {
+    auto frame_done = std::make_shared<std::promise<void>>();
+    done.push_back(frame_done->get_future());
+    algorithm.extractAsync(points_, [&, frame_id, frame_done](ExtractionResult result, std::exception_ptr error) {
+      EXPECT_FALSE(error);
+      EXPECT_TRUE(result.labels == expected_labels_);
+      {
+        std::lock_guard<std::mutex> lock(order_mutex);
+        order.push_back(frame_id);
+      }
+      frame_done->set_value();
+    });
+  }
+  ASSERT_EQ(algorithm.getFramesInFlight(), 2);
+  ASSERT_THROW(algorithm.processAsync(points_), std::runtime_error);
+
+  gate.set_value();
+  for (auto& frame_done : done) {
+    frame_done.get();
+  }
+  ASSERT_EQ(order, std::vector<int32_t>({0, 1}));
+}
+
+TEST_F(AsyncProcessing, PipelinedResultsInOrder) {
+  // Frames differ by scale, so that a mixed up cell grid changes labels
+  std::vector<std::shared_ptr<const Eigen::MatrixX3f>> frames;
+  std::vector<Eigen::VectorXi> expected;
+  auto sync_algorithm = PlaneExtractor(height_, width_, config_);
+  for (float scale : {1.f, 1.3f, 0.8f, 1.f, 1.3f}) {
+    frames.push_back(std::make_shared<const Eigen::MatrixX3f>(*points_ * scale));
+    expected.push_back(sync_algorithm.process(*frames.back()));
+  }
+
+  config_.max_frames_in_flight = static_cast<int32_t>(frames.size());
+  config_.pipelined_processing = true;
+  auto algorithm = PlaneExtractor(height_, width_, config_);
+  ASSERT_GT(algorithm.getWorkspaceSize(), sync_algorithm.getWorkspaceSize());
+  // Hold first frame, so that the following ones are queued and prefetched
+  std::promise<void> gate;
+  std::shared_future<void> gate_opened = gate.get_future().share();
+  algorithm.addStageHook(PipelineStage::kCellGrid, [gate_opened](Eigen::Ref<const Eigen::MatrixX3f> const&,
+                                                                 PipelineFrame*) { gate_opened.wait(); });
+  std::vector<std::future<Eigen::VectorXi>> labels;
+  for (auto const& frame : frames) {
+    labels.push_back(algorithm.processAsync(frame));
+  }
+  gate.set_value();
+  for (size_t i = 0; i < frames.size(); ++i) {
+    ASSERT_TRUE(labels[i].get() == expected[i]) << "Frame " << i;
+  }
+  // Synchronous calls don't interfere with pipeline
+  auto pipelined = algorithm.processAsync(frames[1]);
+  ASSERT_TRUE(algorithm.process(*frames[2]) == expected[2]);
+  ASSERT_TRUE(pipelined.get() == expected[1]);
+}
+
+TEST_F(AsyncProcessing, MappedBufferAndErrors) {
+  auto algorithm = PlaneExtractor(height_, width_, config_);
+  auto storage = std::make_shared<Eigen::MatrixX3f>(*points_);
+  std::weak_ptr<Eigen::MatrixX3f> storage_alive = storage;
+  Eigen::Map<const Eigen::MatrixX3f> mapped(storage->data(), storage->rows(), 3);
+  auto labels = algorithm.processAsync(PointCloudBuffer(mapped, std::move(storage)));
+  ASSERT_TRUE(labels.get() == expected_labels_);
+  ASSERT_TRUE(storage_alive.expired());
+
+  // Errors of extraction are delivered through future
+  auto wrong_shape = std::make_shared<const Eigen::MatrixX3f>(Eigen::MatrixX3f::Zero(10, 3));
+  auto failed = algorithm.extractAsync(wrong_shape);
+  ASSERT_THROW(failed.get(), std::runtime_error);
+  ASSERT_THROW(algorithm.extractAsync(points_, ExtractionCallback()), std::runtime_error);
+
+  config_.max_frames_in_flight = 0;
+  ASSERT_THROW(PlaneExtractor(height_, width_, config_), std::runtime_error);
+}
+
+TEST_F(AsyncProcessing, CallbackExceptionsAndDestruction) {
+  config_.max_frames_in_flight = 2;
+  auto algorithm = std::make_unique<PlaneExtractor>(height_, width_, config_);
+  // Throwing callback doesn't stop worker thread
+  algorithm->extractAsync(points_, [](ExtractionResult, std::exception_ptr) { throw std::runtime_error("callback"); });
+  ASSERT_TRUE(algorithm->processAsync(points_).get() == expected_labels_);
+
+  // Callback destroys extractor, the queued frame is still processed
+  std::promise<void> gate;
+  std::shared_future<void> gate_opened = gate.get_future().share();
+  algorithm->addStageHook(PipelineStage::kCellGrid, [gate_opened](Eigen::Ref<const Eigen::MatrixX3f> const&,
+                                                                  PipelineFrame*) { gate_opened.wait(); });
+  std::promise<void> destroyed;
+  algorithm->extractAsync(points_, [&](ExtractionResult, std::exception_ptr) {
+    algorithm.reset();
+    destroyed.set_value();
+  });
+  auto queued = algorithm->processAsync(points_);
+  gate.set_value();
+  destroyed.get_future().wait();
+  ASSERT_TRUE(queued.get() == expected_labels_);
+}
+}  // namespace
+}  // namespace deplex
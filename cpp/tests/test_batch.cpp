@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include <deplex/utils/eigen_io.h>
+
+#include "batch.h"
+#include "globals.hpp"
+
+namespace deplex {
+namespace {
+namespace fs = std::filesystem;
+
+/**
+ * Dataset roots a/seq1 and b/seq1 with the same name, each with one TUM frame.
+ */
+batch::Options makeDatasets(fs::path const& directory) {
+  fs::remove_all(directory);
+  batch::Options options;
+  options.intrinsics_path = test_globals::tum::intrinsics;
+  options.config_path = test_globals::tum::config;
+  options.output_dir = directory / "output";
+  options.nr_threads = 2;
+  for (auto const& root : {directory / "a" / "seq1", directory / "b" / "seq1"}) {
+    fs::create_directories(root);
+    fs::copy_file(test_globals::tum::sample_image, root / "frame.png");
+    options.dataset_roots.push_back(root);
+  }
+  return options;
+}
+
+TEST(Batch, SameRootNames) {
+  fs::path directory = fs::temp_directory_path() / "deplex_test_batch_names";
+  auto options = makeDatasets(directory);
+  auto summary = batch::run(options);
+  ASSERT_EQ(summary.nr_processed, 2);
+  ASSERT_EQ(summary.nr_failed, 0);
+  for (auto const& root : options.dataset_roots) {
+    fs::path output_path = batch::getOutputDir(options.output_dir, root) / "frame.labels";
+    ASSERT_TRUE(utils::isLabelsBinaryComplete(output_path.string()));
+  }
+  ASSERT_NE(batch::getOutputDir(options.output_dir, options.dataset_roots[0]),
+            batch::getOutputDir(options.output_dir, options.dataset_roots[1]));
+  fs::remove_all(directory);
+}
+
+TEST(Batch, Resume) {
+  fs::path directory = fs::temp_directory_path() / "deplex_test_batch_resume";
+  auto options = makeDatasets(directory);
+  ASSERT_EQ(batch::run(options).nr_processed, 2);
+
+  options.resume = true;
+  auto summary = batch::run(options);
+  ASSERT_EQ(summary.nr_processed, 0);
+  ASSERT_EQ(summary.nr_skipped, 2);
+
+  // Truncated output of interrupted run is processed again
+  fs::path output_path = batch::getOutputDir(options.output_dir, options.dataset_roots[1]) / "frame.labels";
+  fs::resize_file(output_path, fs::file_size(output_path) / 2);
+  summary = batch::run(options);
+  ASSERT_EQ(summary.nr_processed, 1);
+  ASSERT_EQ(summary.nr_skipped, 1);
+  ASSERT_TRUE(utils::isLabelsBinaryComplete(output_path.string()));
+  fs::remove_all(directory);
+}
+}  // namespace
+}  // namespace deplex
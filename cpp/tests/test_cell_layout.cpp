@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include <deplex/cell_layout.h>
+#include <deplex/plane_extractor.h>
+#include <deplex/utils/depth_image.h>
+#include <deplex/utils/eigen_io.h>
+
+#include "globals.hpp"
+
+namespace deplex {
+namespace {
+class CellLayoutTest : public ::testing::TestWithParam<config::CellOrder> {};
+
+std::string getCellOrderName(::testing::TestParamInfo<config::CellOrder> const& info) {
+  char const* names[] = {"RowMajor", "Morton", "Tiled"};
+  return names[static_cast<int32_t>(info.param)];
+}
+
+TEST_P(CellLayoutTest, IndexRoundTrip) {
+  for (auto shape : {std::make_pair(48, 64), std::make_pair(37, 53), std::make_pair(1, 9)}) {
+    CellLayout layout(GetParam(), shape.first, shape.second);
+    std::set<size_t> indices;
+    for (int32_t row = 0; row < shape.first; ++row) {
+      for (int32_t col = 0; col < shape.second; ++col) {
+        size_t index = layout.toIndex(row, col);
+        ASSERT_LT(index, layout.size());
+        ASSERT_TRUE(layout.isValid(index));
+        ASSERT_EQ(layout.getRow(index), row);
+        ASSERT_EQ(layout.getCol(index), col);
+        indices.insert(index);
+      }
+    }
+    ASSERT_EQ(indices.size(), static_cast<size_t>(shape.first * shape.second));
+    if (GetParam() == config::CellOrder::kRowMajor) {
+      ASSERT_EQ(layout.size(), indices.size());
+    } else {
+      // Morton and tiled orders pad partial blocks only
+      size_t block_size = (GetParam() == config::CellOrder::kMorton ? CellLayout::kMortonBlockSize
+                                                                     : CellLayout::kTileSize);
+      size_t nr_block_rows = (shape.first + block_size - 1) / block_size;
+      size_t nr_block_cols = (shape.second + block_size - 1) / block_size;
+      ASSERT_EQ(layout.size(), nr_block_rows * nr_block_cols * block_size * block_size);
+      for (size_t index = 0; index < layout.size(); ++index) {
+        ASSERT_EQ(layout.isValid(index), indices.count(index) == 1);
+      }
+    }
+  }
+}
+
+TEST_P(CellLayoutTest, Neighbours) {
+  // Grid with partial blocks and grid of whole blocks
+  for (auto shape : {std::make_pair(37, 53), std::make_pair(32, 48)}) {
+    CellLayout layout(GetParam(), shape.first, shape.second);
+    for (int32_t row = 0; row < layout.getNrRows(); ++row) {
+      for (int32_t col = 0; col < layout.getNrCols(); ++col) {
+        std::vector<size_t> expected;
+        if (row > 0) expected.push_back(layout.toIndex(row - 1, col));
+        if (row + 1 < layout.getNrRows()) expected.push_back(layout.toIndex(row + 1, col));
+        if (col > 0) expected.push_back(layout.toIndex(row, col - 1));
+        if (col + 1 < layout.getNrCols()) expected.push_back(layout.toIndex(row, col + 1));
+
+        std::vector<size_t> neighbours;
+        layout.forEachNeighbour(layout.toIndex(row, col), [&](size_t index) { neighbours.push_back(index); });
+        ASSERT_EQ(neighbours, expected);
+      }
+    }
+  }
+}
+
+TEST_P(CellLayoutTest, DiagonalNeighbours) {
+  int32_t offsets[8][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}, {-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
+  for (auto shape : {std::make_pair(37, 53), std::make_pair(32, 48)}) {
+    CellLayout layout(GetParam(), shape.first, shape.second, 8);
+    for (int32_t row = 0; row < layout.getNrRows(); ++row) {
+      for (int32_t col = 0; col < layout.getNrCols(); ++col) {
+        std::vector<size_t> expected;
+        for (auto const& offset : offsets) {
+          int32_t neighbour_row = row + offset[0];
+          int32_t neighbour_col = col + offset[1];
+          if (neighbour_row >= 0 && neighbour_row < layout.getNrRows() && neighbour_col >= 0 &&
+              neighbour_col < layout.getNrCols()) {
+            expected.push_back(layout.toIndex(neighbour_row, neighbour_col));
+          }
+        }
+
+        std::vector<size_t> neighbours;
+        layout.forEachNeighbour(layout.toIndex(row, col), [&](size_t index) { neighbours.push_back(index); });
+        ASSERT_EQ(neighbours, expected);
+      }
+    }
+  }
+}
+
+TEST_P(CellLayoutTest, SameLabelsAsRowMajor) {
+  auto config = config::Config(test_globals::tum::config);
+  auto image = utils::DepthImage(test_globals::tum::sample_image);
+  auto points = image.toPointCloud(utils::readIntrinsics(test_globals::tum::intrinsics));
+  auto expected_labels = PlaneExtractor(image.getHeight(), image.getWidth(), config).process(points);
+
+  config.cell_order = GetParam();
+  auto labels = PlaneExtractor(image.getHeight(), image.getWidth(), config).process(points);
+  ASSERT_EQ(labels, expected_labels);
+}
+
+INSTANTIATE_TEST_SUITE_P(CellOrders, CellLayoutTest,
+                         ::testing::Values(config::CellOrder::kRowMajor, config::CellOrder::kMorton,
+                                           config::CellOrder::kTiled),
+                         getCellOrderName);
+}  // namespace
+}  // namespace deplex
@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <deplex/cell_segment_stat.h>
+
+namespace deplex {
+namespace {
+TEST(PlaneCovariance, MatchesMonteCarlo) {
+  constexpr int32_t kNrTrials = 2000;
+  constexpr int32_t kGridSize = 20;
+  constexpr float kSigma = 5;
+  std::mt19937 generator(42);
+  std::normal_distribution<float> noise(0, kSigma);
+
+  Eigen::MatrixX3f points(kGridSize * kGridSize, 3);
+  std::vector<Eigen::Vector4f> parameters;
+  Eigen::Matrix4f predicted_cov;
+  for (int32_t trial = 0; trial < kNrTrials; ++trial) {
+    for (int32_t i = 0; i < points.rows(); ++i) {
+      points.row(i) << static_cast<float>(i % kGridSize) * 20, static_cast<float>(i / kGridSize) * 20,
+          100 + noise(generator);
+    }
+    CellSegmentStat stat(points);
+    parameters.emplace_back(stat.getNormal().x(), stat.getNormal().y(), stat.getNormal().z(), stat.getD());
+    if (trial == 0) {
+      predicted_cov = stat.getParameterCovariance(0, kSigma);
+    }
+  }
+
+  Eigen::Vector4f mean_parameters = Eigen::Vector4f::Zero();
+  for (auto const& p : parameters) {
+    mean_parameters += p / kNrTrials;
+  }
+  Eigen::Matrix4f empirical_cov = Eigen::Matrix4f::Zero();
+  for (auto const& p : parameters) {
+    empirical_cov += (p - mean_parameters) * (p - mean_parameters).transpose() / (kNrTrials - 1);
+  }
+
+  // Normal x, y components, d and their correlations
+  for (int i : {0, 1, 3}) {
+    ASSERT_NEAR(predicted_cov(i, i), empirical_cov(i, i), 0.15 * empirical_cov(i, i));
+  }
+  ASSERT_NEAR(predicted_cov(0, 3), empirical_cov(0, 3), 0.15 * std::abs(empirical_cov(0, 3)));
+  ASSERT_TRUE(predicted_cov.isApprox(predicted_cov.transpose()));
+}
+
+TEST(CellSegmentStat, MergedFarWall) {
+  constexpr int32_t kCellSize = 10;
+  constexpr int32_t kNrCells = 40;
+  constexpr float kSigma = 2;
+  std::mt19937 generator(42);
+  std::normal_distribution<float> noise(0, kSigma);
+
+  // Wall 8 m away, slightly tilted, split into cells merged one by one
+  Eigen::MatrixX3d all_points(kCellSize * kCellSize * kNrCells * kNrCells, 3);
+  CellSegmentStat merged;
+  Eigen::Index nr_points = 0;
+  for (int32_t cell_id = 0; cell_id < kNrCells * kNrCells; ++cell_id) {
+    Eigen::MatrixX3f points(kCellSize * kCellSize, 3);
+    for (int32_t i = 0; i < points.rows(); ++i) {
+      float x = static_cast<float>((cell_id % kNrCells) * kCellSize + i % kCellSize) * 10 - 2000;
+      float y = static_cast<float>((cell_id / kNrCells) * kCellSize + i / kCellSize) * 10 - 2000;
+      points.row(i) << x, y, 8000 + 0.1f * x + noise(generator);
+    }
+    all_points.middleRows(nr_points, points.rows()) = points.cast<double>();
+    nr_points += points.rows();
+    merged += CellSegmentStat(points);
+  }
+  merged.fitPlane();
+
+  Eigen::RowVector3d mean = all_points.colwise().mean();
+  Eigen::MatrixX3d centered = all_points.rowwise() - mean;
+  Eigen::Matrix3d covariance = centered.transpose() * centered / static_cast<double>(nr_points);
+  ASSERT_TRUE(merged.getMean().cast<double>().isApprox(mean.transpose(), 1e-6));
+  ASSERT_TRUE(merged.getCovariance().cast<double>().isApprox(covariance, 1e-4));
+  Eigen::Vector3d expected_normal = Eigen::Vector3d(0.1, 0, -1).normalized();
+  ASSERT_GT(std::abs(merged.getNormal().cast<double>().dot(expected_normal)), 1 - 1e-6);
+  // Noise variance along normal, cancellation of raw second moments would exceed it by orders of magnitude
+  ASSERT_NEAR(merged.getMSE(), kSigma * kSigma * expected_normal.z() * expected_normal.z(), 0.2);
+}
+
+TEST(PlaneCovariance, EmptyStat) { ASSERT_TRUE(CellSegmentStat().getParameterCovariance(0, 1).isZero()); }
+}  // namespace
+}  // namespace deplex
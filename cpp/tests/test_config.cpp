@@ -27,5 +27,34 @@ TEST(ConfigInit, MissingParameters) {
   auto config = config::Config(test_globals::invalid::missing_params_config);
   ASSERT_EQ(config.depth_sigma_coeff, config::Config().depth_sigma_coeff);
 }
+
+TEST(ConfigInit, ParameterMap) {
+  auto config = config::Config({{"patchSize", "12"}, {"ransacRefinement", "1"}, {"maxMergeDist", "250.5"}});
+  ASSERT_EQ(config.patch_size, 12);
+  ASSERT_TRUE(config.ransac_refinement);
+  ASSERT_FLOAT_EQ(config.max_merge_dist, 250.5);
+  ASSERT_EQ(config.histogram_bins_per_coord, config::Config().histogram_bins_per_coord);
+}
+
+TEST(ConfigInit, InvalidParameterValue) {
+  std::unordered_map<std::string, std::string> param_map{{"patchSize", "ten"}};
+  ASSERT_THROW(config::Config{param_map}, std::invalid_argument);
+}
+
+TEST(ConfigInit, CellOrder) {
+  std::unordered_map<std::string, std::string> param_map{{"cellOrder", "morton"}};
+  ASSERT_EQ(config::Config{param_map}.cell_order, config::CellOrder::kMorton);
+  param_map["cellOrder"] = "hilbert";
+  ASSERT_THROW(config::Config{param_map}, std::runtime_error);
+}
+
+TEST(ConfigInit, RobustLoss) {
+  std::unordered_map<std::string, std::string> param_map{{"robustLoss", "tukey"}, {"robustRefitIterations", "5"}};
+  config::Config config{param_map};
+  ASSERT_EQ(config.robust_loss, config::RobustLoss::kTukey);
+  ASSERT_EQ(config.robust_refit_iterations, 5);
+  param_map["robustLoss"] = "cauchy";
+  ASSERT_THROW(config::Config{param_map}, std::runtime_error);
+}
 }  // namespace
 }  // namespace deplex
\ No newline at end of file
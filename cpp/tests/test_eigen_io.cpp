@@ -0,0 +1,69 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <deplex/utils/eigen_io.h>
+
+#include "globals.hpp"
+
+namespace deplex {
+namespace {
+TEST(LabelsBinary, SaveAndRead) {
+  Eigen::VectorXi labels = Eigen::VectorXi::LinSpaced(6, 0, 5);
+  utils::saveLabelsBinary(labels, 2, 3, "test_labels.labels");
+
+  int32_t height = 0, width = 0;
+  auto read_labels = utils::readLabelsBinary("test_labels.labels", &height, &width);
+  std::remove("test_labels.labels");
+  ASSERT_EQ(height, 2);
+  ASSERT_EQ(width, 3);
+  ASSERT_EQ(read_labels, labels);
+}
+
+TEST(LabelsBinary, CompleteFile) {
+  utils::saveLabelsBinary(Eigen::VectorXi::Zero(6), 2, 3, "test_labels.labels");
+  ASSERT_TRUE(utils::isLabelsBinaryComplete("test_labels.labels"));
+  // Truncated file
+  std::string contents;
+  {
+    std::ifstream file("test_labels.labels", std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  std::ofstream("test_labels.labels", std::ios::binary).write(contents.data(), 20);
+  ASSERT_FALSE(utils::isLabelsBinaryComplete("test_labels.labels"));
+  // File of the right size, but wrong signature
+  contents[0] = 'X';
+  std::ofstream("test_labels.labels", std::ios::binary).write(contents.data(), contents.size());
+  ASSERT_FALSE(utils::isLabelsBinaryComplete("test_labels.labels"));
+  std::remove("test_labels.labels");
+  ASSERT_FALSE(utils::isLabelsBinaryComplete("test_labels.labels"));
+}
+
+TEST(LabelsBinary, WrongShape) {
+  ASSERT_THROW(utils::saveLabelsBinary(Eigen::VectorXi::Zero(5), 2, 3, "test_labels.labels"), std::runtime_error);
+}
+
+TEST(LabelsBinary, InvalidFile) {
+  ASSERT_THROW(utils::readLabelsBinary("__INVALID_PATH"), std::runtime_error);
+  ASSERT_THROW(utils::readLabelsBinary(test_globals::tum::config), std::runtime_error);
+}
+}  // namespace
+}  // namespace deplex
@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include <deplex/extractor_pool.h>
+#include <deplex/utils/depth_image.h>
+#include <deplex/utils/eigen_io.h>
+
+#include "globals.hpp"
+
+namespace deplex {
+namespace {
+TEST(ExtractorPool, ReuseWarmExtractor) {
+  ExtractorPool pool;
+  PlaneExtractor* first_extractor;
+  {
+    auto lease = pool.acquire(480, 640);
+    first_extractor = &*lease;
+    ASSERT_EQ(pool.size(), 0);
+  }
+  ASSERT_EQ(pool.size(), 1);
+  auto lease = pool.acquire(480, 640);
+  ASSERT_EQ(&*lease, first_extractor);
+  ASSERT_EQ(pool.size(), 0);
+}
+
+TEST(ExtractorPool, KeyedByShapeAndConfig) {
+  ExtractorPool pool;
+  config::Config config;
+  config.patch_size = 20;
+  {
+    auto vga = pool.acquire(480, 640);
+    auto qvga = pool.acquire(240, 320);
+    auto vga_coarse = pool.acquire(480, 640, config);
+    ASSERT_NE(&*vga, &*vga_coarse);
+  }
+  ASSERT_EQ(pool.size(), 3);
+  auto lease = pool.acquire(480, 640, config);
+  ASSERT_EQ(pool.size(), 2);
+}
+
+TEST(ExtractorPool, MemoryLimitEviction) {
+  size_t vga_workspace = PlaneExtractor(480, 640).getWorkspaceSize();
+  ExtractorPool pool(vga_workspace + vga_workspace / 2);
+  {
+    auto vga = pool.acquire(480, 640);
+  }
+  ASSERT_EQ(pool.getMemoryUsage(), vga_workspace);
+  config::Config config;
+  config.patch_size = 20;
+  {
+    // Idle VGA extractor is evicted to fit the new one
+    auto vga_coarse = pool.acquire(480, 640, config);
+  }
+  ASSERT_EQ(pool.size(), 1);
+  ASSERT_LE(pool.getMemoryUsage(), vga_workspace + vga_workspace / 2);
+  pool.clear();
+  ASSERT_EQ(pool.getMemoryUsage(), 0);
+}
+
+TEST(ExtractorPool, ReleaseResetsSettings) {
+  auto image = utils::DepthImage(test_globals::tum::sample_image);
+  auto points = image.toPointCloud(utils::readIntrinsics(test_globals::tum::intrinsics));
+  ExtractorPool pool;
+  int32_t nr_hook_calls = 0;
+  {
+    auto lease = pool.acquire(image.getHeight(), image.getWidth());
+    lease->setIntrinsics(utils::readIntrinsics(test_globals::tum::intrinsics));
+    lease->setStageEnabled(PipelineStage::kMerge, false);
+    lease->addStageHook(PipelineStage::kLabels, [&nr_hook_calls](Eigen::Ref<const Eigen::MatrixX3f> const&,
+                                                                 PipelineFrame*) { ++nr_hook_calls; });
+    lease->processAsync(std::make_shared<const Eigen::MatrixX3f>(points));
+  }
+  ASSERT_EQ(nr_hook_calls, 1);
+  auto lease = pool.acquire(image.getHeight(), image.getWidth());
+  ASSERT_TRUE(lease->isStageEnabled(PipelineStage::kMerge));
+  for (double stage_time : lease->getStageTimings()) {
+    ASSERT_EQ(stage_time, 0);
+  }
+  ASSERT_EQ(lease->process(points), PlaneExtractor(image.getHeight(), image.getWidth()).process(points));
+  ASSERT_EQ(nr_hook_calls, 1);
+}
+
+TEST(ExtractorPool, SameResultAsExtractor) {
+  auto image = utils::DepthImage(test_globals::tum::sample_image);
+  auto points = image.toPointCloud(utils::readIntrinsics(test_globals::tum::intrinsics));
+  ExtractorPool pool;
+  for (int i = 0; i < 2; ++i) {
+    auto lease = pool.acquire(image.getHeight(), image.getWidth());
+    ASSERT_EQ(lease->process(points), PlaneExtractor(image.getHeight(), image.getWidth()).process(points));
+  }
+}
+}  // namespace
+}  // namespace deplex
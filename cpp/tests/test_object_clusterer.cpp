@@ -0,0 +1,65 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include <deplex/object_clusterer.h>
+#include <deplex/plane_extractor.h>
+
+#include "test_scenes.h"
+
+namespace deplex {
+namespace {
+TEST(ObjectClusterer, BoxesOnFloor) {
+  auto width = 640, height = 480;
+  auto points = test_scenes::makeFloorWithBoxes(height, width);
+  auto config = config::Config();
+  config.compute_geometry = true;
+  auto result = PlaneExtractor(height, width, config).extract(points);
+  auto floor_label = result.labels[0];
+
+  ObjectClusterer clusterer(height, width);
+  auto objects = clusterer.cluster(points, result, floor_label, 10, 500);
+  ASSERT_EQ(objects.size(), 2);
+  ASSERT_EQ(objects[0].pixels.size(), 40 * 60);
+  ASSERT_EQ(objects[0].pixels.front(), 300 * width + 200);
+  ASSERT_EQ(objects[1].pixels.size(), 40 * 30);
+  ASSERT_TRUE(std::is_sorted(objects[0].pixels.begin(), objects[0].pixels.end()));
+
+  // Boxes span from floor to object top
+  ASSERT_NEAR(objects[0].box.half_extents.z(), 50, 1);
+  ASSERT_NEAR(objects[1].box.half_extents.z(), 25, 1);
+  ASSERT_TRUE(objects[0].box.center.isApprox(Eigen::Vector3f(1147.5, 950, 2597.5), 1e-2));
+
+  // Objects lower than min height are ignored
+  ASSERT_EQ(clusterer.cluster(points, result, floor_label, 60, 500).size(), 1);
+  // Objects smaller than min cluster size are ignored
+  ASSERT_EQ(ObjectClusterer(height, width, 160, 2000).cluster(points, result, floor_label, 10, 500).size(), 1);
+}
+
+TEST(ObjectClusterer, InvalidInput) {
+  auto width = 640, height = 480;
+  auto points = test_scenes::makeFloorWithBoxes(height, width);
+  auto result = PlaneExtractor(height, width).extract(points);
+  ObjectClusterer clusterer(height, width);
+  ASSERT_THROW(clusterer.cluster(points, result, result.labels[0], 10, 500), std::runtime_error);
+  ASSERT_THROW(clusterer.cluster(points, result, 1000, 10, 500), std::runtime_error);
+  ASSERT_THROW(ObjectClusterer(height / 2, width).cluster(points, result, result.labels[0], 10, 500),
+               std::runtime_error);
+}
+}  // namespace
+}  // namespace deplex
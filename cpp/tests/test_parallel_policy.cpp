@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <deplex/parallel_policy.h>
+
+namespace deplex {
+namespace {
+TEST(ParallelPolicy, SmallWorkIsSerial) {
+  auto schedule = ParallelPolicy::global().getSchedule(ParallelStage::kImageLabels, 4, 4);
+  ASSERT_EQ(schedule.nr_threads, 1);
+  ASSERT_GE(schedule.grain_size, 1);
+}
+
+TEST(ParallelPolicy, ScheduleCoversAllItems) {
+  int64_t nr_items = 1 << 16;
+  auto schedule = ParallelPolicy::global().getSchedule(ParallelStage::kCellStatistics, nr_items, 100);
+  ASSERT_GE(schedule.nr_threads, 1);
+  ASSERT_GE(schedule.grain_size, 1);
+  ASSERT_LE(static_cast<int64_t>(schedule.grain_size) * schedule.nr_threads, nr_items + schedule.nr_threads);
+}
+
+TEST(ParallelPolicy, ForceSerial) {
+  ParallelPolicy::setForceSerial(true);
+  auto schedule = ParallelPolicy::global().getSchedule(ParallelStage::kCellStatistics, 1 << 16, 100);
+  ParallelPolicy::setForceSerial(false);
+  ASSERT_EQ(schedule.nr_threads, 1);
+}
+
+TEST(ParallelPolicy, RecordedTimeUpdatesCost) {
+  // Local cost model keeps global schedules of other tests intact
+  ParallelPolicy policy;
+  float initial_cost = policy.getPixelCost(ParallelStage::kCellOrganize);
+  policy.recordStageTime(ParallelStage::kCellOrganize, {1, 1}, 1000, 1000 * initial_cost * 10);
+  ASSERT_GT(policy.getPixelCost(ParallelStage::kCellOrganize), initial_cost);
+}
+
+TEST(ParallelPolicy, SublinearScalingLimitsThreads) {
+  ParallelPolicy policy;
+  int64_t nr_items = 1 << 16;
+  auto stage = ParallelStage::kCellStatistics;
+  float pixel_cost = policy.getPixelCost(stage);
+  auto schedule = policy.getSchedule(stage, nr_items, 100);
+
+  // Four threads taking as long as one: per-pixel cost stays, parallel stage is modelled as serial work
+  for (int32_t i = 0; i < 50; ++i) {
+    policy.recordStageTime(stage, {4, 1}, nr_items * 100, nr_items * 100 * pixel_cost + 1e9);
+  }
+  ASSERT_EQ(policy.getPixelCost(stage), pixel_cost);
+  ASSERT_GT(policy.getSerialFraction(stage), 0.99);
+  auto limited_schedule = policy.getSchedule(stage, nr_items, 100);
+  ASSERT_LE(limited_schedule.nr_threads, schedule.nr_threads);
+  ASSERT_EQ(limited_schedule.nr_threads, 1);
+
+  // Serial runs let parallelism be retried
+  for (int32_t i = 0; i < 100; ++i) {
+    policy.recordStageTime(stage, {1, 1}, nr_items * 100, nr_items * 100 * pixel_cost);
+  }
+  ASSERT_LT(policy.getSerialFraction(stage), 0.1);
+}
+}  // namespace
+}  // namespace deplex
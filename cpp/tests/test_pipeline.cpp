@@ -0,0 +1,177 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <deplex/config.h>
+#include <deplex/pipeline.h>
+#include <deplex/plane_extractor.h>
+#include <deplex/utils/depth_image.h>
+#include <deplex/utils/eigen_io.h>
+
+#include "globals.hpp"
+#include "test_scenes.h"
+
+namespace deplex {
+namespace {
+
+TEST(Pipeline, StageTimings) {
+  auto config = config::Config(test_globals::tum::config);
+  auto image = utils::DepthImage(test_globals::tum::sample_image);
+  auto points = image.toPointCloud(utils::readIntrinsics(test_globals::tum::intrinsics));
+  auto algorithm = PlaneExtractor(image.getHeight(), image.getWidth(), config);
+  auto timings = algorithm.getStageTimings();
+  ASSERT_EQ(timings.size(), kNrPipelineStages);
+  ASSERT_TRUE(std::all_of(timings.begin(), timings.end(), [](double time) { return time == 0; }));
+
+  auto labels = algorithm.process(points);
+  timings = algorithm.getStageTimings();
+  ASSERT_EQ(timings.size(), kNrPipelineStages);
+  ASSERT_GT(timings[static_cast<size_t>(PipelineStage::kCellGrid)], 0);
+  ASSERT_TRUE(std::all_of(timings.begin(), timings.end(), [](double time) { return time >= 0; }));
+
+  // Pass-through hooks at every stage don't change result
+  int32_t nr_calls = 0;
+  for (size_t stage = 0; stage < kNrPipelineStages; ++stage) {
+    algorithm.addStageHook(static_cast<PipelineStage>(stage),
+                           [&nr_calls](Eigen::Ref<const Eigen::MatrixX3f> const&, PipelineFrame*) { ++nr_calls; });
+  }
+  ASSERT_TRUE(algorithm.process(points) == labels);
+  ASSERT_EQ(nr_calls, kNrPipelineStages);
+  algorithm.clearStageHooks();
+  algorithm.process(points);
+  ASSERT_EQ(nr_calls, kNrPipelineStages);
+}
+
+TEST(Pipeline, SkipPixelLabels) {
+  auto config = config::Config(test_globals::tum::config);
+  auto image = utils::DepthImage(test_globals::tum::sample_image);
+  auto points = image.toPointCloud(utils::readIntrinsics(test_globals::tum::intrinsics));
+  auto algorithm = PlaneExtractor(image.getHeight(), image.getWidth(), config);
+  auto expected = algorithm.extract(points);
+
+  algorithm.setStageEnabled(PipelineStage::kLabels, false);
+  ASSERT_FALSE(algorithm.isStageEnabled(PipelineStage::kLabels));
+  auto result = algorithm.extract(points);
+  ASSERT_EQ(result.labels.size(), 0);
+  ASSERT_EQ(result.planes.size(), expected.planes.size());
+  for (size_t i = 0; i < result.planes.size(); ++i) {
+    ASSERT_EQ(result.planes[i].label, expected.planes[i].label);
+    ASSERT_TRUE(result.planes[i].normal.isApprox(expected.planes[i].normal));
+  }
+
+  algorithm.setStageEnabled(PipelineStage::kLabels, true);
+  ASSERT_TRUE(algorithm.process(points) == expected.labels);
+  ASSERT_THROW(algorithm.setStageEnabled(PipelineStage::kCellGrid, false), std::runtime_error);
+}
+
+TEST(Pipeline, ReplaceRegionGrowing) {
+  auto width = 640, height = 480;
+  auto points = test_scenes::makeTwoWalls(height, width);
+  auto algorithm = PlaneExtractor(height, width);
+  ASSERT_EQ(algorithm.extract(points).planes.size(), 2);
+
+  // Custom region growing: every planar cell of upper half is one segment
+  algorithm.setStageEnabled(PipelineStage::kRegionGrowing, false);
+  algorithm.addStageHook(PipelineStage::kRegionGrowing,
+                         [](Eigen::Ref<const Eigen::MatrixX3f> const&, PipelineFrame* frame) {
+                           ASSERT_TRUE(frame->cell_segments.isZero());
+                           for (int32_t row = 0; row < frame->nr_cell_rows / 2; ++row) {
+                             for (int32_t col = 0; col < frame->nr_cell_cols; ++col) {
+                               bool is_planar = frame->cell_planar[row * frame->nr_cell_cols + col];
+                               frame->cell_segments(row, col) = (is_planar ? 7 : 0);
+                             }
+                           }
+                         });
+  auto result = algorithm.extract(points);
+  ASSERT_EQ(result.planes.size(), 1);
+  ASSERT_EQ(result.planes[0].label, 1);
+  ASSERT_EQ(result.labels[0], 1);
+  ASSERT_EQ(result.labels[(height - 1) * width], 0);
+}
+
+TEST(Pipeline, ReplaceCandidatesAndMerge) {
+  auto width = 640, height = 480;
+  auto points = test_scenes::makeTwoWalls(height, width);
+  auto algorithm = PlaneExtractor(height, width);
+
+  // Only cells of left wall may seed and join planes
+  algorithm.addStageHook(PipelineStage::kCandidateSelection,
+                         [](Eigen::Ref<const Eigen::MatrixX3f> const&, PipelineFrame* frame) {
+                           for (int32_t row = 0; row < frame->nr_cell_rows; ++row) {
+                             for (int32_t col = frame->nr_cell_cols / 2; col < frame->nr_cell_cols; ++col) {
+                               frame->candidate_cells[row * frame->nr_cell_cols + col] = false;
+                             }
+                           }
+                         });
+  auto result = algorithm.extract(points);
+  ASSERT_EQ(result.planes.size(), 1);
+  ASSERT_NEAR(result.planes[0].mean.z(), 2000, 1);
+  ASSERT_EQ(result.labels[width - 1], 0);
+
+  // Merge everything into one plane
+  algorithm.clearStageHooks();
+  algorithm.addStageHook(PipelineStage::kMerge, [](Eigen::Ref<const Eigen::MatrixX3f> const&, PipelineFrame* frame) {
+    frame->cell_labels = (frame->cell_labels.array() > 0).cast<int>();
+  });
+  result = algorithm.extract(points);
+  ASSERT_EQ(result.planes.size(), 1);
+  ASSERT_EQ(result.labels[0], 1);
+  ASSERT_EQ(result.labels[width - 1], 1);
+
+  algorithm.clearStageHooks();
+  algorithm.addStageHook(PipelineStage::kMerge, [](Eigen::Ref<const Eigen::MatrixX3f> const&, PipelineFrame* frame) {
+    frame->cell_labels.resize(1, 1);
+  });
+  ASSERT_THROW(algorithm.extract(points), std::runtime_error);
+}
+
+TEST(Pipeline, RejectUnknownLabels) {
+  auto width = 640, height = 480;
+  auto points = test_scenes::makeTwoWalls(height, width);
+  auto algorithm = PlaneExtractor(height, width);
+  auto nr_planes = static_cast<int32_t>(algorithm.extract(points).planes.size());
+
+  for (int32_t label : {nr_planes + 100, -1}) {
+    algorithm.clearStageHooks();
+    algorithm.addStageHook(PipelineStage::kRefinement,
+                           [label](Eigen::Ref<const Eigen::MatrixX3f> const&, PipelineFrame* frame) {
+                             frame->result.labels[0] = label;
+                           });
+    ASSERT_THROW(algorithm.extract(points), std::runtime_error);
+  }
+
+  // Plane of an empty cell only has no statistics
+  auto empty_points = test_scenes::makeNoisyWallWithHoles(height, width);
+  algorithm.clearStageHooks();
+  algorithm.addStageHook(PipelineStage::kRegionGrowing,
+                         [](Eigen::Ref<const Eigen::MatrixX3f> const&, PipelineFrame* frame) {
+                           frame->cell_segments(20, 30) = frame->cell_segments.maxCoeff() + 1;
+                         });
+  ASSERT_THROW(algorithm.extract(empty_points), std::runtime_error);
+
+  // Relabelling pixels to another existing plane is allowed
+  algorithm.clearStageHooks();
+  algorithm.addStageHook(PipelineStage::kLabels, [](Eigen::Ref<const Eigen::MatrixX3f> const&, PipelineFrame* frame) {
+    frame->result.labels[frame->result.labels.size() - 1] = frame->result.labels[0];
+  });
+  auto result = algorithm.extract(points);
+  ASSERT_EQ(result.labels[result.labels.size() - 1], result.labels[0]);
+}
+}  // namespace
+}  // namespace deplex
@@ -15,12 +15,18 @@
  */
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <set>
+
 #include <deplex/config.h>
 #include <deplex/plane_extractor.h>
 #include <deplex/utils/depth_image.h>
 #include <deplex/utils/eigen_io.h>
 
 #include "globals.hpp"
+#include "test_scenes.h"
 
 namespace deplex {
 namespace {
@@ -32,6 +38,17 @@ TEST(TUMPlaneExtraction, DefaultConfigExtraction) {
   ASSERT_EQ(labels.maxCoeff(), 34);
 }
 
+TEST(TUMPlaneExtraction, ParallelCalibrationKeepsLabels) {
+  auto config = config::Config(test_globals::tum::config);
+  auto image = utils::DepthImage(test_globals::tum::sample_image);
+  auto points = image.toPointCloud(utils::readIntrinsics(test_globals::tum::intrinsics));
+  auto expected_labels = PlaneExtractor(image.getHeight(), image.getWidth(), config).process(points);
+
+  config.parallel_calibration = true;
+  auto algorithm = PlaneExtractor(image.getHeight(), image.getWidth(), config);
+  ASSERT_EQ(algorithm.process(points), expected_labels);
+}
+
 TEST(TUMPlaneExtraction, ZeroLeadingConfigExtraction) {
   auto config = config::Config(test_globals::tum::config);
   config.min_region_planarity_score = 5000;
@@ -64,6 +81,317 @@ TEST(TUMPlaneExtraction, EnormousPatchSize) {
   ASSERT_EQ(points.rows(), labels.size());
 }
 
+TEST(ImageShape, NotMultipleOfPatchSize) {
+  // Default patch size is 10, trailing 7 rows and 5 columns belong to no cell
+  auto width = 645, height = 487;
+  auto cell_width = 640, cell_height = 480;
+  auto points = test_scenes::makeTwoWalls(height, width);
+  Eigen::MatrixX3f cell_points(cell_height * cell_width, 3);
+  for (int32_t row = 0; row < cell_height; ++row) {
+    cell_points.middleRows(row * cell_width, cell_width) = points.middleRows(row * width, cell_width);
+  }
+  auto expected_labels = PlaneExtractor(cell_height, cell_width).process(cell_points);
+
+  auto labels = PlaneExtractor(height, width).process(points);
+  ASSERT_EQ(labels.size(), points.rows());
+  for (int32_t row = 0; row < height; ++row) {
+    for (int32_t col = 0; col < width; ++col) {
+      int32_t expected = (row < cell_height && col < cell_width ? expected_labels[row * cell_width + col] : 0);
+      ASSERT_EQ(labels[row * width + col], expected) << row << ", " << col;
+    }
+  }
+  ASSERT_GT(labels.maxCoeff(), 0);
+}
+
+TEST(GravityPrior, RejectsSlopedPlanes) {
+  auto width = 640, height = 480;
+  auto algorithm = PlaneExtractor(height, width);
+  auto points = test_scenes::makeSlopeAndFloor(height, width);
+  ASSERT_EQ(algorithm.process(points).maxCoeff(), 2);
+
+  auto labels = algorithm.process(points, Eigen::Vector3f(0, 9.81, 0));
+  ASSERT_EQ(labels.maxCoeff(), 1);
+  ASSERT_TRUE(labels.head(height / 2 * width).isZero());
+}
+
+TEST(GravityPrior, SnapToTiltedGravity) {
+  auto width = 640, height = 480;
+  auto config = config::Config();
+  config.gravity_snap = true;
+  auto algorithm = PlaneExtractor(height, width, config);
+  auto labels = algorithm.process(test_scenes::makeSlopeAndFloor(height, width), Eigen::Vector3f(0.05, 1, 0));
+  ASSERT_EQ(labels.maxCoeff(), 1);
+}
+
+TEST(GravityPrior, ZeroGravity) {
+  auto width = 640, height = 480;
+  auto algorithm = PlaneExtractor(height, width);
+  auto points = test_scenes::makeSlopeAndFloor(height, width);
+  ASSERT_THROW(algorithm.process(points, Eigen::Vector3f::Zero()), std::runtime_error);
+}
+
+TEST(ExtractionResult, PlanesMatchLabels) {
+  auto image = utils::DepthImage(test_globals::tum::sample_image);
+  auto algorithm = PlaneExtractor(image.getHeight(), image.getWidth());
+  auto result = algorithm.extract(image.toPointCloud(utils::readIntrinsics(test_globals::tum::intrinsics)));
+
+  std::set<int32_t> labels(result.labels.data(), result.labels.data() + result.labels.size());
+  labels.erase(0);
+  std::set<int32_t> plane_labels;
+  for (auto const& plane : result.planes) {
+    plane_labels.insert(plane.label);
+    ASSERT_NEAR(plane.normal.norm(), 1, 1e-4);
+    ASSERT_GT(plane.d, 0);
+    ASSERT_GT(plane.nr_points, 0);
+    ASSERT_EQ(plane.manhattan_axis, -1);
+    ASSERT_GT(plane.covariance(3, 3), 0);
+    ASSERT_TRUE(plane.covariance.isApprox(plane.covariance.transpose()));
+    // Normal error is orthogonal to normal
+    Eigen::Matrix3f normal_cov = plane.covariance.topLeftCorner(3, 3);
+    ASSERT_LT((normal_cov * plane.normal).norm(), 1e-3 * normal_cov.norm());
+  }
+  ASSERT_EQ(labels, plane_labels);
+  ASSERT_FALSE(result.has_manhattan_frame);
+}
+
+TEST(ExtractionResult, PixelIndex) {
+  auto config = config::Config();
+  auto image = utils::DepthImage(test_globals::tum::sample_image);
+  auto points = image.toPointCloud(utils::readIntrinsics(test_globals::tum::intrinsics));
+  ASSERT_TRUE(PlaneExtractor(image.getHeight(), image.getWidth(), config).extract(points).plane_pixels.empty());
+
+  config.pixel_index = true;
+  auto result = PlaneExtractor(image.getHeight(), image.getWidth(), config).extract(points);
+  ASSERT_EQ(result.plane_offsets.size(), result.planes.size() + 1);
+  ASSERT_EQ(result.plane_offsets.front(), 0);
+  ASSERT_EQ(result.plane_offsets.back(), result.plane_pixels.size());
+  ASSERT_EQ(result.plane_pixels.size(), (result.labels.array() != 0).count());
+  for (size_t plane_id = 0; plane_id < result.planes.size(); ++plane_id) {
+    auto begin = result.plane_pixels.begin() + result.plane_offsets[plane_id];
+    auto end = result.plane_pixels.begin() + result.plane_offsets[plane_id + 1];
+    ASSERT_TRUE(std::is_sorted(begin, end));
+    for (auto pixel = begin; pixel != end; ++pixel) {
+      ASSERT_EQ(result.labels[*pixel], result.planes[plane_id].label);
+    }
+  }
+}
+
+TEST(ManhattanMode, AxesAssigned) {
+  auto config = config::Config();
+  config.manhattan_mode = true;
+  auto image = utils::DepthImage(test_globals::tum::sample_image);
+  auto algorithm = PlaneExtractor(image.getHeight(), image.getWidth(), config);
+  auto result = algorithm.extract(image.toPointCloud(utils::readIntrinsics(test_globals::tum::intrinsics)));
+
+  ASSERT_TRUE(result.has_manhattan_frame);
+  ASSERT_TRUE((result.manhattan_frame.transpose() * result.manhattan_frame).isIdentity(1e-4));
+  ASSERT_FALSE(result.planes.empty());
+  for (auto const& plane : result.planes) {
+    ASSERT_GE(plane.manhattan_axis, 0);
+    ASSERT_LT(plane.manhattan_axis, 3);
+  }
+}
+
+TEST(ManhattanMode, GravityAxis) {
+  auto width = 640, height = 480;
+  auto config = config::Config();
+  config.manhattan_mode = true;
+  auto algorithm = PlaneExtractor(height, width, config);
+  auto result = algorithm.extract(test_scenes::makeSlopeAndFloor(height, width), Eigen::Vector3f(0, 1, 0));
+
+  ASSERT_TRUE(result.has_manhattan_frame);
+  ASSERT_TRUE(result.manhattan_frame.col(0).isApprox(Eigen::Vector3f(0, 1, 0)));
+  ASSERT_EQ(result.planes.size(), 1);
+  ASSERT_EQ(result.planes[0].manhattan_axis, 0);
+  ASSERT_TRUE(result.planes[0].normal.isApprox(Eigen::Vector3f(0, -1, 0), 1e-3));
+  ASSERT_NEAR(result.planes[0].d, 1000, 1);
+}
+
+TEST(GlobalMerge, SplitFloor) {
+  auto width = 640, height = 480;
+  auto points = test_scenes::makeSlopeAndFloor(height, width);
+  // Object without depth splits floor into left and right parts
+  for (int32_t row = height / 2; row < height; ++row) {
+    points.block(row * width + 280, 0, 80, 3).setZero();
+  }
+  ASSERT_EQ(PlaneExtractor(height, width).extract(points).planes.size(), 3);
+
+  auto config = config::Config();
+  config.global_merge = true;
+  auto result = PlaneExtractor(height, width, config).extract(points);
+  ASSERT_EQ(result.planes.size(), 2);
+  auto floor_label = result.labels[(height - 1) * width];
+  ASSERT_NE(floor_label, 0);
+  ASSERT_EQ(result.labels[height * width - 1], floor_label);
+}
+
+TEST(GlobalMerge, FarTiltedParts) {
+  auto width = 640, height = 480;
+  // Left part lies on plane z = 8000, right part is tilted by 15 degrees around its own mean, which lies on
+  // the same plane. Their offsets differ by several buckets, although merge criteria hold.
+  float const tilt = 15 * static_cast<float>(M_PI) / 180;
+  Eigen::Vector3f right_mean(2000, 0, 8000);
+  Eigen::Vector3f right_axis(std::cos(tilt), 0, -std::sin(tilt));
+  Eigen::MatrixX3f points = Eigen::MatrixX3f::Zero(height * width, 3);
+  for (int32_t row = 0; row < height; ++row) {
+    for (int32_t col = 0; col < width; ++col) {
+      float y = (row - height / 2) * 20.f;
+      if (col < 280) {
+        points.row(row * width + col) << col * 20.f - 6000, y, 8000;
+      } else if (col >= 360) {
+        points.row(row * width + col) = right_mean + (col - 500) * 20.f * right_axis + Eigen::Vector3f(0, y, 0);
+      }
+    }
+  }
+  ASSERT_EQ(PlaneExtractor(height, width).extract(points).planes.size(), 2);
+
+  auto config = config::Config();
+  config.global_merge = true;
+  auto result = PlaneExtractor(height, width, config).extract(points);
+  ASSERT_EQ(result.planes.size(), 1);
+  ASSERT_EQ(result.labels[0], result.labels[width - 1]);
+}
+
+TEST(CellConnectivity, DiagonalCells) {
+  auto width = 200, height = 200;
+  auto patch_size = config::Config().patch_size;
+  // Wall with depth only in cells on the main diagonal, which touch each other by corners
+  Eigen::MatrixX3f points = Eigen::MatrixX3f::Zero(height * width, 3);
+  for (int32_t row = 0; row < height; ++row) {
+    for (int32_t col = 0; col < width; ++col) {
+      if (row / patch_size == col / patch_size) {
+        points.row(row * width + col) << col * 5.f, row * 5.f, 1000;
+      }
+    }
+  }
+  ASSERT_EQ(PlaneExtractor(height, width).extract(points).planes.size(), 0);
+
+  auto config = config::Config();
+  config.cell_connectivity = 8;
+  auto result = PlaneExtractor(height, width, config).extract(points);
+  ASSERT_EQ(result.planes.size(), 1);
+  ASSERT_NE(result.labels[0], 0);
+  ASSERT_EQ(result.labels[height * width - 1], result.labels[0]);
+
+  config.cell_connectivity = 6;
+  ASSERT_THROW(PlaneExtractor(height, width, config), std::runtime_error);
+}
+
+TEST(PlaneGeometry, FloorDescriptors) {
+  auto width = 640, height = 480;
+  auto points = test_scenes::makeSlopeAndFloor(height, width);
+  ASSERT_TRUE(PlaneExtractor(height, width).extract(points).planes[0].contours.empty());
+
+  auto config = config::Config();
+  config.compute_geometry = true;
+  auto result = PlaneExtractor(height, width, config).extract(points);
+  ASSERT_EQ(result.planes.size(), 2);
+  auto floor = std::find_if(result.planes.begin(), result.planes.end(),
+                            [](PlaneModel const& plane) { return std::abs(plane.normal.y()) > 0.99; });
+  ASSERT_NE(floor, result.planes.end());
+
+  // Floor covers 3200 x 1200 points, polygon passes through centers of boundary cells (50 x 50)
+  ASSERT_NEAR(floor->area, 3200 * 1200, 3200 * 1200 * 0.02);
+  ASSERT_EQ(floor->contours.size(), 1);
+  ASSERT_EQ(floor->convex_hull.size(), 4);
+  for (auto const& point : floor->convex_hull) {
+    ASSERT_NEAR(point.y(), 1000, 1e-1);
+  }
+  ASSERT_NEAR(std::abs(floor->box.axes.col(0).x()), 1, 1e-3);
+  ASSERT_NEAR(floor->box.half_extents.x(), 1575, 5);
+  ASSERT_NEAR(floor->box.half_extents.y(), 575, 5);
+  ASSERT_NEAR(floor->box.center.x(), 1597.5, 5);
+  ASSERT_NEAR(floor->box.center.z(), 2797.5, 5);
+}
+
+TEST(DenoisePoints, SnapsAndFillsWall) {
+  auto width = 640, height = 480;
+  Eigen::Matrix3f intrinsics = test_scenes::getIntrinsics(height, width);
+  // Noisy wall with one empty cell and one partially empty cell
+  auto points = test_scenes::makeNoisyWallWithHoles(height, width);
+  auto empty_cell_pixel = 205 * width + 305;
+  auto partial_cell_pixel = 102 * width + 102;
+
+  auto config = config::Config();
+  config.denoise_points = true;
+  // Partially empty cell fails planarity test, its valid pixels are labelled by boundary refinement
+  config.boundary_refinement = true;
+  auto algorithm = PlaneExtractor(height, width, config);
+  auto result = algorithm.extract(points);
+  ASSERT_EQ(result.points.rows(), points.rows());
+  ASSERT_EQ(result.labels[empty_cell_pixel], 0);
+  ASSERT_TRUE(result.points.row(empty_cell_pixel).isZero());
+  ASSERT_NEAR(result.points(0, 2), 2000, 0.5);
+  ASSERT_NEAR(result.points(1, 2), 2000, 0.5);
+
+  algorithm.setIntrinsics(intrinsics);
+  result = algorithm.extract(points);
+  auto wall_label = result.labels[0];
+  ASSERT_NE(wall_label, 0);
+  ASSERT_TRUE((result.labels.array() == wall_label).all());
+  ASSERT_TRUE(((result.points.col(2).array() - 2000).abs() < 0.5).all());
+  Eigen::Vector3f filled_point(-60, -140, 2000);
+  ASSERT_TRUE(result.points.row(empty_cell_pixel).transpose().isApprox(filled_point, 1e-3));
+  ASSERT_NEAR(result.points(partial_cell_pixel, 0), -872, 1);
+  ASSERT_THROW(algorithm.setIntrinsics(Eigen::Matrix3f::Zero()), std::runtime_error);
+}
+
+TEST(ResidualMap, WallResiduals) {
+  auto width = 640, height = 480;
+  // Noisy wall with one empty cell and one partially empty cell
+  auto points = test_scenes::makeNoisyWallWithHoles(height, width);
+  auto empty_cell_pixel = 205 * width + 305;
+  auto partial_cell_pixel = 107 * width + 107;
+
+  auto config = config::Config();
+  config.residual_map = true;
+  auto result = PlaneExtractor(height, width, config).extract(points);
+  ASSERT_EQ(result.planes.size(), 1);
+  ASSERT_EQ(result.residuals.size(), points.rows());
+  ASSERT_TRUE(std::isnan(result.residuals[empty_cell_pixel]));
+  // Unlabelled pixels have no residual unless requested
+  ASSERT_EQ(result.labels[partial_cell_pixel], 0);
+  ASSERT_TRUE(std::isnan(result.residuals[partial_cell_pixel]));
+
+  // Unlabelled pixel gets distance to plane of adjacent cells
+  config.residual_map_unlabelled = true;
+  result = PlaneExtractor(height, width, config).extract(points);
+  ASSERT_TRUE(std::isnan(result.residuals[empty_cell_pixel]));
+  ASSERT_EQ(result.labels[partial_cell_pixel], 0);
+  ASSERT_NEAR(std::abs(result.residuals[partial_cell_pixel]), 3, 0.5);
+  int32_t nr_plane_pixels = 0;
+  for (Eigen::Index i = 0; i < result.labels.size(); ++i) {
+    if (result.labels[i] == 0) continue;
+    ++nr_plane_pixels;
+    Eigen::Vector3f const& normal = result.planes[0].normal;
+    ASSERT_NEAR(result.residuals[i], normal.dot(points.row(i).transpose()) + result.planes[0].d, 1e-2);
+    ASSERT_NEAR(std::abs(result.residuals[i]), 3, 0.5);
+  }
+
+  // Residuals of 3 mm are within 0.5 sigma of depth noise at 2 m
+  auto const& histogram = result.planes[0].residual_histogram;
+  ASSERT_EQ(histogram.size(), kNrResidualBins);
+  ASSERT_EQ(std::accumulate(histogram.begin(), histogram.end(), 0), nr_plane_pixels);
+  ASSERT_EQ(histogram[kNrResidualBins / 2 - 1] + histogram[kNrResidualBins / 2], nr_plane_pixels);
+  ASSERT_GT(histogram[kNrResidualBins / 2 - 1], 0);
+  ASSERT_GT(histogram[kNrResidualBins / 2], 0);
+
+  // Filled holes are labelled without residual and histogram counts measured points only
+  config.denoise_points = true;
+  auto algorithm = PlaneExtractor(height, width, config);
+  algorithm.setIntrinsics(test_scenes::getIntrinsics(height, width));
+  result = algorithm.extract(points);
+  ASSERT_NE(result.labels[empty_cell_pixel], 0);
+  ASSERT_TRUE(std::isnan(result.residuals[empty_cell_pixel]));
+  int32_t nr_measured_pixels = 0;
+  for (Eigen::Index i = 0; i < result.labels.size(); ++i) {
+    nr_measured_pixels += result.labels[i] != 0 && !std::isnan(result.residuals[i]);
+  }
+  ASSERT_LT(nr_measured_pixels, (result.labels.array() != 0).count());
+  auto const& filled_histogram = result.planes[0].residual_histogram;
+  ASSERT_EQ(std::accumulate(filled_histogram.begin(), filled_histogram.end(), 0), nr_measured_pixels);
+}
+
 TEST(InvalidInput, ZeroValuePoints) {
   auto width = 640, height = 480;
   auto algorithm = PlaneExtractor(height, width);
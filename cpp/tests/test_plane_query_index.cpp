@@ -0,0 +1,102 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <deplex/plane_extractor.h>
+#include <deplex/plane_query_index.h>
+#include <deplex/utils/depth_image.h>
+#include <deplex/utils/eigen_io.h>
+
+#include "globals.hpp"
+#include "test_scenes.h"
+
+namespace deplex {
+namespace {
+ExtractionResult extractWithGeometry(Eigen::MatrixX3f const& points, int32_t height, int32_t width) {
+  auto config = config::Config();
+  config.compute_geometry = true;
+  return PlaneExtractor(height, width, config).extract(points);
+}
+
+TEST(PlaneQueryIndex, RequiresGeometry) {
+  auto width = 640, height = 480;
+  auto result = PlaneExtractor(height, width).extract(test_scenes::makeWallAndFloor(height, width));
+  ASSERT_THROW(PlaneQueryIndex index(result), std::runtime_error);
+}
+
+TEST(PlaneQueryIndex, CastRays) {
+  auto width = 640, height = 480;
+  auto result = extractWithGeometry(test_scenes::makeWallAndFloor(height, width), height, width);
+  PlaneQueryIndex index(result);
+  ASSERT_EQ(index.size(), 2);
+  auto wall_label = result.labels[0];
+  auto floor_label = result.labels[height * width - 1];
+
+  Eigen::MatrixX3f origins = Eigen::MatrixX3f::Zero(4, 3);
+  Eigen::MatrixX3f directions(4, 3);
+  directions << 0, 0, 1, 0, 1, 1, 0, 0, -1, 0, 1, 0;
+  auto hits = index.castRays(origins, directions);
+  ASSERT_EQ(hits[0].label, wall_label);
+  ASSERT_NEAR(hits[0].distance, 2000, 1);
+  ASSERT_EQ(hits[1].label, floor_label);
+  ASSERT_TRUE(hits[1].point.isApprox(Eigen::Vector3f(0, 1000, 1000), 1e-2));
+  ASSERT_EQ(hits[2].label, 0);
+  // Floor ends at z = 815
+  ASSERT_EQ(hits[3].label, 0);
+  ASSERT_EQ(index.castRay(Eigen::Vector3f::Zero(), Eigen::Vector3f(0, 0, 1), 1000).label, 0);
+}
+
+TEST(PlaneQueryIndex, AssignPoints) {
+  auto width = 640, height = 480;
+  auto points = test_scenes::makeWallAndFloor(height, width);
+  auto result = extractWithGeometry(points, height, width);
+  PlaneQueryIndex index(result);
+
+  auto labels = index.assignPoints(points, 1);
+  ASSERT_EQ(labels[100 * width + 320], result.labels[0]);
+  ASSERT_EQ(labels[400 * width + 320], result.labels[height * width - 1]);
+  ASSERT_EQ(index.assignPoint(Eigen::Vector3f(0, 100, 1990), 5), 0);
+  ASSERT_EQ(index.assignPoint(Eigen::Vector3f(0, 100, 1990), 20), result.labels[0]);
+  ASSERT_EQ(index.assignPoint(Eigen::Vector3f(5000, 100, 2000), 20), 0);
+}
+
+TEST(PlaneQueryIndex, LabelLookupMatchesBVH) {
+  auto config = config::Config(test_globals::tum::config);
+  config.compute_geometry = true;
+  auto image = utils::DepthImage(test_globals::tum::sample_image);
+  auto intrinsics = utils::readIntrinsics(test_globals::tum::intrinsics);
+  auto points = image.toPointCloud(intrinsics);
+  auto result = PlaneExtractor(image.getHeight(), image.getWidth(), config).extract(points);
+
+  PlaneQueryIndex lookup_index(result, image.getHeight(), image.getWidth(), intrinsics);
+  PlaneQueryIndex bvh_index(result);
+  auto lookup_labels = lookup_index.assignPoints(points, 100);
+  auto bvh_labels = bvh_index.assignPoints(points, 100);
+
+  int32_t nr_labeled = 0, nr_lookup_matches = 0, nr_bvh_matches = 0;
+  for (Eigen::Index i = 0; i < result.labels.size(); ++i) {
+    if (result.labels[i] == 0) continue;
+    ++nr_labeled;
+    nr_lookup_matches += lookup_labels[i] == result.labels[i];
+    nr_bvh_matches += bvh_labels[i] == result.labels[i];
+  }
+  ASSERT_GT(nr_labeled, 0);
+  ASSERT_GT(nr_lookup_matches, 0.9 * nr_labeled);
+  // Convex hulls of neighbouring planes overlap, so BVH-only assignment is less accurate
+  ASSERT_GT(nr_bvh_matches, 0.7 * nr_labeled);
+}
+}  // namespace
+}  // namespace deplex
@@ -22,6 +22,7 @@
 #include <deplex/utils/eigen_io.h>
 
 #include "globals.hpp"
+#include "test_scenes.h"
 
 namespace deplex {
 namespace {
@@ -74,5 +75,60 @@ TEST(ICLPlaneExtraction, Refinement) {
   ASSERT_LE(refined_MSE, coarse_MSE);
 }
 
+TEST(TUMPlaneExtraction, RobustRefit) {
+  auto config = config::Config(test_globals::tum::config);
+  auto image = utils::DepthImage(test_globals::tum::sample_image);
+  auto points = image.toPointCloud(utils::readIntrinsics(test_globals::tum::intrinsics));
+  auto coarse_result = PlaneExtractor(image.getHeight(), image.getWidth(), config).extract(points);
+
+  config.robust_loss = config::RobustLoss::kTukey;
+  auto result = PlaneExtractor(image.getHeight(), image.getWidth(), config).extract(points);
+  ASSERT_EQ(result.planes.size(), coarse_result.planes.size());
+  for (size_t i = 0; i < result.planes.size(); ++i) {
+    ASSERT_NEAR(result.planes[i].normal.norm(), 1, 1e-4);
+    ASSERT_GT(result.planes[i].d, 0);
+    ASSERT_GT(result.planes[i].normal.dot(coarse_result.planes[i].normal), 0.95);
+  }
+}
+
+TEST(BoundaryRefinement, LabelsPixelsOfNonPlanarCell) {
+  auto width = 640, height = 480;
+  auto points = test_scenes::makeFloor(height, width);
+  // Spike breaks planarity of one cell, the rest of its pixels lie on the floor
+  auto spike_pixel = 245 * width + 325;
+  points(spike_pixel, 1) = 700;
+
+  auto config = config::Config();
+  auto coarse_labels = PlaneExtractor(height, width, config).process(points);
+  ASSERT_EQ(coarse_labels[spike_pixel + 1], 0);
+
+  config.boundary_refinement = true;
+  auto labels = PlaneExtractor(height, width, config).process(points);
+  auto floor_label = coarse_labels[0];
+  ASSERT_EQ(labels[spike_pixel], 0);
+  ASSERT_EQ(labels[spike_pixel + 1], floor_label);
+  ASSERT_EQ(labels[spike_pixel - width], floor_label);
+  ASSERT_EQ(std::count(labels.begin(), labels.end(), floor_label), height * width - 1);
+}
+
+TEST(TUMPlaneExtraction, BoundaryRefinement) {
+  auto config = config::Config(test_globals::tum::config);
+  auto image = utils::DepthImage(test_globals::tum::sample_image);
+  auto points = image.toPointCloud(utils::readIntrinsics(test_globals::tum::intrinsics));
+  auto coarse_labels = PlaneExtractor(image.getHeight(), image.getWidth(), config).process(points);
+
+  config.boundary_refinement = true;
+  auto labels = PlaneExtractor(image.getHeight(), image.getWidth(), config).process(points);
+  int32_t nr_relabeled = 0;
+  for (Eigen::Index i = 0; i < labels.size(); ++i) {
+    if (coarse_labels[i] != 0) {
+      ASSERT_EQ(labels[i], coarse_labels[i]);
+    } else if (labels[i] != 0) {
+      ++nr_relabeled;
+    }
+  }
+  ASSERT_GT(nr_relabeled, 0);
+}
+
 }  // namespace
 }  // namespace deplex
@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <deplex/result_publisher.h>
+
+namespace deplex {
+namespace {
+
+ExtractionResult getResult(int32_t value) {
+  ExtractionResult result;
+  result.labels = Eigen::VectorXi::Constant(1000, value);
+  PlaneModel plane;
+  plane.label = value;
+  result.planes.push_back(plane);
+  return result;
+}
+
+TEST(ResultPublisher, LatestResult) {
+  ResultPublisher publisher(1);
+  ASSERT_FALSE(publisher.getLatest());
+  ASSERT_THROW(ResultPublisher(0), std::runtime_error);
+
+  ASSERT_TRUE(publisher.publish(getResult(1), {1., 2.}));
+  auto first = publisher.getLatest();
+  ASSERT_TRUE(first);
+  ASSERT_EQ(first->sequence_number, 1);
+  ASSERT_EQ(first->result.labels[0], 1);
+  ASSERT_EQ(first->stage_timings, std::vector<double>({1., 2.}));
+
+  // Pinned result is kept while newer ones are published
+  for (int32_t value = 2; value < 10; ++value) {
+    ASSERT_TRUE(publisher.publish(getResult(value)));
+    ASSERT_EQ(first->result.labels[0], 1);
+  }
+  ASSERT_EQ(publisher.getNrPublished(), 9);
+  ASSERT_EQ(publisher.getLatest()->result.planes[0].label, 9);
+
+  // Slots: pinned first, latest and one being written, second extra snapshot exhausts them
+  auto second = publisher.getLatest();
+  ASSERT_TRUE(publisher.publish(getResult(10)));
+  ASSERT_FALSE(publisher.publish(getResult(11)));
+  ASSERT_EQ(publisher.getLatest()->sequence_number, 10);
+  second = ResultPublisher::Snapshot();
+  ASSERT_TRUE(publisher.publish(getResult(11)));
+  ASSERT_EQ(publisher.getLatest()->sequence_number, 11);
+}
+
+TEST(ResultPublisher, ConcurrentReaders) {
+  constexpr int32_t kNrReaders = 3;
+  constexpr int32_t kNrResults = 2000;
+  ResultPublisher publisher(kNrReaders);
+  std::atomic<bool> done{false};
+  std::atomic<int32_t> nr_errors{0};
+  std::vector<std::thread> readers;
+  for (int32_t i = 0; i < kNrReaders; ++i) {
+    readers.emplace_back([&publisher, &done, &nr_errors] {
+      uint64_t last_sequence_number = 0;
+      while (!done.load()) {
+        auto snapshot = publisher.getLatest();
+        if (!snapshot) {
+          continue;
+        }
+        // Result is complete and consistent with its sequence number, publications are seen in order
+        auto value = static_cast<int32_t>(snapshot->sequence_number);
+        bool is_consistent = (snapshot->result.labels.array() == value).all() &&
+                             snapshot->result.planes.size() == 1 && snapshot->result.planes[0].label == value;
+        if (!is_consistent || snapshot->sequence_number < last_sequence_number) {
+          ++nr_errors;
+        }
+        last_sequence_number = snapshot->sequence_number;
+      }
+    });
+  }
+  for (int32_t value = 1; value <= kNrResults; ++value) {
+    // Each reader pins at most one snapshot, so there is always a free slot
+    ASSERT_TRUE(publisher.publish(getResult(value)));
+  }
+  done = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  ASSERT_EQ(nr_errors.load(), 0);
+  ASSERT_EQ(publisher.getLatest()->sequence_number, kNrResults);
+}
+}  // namespace
+}  // namespace deplex
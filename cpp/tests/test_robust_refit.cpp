@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <deplex/robust_refit.h>
+
+#include "test_scenes.h"
+
+namespace deplex {
+namespace {
+PlaneModel makeInitialModel() {
+  PlaneModel plane;
+  plane.normal = Eigen::Vector3f(0.05f, 0, -1).normalized();
+  plane.d = 980 * -plane.normal.z();
+  return plane;
+}
+
+float getNormalError(PlaneModel const& plane) { return (plane.normal - Eigen::Vector3f(0, 0, -1)).norm(); }
+
+TEST(RobustRefit, NoneKeepsModel) {
+  auto plane = makeInitialModel();
+  refitPlane(test_scenes::makePlaneWithOutliers(), config::RobustLoss::kNone, 3, 0, 1, &plane);
+  ASSERT_TRUE(plane.normal.isApprox(makeInitialModel().normal));
+}
+
+TEST(RobustRefit, TukeyRejectsOutliers) {
+  auto plane = makeInitialModel();
+  refitPlane(test_scenes::makePlaneWithOutliers(), config::RobustLoss::kTukey, 5, 0, 10, &plane);
+  ASSERT_LT(getNormalError(plane), 1e-4);
+  ASSERT_NEAR(plane.d, 1000, 1e-1);
+  // Statistics describe inliers only, every fifth point is an outlier
+  ASSERT_EQ(plane.nr_points, 2000);
+  ASSERT_NEAR(plane.mean.z(), 1000, 1e-1);
+  ASSERT_LT(plane.mse, 1e-2);
+}
+
+TEST(RobustRefit, HuberReducesOutlierBias) {
+  auto plane = makeInitialModel();
+  refitPlane(test_scenes::makePlaneWithOutliers(), config::RobustLoss::kHuber, 5, 0, 10, &plane);
+  ASSERT_LT(getNormalError(plane), 1e-2);
+  // Least squares plane would be at mean depth 980
+  ASSERT_GT(plane.d, 990);
+  ASSERT_LT(plane.d, 1000);
+  // Weighted mean is pulled less towards outliers than the mean of all points
+  ASSERT_GT(plane.mean.z(), 990);
+  ASSERT_EQ(plane.nr_points, 2500);
+}
+}  // namespace
+}  // namespace deplex
@@ -0,0 +1,114 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "test_scenes.h"
+
+namespace deplex {
+namespace test_scenes {
+namespace {
+constexpr float kFocalLength = 500;
+
+/**
+ * Project pixels with depth given by depth(row, col) through getIntrinsics, zero depth gives zero point.
+ */
+template <typename DepthFunction>
+Eigen::MatrixX3f projectDepths(int32_t height, int32_t width, DepthFunction depth) {
+  Eigen::MatrixX3f points(height * width, 3);
+  for (int32_t row = 0; row < height; ++row) {
+    for (int32_t col = 0; col < width; ++col) {
+      float z = depth(row, col);
+      points.row(row * width + col) << (col - width / 2) * z / kFocalLength, (row - height / 2) * z / kFocalLength, z;
+    }
+  }
+  return points;
+}
+}  // namespace
+
+Eigen::Matrix3f getIntrinsics(int32_t height, int32_t width) {
+  Eigen::Matrix3f intrinsics;
+  intrinsics << kFocalLength, 0, static_cast<float>(width / 2),  //
+      0, kFocalLength, static_cast<float>(height / 2),            //
+      0, 0, 1;
+  return intrinsics;
+}
+
+Eigen::MatrixX3f makeFloor(int32_t height, int32_t width) {
+  Eigen::MatrixX3f points(height * width, 3);
+  for (int32_t row = 0; row < height; ++row) {
+    for (int32_t col = 0; col < width; ++col) {
+      points.row(row * width + col) << col * 5.f, 1000, 1000 + row * 5.f;
+    }
+  }
+  return points;
+}
+
+Eigen::MatrixX3f makeFloorWithBoxes(int32_t height, int32_t width) {
+  Eigen::MatrixX3f points = makeFloor(height, width);
+  for (int32_t row = 300; row < 340; ++row) {
+    points.block(row * width + 200, 1, 60, 1).setConstant(900);
+    points.block(row * width + 400, 1, 30, 1).setConstant(950);
+  }
+  return points;
+}
+
+Eigen::MatrixX3f makeSlopeAndFloor(int32_t height, int32_t width) {
+  Eigen::MatrixX3f points = makeFloor(height, width);
+  for (int32_t row = 0; row < height / 2; ++row) {
+    for (int32_t col = 0; col < width; ++col) {
+      points.row(row * width + col) << col * 5.f, row * 5.f, 2000 + row * 5.f;
+    }
+  }
+  return points;
+}
+
+Eigen::MatrixX3f makeWallAndFloor(int32_t height, int32_t width) {
+  Eigen::MatrixX3f points(height * width, 3);
+  for (int32_t row = 0; row < height; ++row) {
+    for (int32_t col = 0; col < width; ++col) {
+      float x = col * 5.f - 1600;
+      if (row < height / 2) {
+        points.row(row * width + col) << x, row * 5.f - 200, 2000;
+      } else {
+        points.row(row * width + col) << x, 1000, 2000 - (row - height / 2) * 5.f;
+      }
+    }
+  }
+  return points;
+}
+
+Eigen::MatrixX3f makeTwoWalls(int32_t height, int32_t width) {
+  return projectDepths(height, width, [width](int32_t row, int32_t col) {
+    return (col < width / 2 ? 2000.f : 2500.f) + ((row + col) % 2 == 0 ? 1.f : -1.f);
+  });
+}
+
+Eigen::MatrixX3f makeNoisyWallWithHoles(int32_t height, int32_t width) {
+  return projectDepths(height, width, [](int32_t row, int32_t col) {
+    bool is_hole = (row >= 200 && row < 210 && col >= 300 && col < 310) ||
+                   (row >= 100 && row < 105 && col >= 100 && col < 105);
+    return is_hole ? 0.f : 2000 + ((row + col) % 2 == 0 ? 3.f : -3.f);
+  });
+}
+
+Eigen::MatrixX3f makePlaneWithOutliers() {
+  Eigen::MatrixX3f points(2500, 3);
+  for (int32_t i = 0; i < points.rows(); ++i) {
+    float z = (i % 5 == 0 ? 900 : 1000);
+    points.row(i) << static_cast<float>(i % 50) * 10, static_cast<float>(i / 50) * 10, z;
+  }
+  return points;
+}
+}  // namespace test_scenes
+}  // namespace deplex
@@ -0,0 +1,67 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include <Eigen/Core>
+
+namespace deplex {
+namespace test_scenes {
+/**
+ * Intrinsics of pinhole camera with focal length 500 centered on image, used by camera-projected scenes.
+ */
+Eigen::Matrix3f getIntrinsics(int32_t height, int32_t width);
+
+/**
+ * Floor y = 1000 in front of camera, camera y-axis points down.
+ */
+Eigen::MatrixX3f makeFloor(int32_t height, int32_t width);
+
+/**
+ * Floor y = 1000 with two boxes on it: 100 high (rows 300-339, cols 200-259) and 50 high (rows 300-339,
+ * cols 400-429). Box points keep floor x and z, camera y-axis points down.
+ */
+Eigen::MatrixX3f makeFloorWithBoxes(int32_t height, int32_t width);
+
+/**
+ * 45-degree slope (upper half) above floor (lower half), camera y-axis points down.
+ */
+Eigen::MatrixX3f makeSlopeAndFloor(int32_t height, int32_t width);
+
+/**
+ * Wall at z = 2000 (upper half) above floor at y = 1000 (lower half).
+ */
+Eigen::MatrixX3f makeWallAndFloor(int32_t height, int32_t width);
+
+/**
+ * Two fronto-parallel walls separated by depth discontinuity: left at z = 2000, right at z = 2500.
+ * Points are projected with getIntrinsics, depth noise is +-1.
+ */
+Eigen::MatrixX3f makeTwoWalls(int32_t height, int32_t width);
+
+/**
+ * Fronto-parallel wall at z = 2000 with depth noise +-3, projected with getIntrinsics. Holes (zero points) are
+ * one empty cell (rows 200-209, cols 300-309) and a part of another cell (rows 100-104, cols 100-104).
+ */
+Eigen::MatrixX3f makeNoisyWallWithHoles(int32_t height, int32_t width);
+
+/**
+ * Unorganized plane z = 1000 of 2500 points, every fifth point is an outlier 100 units in front of plane.
+ */
+Eigen::MatrixX3f makePlaneWithOutliers();
+}  // namespace test_scenes
+}  // namespace deplex
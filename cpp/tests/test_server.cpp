@@ -0,0 +1,343 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <deplex/plane_extractor.h>
+#include <deplex/utils/depth_image.h>
+#include <deplex/utils/eigen_io.h>
+#include <deplex/utils/shm_ring_buffer.h>
+
+#include "globals.hpp"
+#include "server.h"
+
+namespace deplex {
+namespace {
+constexpr int kReplyTimeoutMs = 10000;
+// Time for server to receive frame messages, well below result wait of server workers
+constexpr int kArrivalDelayMs = 200;
+
+/**
+ * Runs server on its own thread for the lifetime of the test.
+ */
+class ServerRunner {
+ public:
+  ServerRunner(std::string const& socket_path, size_t nr_workers)
+      : server_(socket_path, nr_workers), thread_([this] { server_.run(); }) {}
+
+  ~ServerRunner() {
+    server_.stop();
+    thread_.join();
+  }
+
+ private:
+  server::Server server_;
+  std::thread thread_;
+};
+
+/**
+ * Client side of server protocol with its own frames and results rings.
+ */
+class TestClient {
+ public:
+  TestClient(std::string const& socket_path, std::string const& name, int32_t height, int32_t width,
+             uint32_t nr_slots = 2)
+      : fd_(socket(AF_UNIX, SOCK_STREAM, 0)),
+        frames_name_("/deplex_test_server_frames_" + name),
+        results_name_("/deplex_test_server_results_" + name),
+        frames_(utils::ShmRingBuffer::create(frames_name_, nr_slots, height * width * 3 * sizeof(float))),
+        results_(utils::ShmRingBuffer::create(results_name_, nr_slots, height * width * sizeof(int32_t))),
+        height_(height),
+        width_(width) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+    if (connect(fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+      throw std::runtime_error("Error! Couldn't connect to " + socket_path);
+    }
+  }
+
+  ~TestClient() { ::close(fd_); }
+
+  void sendRaw(std::string const& bytes) {
+    ASSERT_EQ(write(fd_, bytes.data(), bytes.size()), static_cast<ssize_t>(bytes.size()));
+  }
+
+  void send(server::MessageType type, std::string const& payload) {
+    server::MessageHeader header{type, static_cast<uint32_t>(payload.size())};
+    sendRaw(std::string(reinterpret_cast<char const*>(&header), sizeof(header)) + payload);
+  }
+
+  /**
+   * Read one message, waiting at most kReplyTimeoutMs for each chunk.
+   *
+   * @returns false on timeout or closed connection.
+   */
+  bool receive(server::MessageType* type, std::string* payload) {
+    server::MessageHeader header{};
+    if (!readExact(&header, sizeof(header))) {
+      return false;
+    }
+    *type = header.type;
+    payload->assign(header.payload_size, '\0');
+    return readExact(&(*payload)[0], payload->size());
+  }
+
+  /**
+   * Wait at most kReplyTimeoutMs until server takes all published frames from frames ring.
+   */
+  void waitFramesTaken() {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(kReplyTimeoutMs);
+    while (frames_.size() != 0 && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(frames_.size(), 0);
+  }
+
+  /**
+   * Number of received bytes waiting in socket.
+   */
+  ssize_t getPendingBytes() {
+    char buffer[1024];
+    ssize_t nr_bytes = recv(fd_, buffer, sizeof(buffer), MSG_PEEK | MSG_DONTWAIT);
+    return std::max<ssize_t>(nr_bytes, 0);
+  }
+
+  void registerClient(int32_t priority) {
+    server::RegisterRequest request{};
+    request.version = server::kProtocolVersion;
+    request.image_height = height_;
+    request.image_width = width_;
+    request.priority = priority;
+    std::strncpy(request.frames_ring, frames_name_.c_str(), server::kMaxRingNameLength - 1);
+    std::strncpy(request.results_ring, results_name_.c_str(), server::kMaxRingNameLength - 1);
+    send(server::MessageType::kRegister, std::string(reinterpret_cast<char const*>(&request), sizeof(request)));
+    server::MessageType type;
+    std::string reply;
+    ASSERT_TRUE(receive(&type, &reply));
+    ASSERT_EQ(type, server::MessageType::kRegistered) << reply;
+  }
+
+  void sendFrame(Eigen::MatrixX3f const& points, uint64_t sequence) {
+    void* slot = frames_.tryAcquireWrite();
+    ASSERT_NE(slot, nullptr);
+    std::memcpy(slot, points.data(), points.size() * sizeof(float));
+    utils::FrameHeader header{};
+    header.sequence = sequence;
+    header.height = height_;
+    header.width = width_;
+    header.format = utils::FrameFormat::kPointsF32;
+    header.payload_size = points.size() * sizeof(float);
+    frames_.commitWrite(header);
+    server::FrameRequest request{sequence, 0};
+    send(server::MessageType::kFrame, std::string(reinterpret_cast<char const*>(&request), sizeof(request)));
+  }
+
+  server::FrameResponse receiveFrameDone() {
+    server::MessageType type;
+    std::string reply;
+    server::FrameResponse response{};
+    EXPECT_TRUE(receive(&type, &reply));
+    EXPECT_EQ(type, server::MessageType::kFrameDone);
+    if (reply.size() == sizeof(response)) {
+      std::memcpy(&response, reply.data(), sizeof(response));
+    }
+    return response;
+  }
+
+  /**
+   * Fill all free slots of results ring, so that server waits for the client to read them.
+   */
+  void fillResults() {
+    while (results_.tryAcquireWrite() != nullptr) {
+      utils::FrameHeader header{};
+      header.payload_size = 0;
+      results_.commitWrite(header);
+    }
+  }
+
+  void skipResult() {
+    utils::FrameHeader header{};
+    EXPECT_NE(results_.tryAcquireRead(&header), nullptr);
+    results_.releaseRead();
+  }
+
+  Eigen::VectorXi readLabels() {
+    utils::FrameHeader header{};
+    auto labels = static_cast<int32_t const*>(results_.tryAcquireRead(&header));
+    EXPECT_NE(labels, nullptr);
+    Eigen::VectorXi result = Eigen::Map<const Eigen::VectorXi>(labels, height_ * width_);
+    results_.releaseRead();
+    return result;
+  }
+
+ private:
+  int fd_;
+  std::string frames_name_;
+  std::string results_name_;
+  utils::ShmRingBuffer frames_;
+  utils::ShmRingBuffer results_;
+  int32_t height_;
+  int32_t width_;
+
+  bool readExact(void* data, size_t size) {
+    auto buffer = static_cast<char*>(data);
+    while (size > 0) {
+      pollfd poll_fd{fd_, POLLIN, 0};
+      if (poll(&poll_fd, 1, kReplyTimeoutMs) <= 0) {
+        return false;
+      }
+      ssize_t nr_read = read(fd_, buffer, size);
+      if (nr_read <= 0) {
+        return false;
+      }
+      buffer += nr_read;
+      size -= nr_read;
+    }
+    return true;
+  }
+};
+
+Eigen::MatrixX3f getTumPoints(int32_t* height, int32_t* width) {
+  auto image = utils::DepthImage(test_globals::tum::sample_image);
+  *height = image.getHeight();
+  *width = image.getWidth();
+  return image.toPointCloud(utils::readIntrinsics(test_globals::tum::intrinsics));
+}
+
+size_t getNrProcessThreads() {
+  auto tasks = std::filesystem::directory_iterator("/proc/self/task");
+  return std::distance(std::filesystem::begin(tasks), std::filesystem::end(tasks));
+}
+
+TEST(Server, LoopbackSession) {
+  int32_t height, width;
+  Eigen::MatrixX3f points = getTumPoints(&height, &width);
+  Eigen::VectorXi expected_labels = PlaneExtractor(height, width).process(points);
+
+  std::string socket_path = "/tmp/deplex_test_server_loopback.sock";
+  ServerRunner server(socket_path, 1);
+  TestClient client(socket_path, "loopback", height, width);
+  client.registerClient(0);
+  for (uint64_t sequence = 0; sequence < 2; ++sequence) {
+    client.sendFrame(points, sequence);
+    auto response = client.receiveFrameDone();
+    ASSERT_EQ(response.sequence, sequence);
+    ASSERT_EQ(response.status, server::FrameStatus::kProcessed);
+    ASSERT_EQ(client.readLabels(), expected_labels);
+  }
+}
+
+TEST(Server, StalledClientDoesntBlockOthers) {
+  constexpr int32_t kSize = 40;
+  std::string socket_path = "/tmp/deplex_test_server_stalled.sock";
+  ServerRunner server(socket_path, 1);
+
+  // Stalled client sends a part of message header and never the rest
+  TestClient stalled_client(socket_path, "stalled", kSize, kSize);
+  stalled_client.sendRaw("abc");
+
+  TestClient client(socket_path, "active", kSize, kSize);
+  client.registerClient(0);
+  client.sendFrame(Eigen::MatrixX3f::Zero(kSize * kSize, 3), 0);
+  ASSERT_EQ(client.receiveFrameDone().status, server::FrameStatus::kProcessed);
+  ASSERT_EQ(client.readLabels(), Eigen::VectorXi::Zero(kSize * kSize));
+}
+
+TEST(Server, OversizedMessage) {
+  std::string socket_path = "/tmp/deplex_test_server_oversized.sock";
+  ServerRunner server(socket_path, 1);
+  TestClient client(socket_path, "oversized", 1, 1);
+  server::MessageHeader header{server::MessageType::kRegister, server::kMaxPayloadSize + 1};
+  client.sendRaw(std::string(reinterpret_cast<char const*>(&header), sizeof(header)));
+  server::MessageType type;
+  std::string reply;
+  ASSERT_TRUE(client.receive(&type, &reply));
+  ASSERT_EQ(type, server::MessageType::kError);
+}
+
+TEST(Server, PriorityBeforeArrival) {
+  int32_t height, width;
+  Eigen::MatrixX3f points = getTumPoints(&height, &width);
+  std::string socket_path = "/tmp/deplex_test_server_priority.sock";
+  ServerRunner server(socket_path, 1);
+  TestClient low_client(socket_path, "low", height, width);
+  TestClient high_client(socket_path, "high", height, width);
+  low_client.registerClient(0);
+  high_client.registerClient(1);
+
+  // The only worker is held by the first low-priority frame until its result can be published, then picks
+  // the high-priority frame although the second low-priority frame arrived earlier
+  low_client.fillResults();
+  low_client.sendFrame(points, 0);
+  // Input slot is released after extraction, the worker then waits for a free result slot
+  low_client.waitFramesTaken();
+  low_client.sendFrame(points, 1);
+  high_client.sendFrame(points, 0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(kArrivalDelayMs));
+  low_client.skipResult();
+  ASSERT_EQ(high_client.receiveFrameDone().status, server::FrameStatus::kProcessed);
+  ASSERT_EQ(low_client.getPendingBytes(), sizeof(server::MessageHeader) + sizeof(server::FrameResponse));
+  ASSERT_EQ(low_client.receiveFrameDone().sequence, 0);
+  low_client.skipResult();
+  ASSERT_EQ(low_client.receiveFrameDone().sequence, 1);
+}
+
+TEST(Server, WorkersDontOversubscribe) {
+  constexpr size_t kNrWorkers = 4;
+  constexpr size_t kNrClients = 4;
+  constexpr uint64_t kNrFrames = 2;
+  int32_t height, width;
+  Eigen::MatrixX3f points = getTumPoints(&height, &width);
+  Eigen::VectorXi expected_labels = PlaneExtractor(height, width).process(points);
+  size_t nr_threads_before = getNrProcessThreads();
+
+  std::string socket_path = "/tmp/deplex_test_server_threads.sock";
+  ServerRunner server(socket_path, kNrWorkers);
+  std::vector<std::unique_ptr<TestClient>> clients;
+  for (size_t i = 0; i < kNrClients; ++i) {
+    clients.emplace_back(new TestClient(socket_path, "threads_" + std::to_string(i), height, width));
+    clients.back()->registerClient(0);
+  }
+  for (uint64_t sequence = 0; sequence < kNrFrames; ++sequence) {
+    for (auto& client : clients) {
+      client->sendFrame(points, sequence);
+    }
+  }
+  for (auto& client : clients) {
+    for (uint64_t sequence = 0; sequence < kNrFrames; ++sequence) {
+      ASSERT_EQ(client->receiveFrameDone().status, server::FrameStatus::kProcessed);
+      ASSERT_EQ(client->readLabels(), expected_labels);
+    }
+  }
+  // OpenMP keeps team threads alive between parallel regions, so teams opened by workers are still counted.
+  // Server runs its poll thread and workers only
+  ASSERT_LE(getNrProcessThreads(), nr_threads_before + 1 + kNrWorkers);
+}
+}  // namespace
+}  // namespace deplex
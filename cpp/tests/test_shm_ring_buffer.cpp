@@ -0,0 +1,192 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <thread>
+
+#include <deplex/plane_extractor.h>
+#include <deplex/utils/depth_image.h>
+#include <deplex/utils/eigen_io.h>
+#include <deplex/utils/shm_ring_buffer.h>
+
+#include "globals.hpp"
+
+namespace deplex {
+namespace {
+TEST(ShmRingBuffer, SingleProcessOrdering) {
+  auto ring = utils::ShmRingBuffer::create("/deplex_test_ordering", 2, sizeof(int32_t));
+  for (int32_t i = 0; i < 2; ++i) {
+    void* slot = ring.tryAcquireWrite();
+    ASSERT_NE(slot, nullptr);
+    std::memcpy(slot, &i, sizeof(i));
+    utils::FrameHeader header{};
+    header.sequence = i;
+    header.payload_size = sizeof(i);
+    ring.commitWrite(header);
+  }
+  ASSERT_EQ(ring.tryAcquireWrite(), nullptr);
+  ASSERT_EQ(ring.size(), 2);
+
+  for (int32_t i = 0; i < 2; ++i) {
+    utils::FrameHeader header{};
+    auto payload = static_cast<int32_t const*>(ring.tryAcquireRead(&header));
+    ASSERT_NE(payload, nullptr);
+    ASSERT_EQ(header.sequence, i);
+    ASSERT_EQ(*payload, i);
+    ring.releaseRead();
+  }
+  utils::FrameHeader header{};
+  ASSERT_EQ(ring.tryAcquireRead(&header), nullptr);
+}
+
+TEST(ShmRingBuffer, OversizedPayload) {
+  auto ring = utils::ShmRingBuffer::create("/deplex_test_oversized", 1, 16);
+  ASSERT_NE(ring.tryAcquireWrite(), nullptr);
+  utils::FrameHeader header{};
+  header.payload_size = 17;
+  ASSERT_THROW(ring.commitWrite(header), std::runtime_error);
+}
+
+TEST(ShmRingBuffer, ExistingRing) {
+  auto ring = utils::ShmRingBuffer::create("/deplex_test_existing", 1, 16);
+  // Live ring of another producer is never taken over implicitly
+  ASSERT_THROW(utils::ShmRingBuffer::create("/deplex_test_existing", 1, 16), std::runtime_error);
+  auto stale_ring = utils::ShmRingBuffer::open("/deplex_test_existing");
+  auto new_ring = utils::ShmRingBuffer::create("/deplex_test_existing", 2, 16, true);
+  ASSERT_EQ(utils::ShmRingBuffer::open("/deplex_test_existing").getSlotCount(), 2);
+}
+
+TEST(ShmRingBuffer, OpenMissingRing) {
+  ASSERT_THROW(utils::ShmRingBuffer::open("/deplex_test_missing_ring"), std::runtime_error);
+}
+
+/**
+ * Publish zero point cloud [height x width] with given payload size.
+ */
+void publishPoints(utils::ShmRingBuffer* ring, int32_t height, int32_t width, uint64_t payload_size) {
+  void* slot = ring->tryAcquireWrite();
+  ASSERT_NE(slot, nullptr);
+  std::memset(slot, 0, ring->getSlotCapacity());
+  utils::FrameHeader header{};
+  header.height = height;
+  header.width = width;
+  header.format = utils::FrameFormat::kPointsF32;
+  header.payload_size = payload_size;
+  ring->commitWrite(header);
+}
+
+TEST(ShmRingBuffer, RejectsFrameExceedingPayload) {
+  constexpr int32_t kSize = 20;
+  auto algorithm = PlaneExtractor(kSize, kSize);
+  auto frames = utils::ShmRingBuffer::create("/deplex_test_bad_frames", 2, kSize * kSize * 3 * sizeof(float));
+  auto results = utils::ShmRingBuffer::create("/deplex_test_bad_results", 2, kSize * kSize * sizeof(int32_t));
+  // Header claims more points than payload holds
+  publishPoints(&frames, kSize * 4, kSize, kSize * kSize * 3 * sizeof(float));
+  int64_t nr_rejected = 0;
+  ASSERT_EQ(utils::processShmFrames(&algorithm, &frames, &results, 1, 1000, &nr_rejected), 0);
+  ASSERT_EQ(nr_rejected, 1);
+  // Rejected frame doesn't block the ring
+  ASSERT_EQ(frames.size(), 0);
+  ASSERT_EQ(results.size(), 0);
+
+  // Rejected frame is skipped, the next one is processed
+  publishPoints(&frames, kSize * 4, kSize, kSize * kSize * 3 * sizeof(float));
+  publishPoints(&frames, kSize, kSize, kSize * kSize * 3 * sizeof(float));
+  frames.close();
+  ASSERT_EQ(utils::processShmFrames(&algorithm, &frames, &results, -1, 1000, &nr_rejected), 1);
+  ASSERT_EQ(nr_rejected, 2);
+  ASSERT_EQ(results.size(), 1);
+}
+
+TEST(ShmRingBuffer, FullResultsRing) {
+  constexpr int32_t kSize = 20;
+  auto algorithm = PlaneExtractor(kSize, kSize);
+  auto frames = utils::ShmRingBuffer::create("/deplex_test_full_frames", 2, kSize * kSize * 3 * sizeof(float));
+  auto results = utils::ShmRingBuffer::create("/deplex_test_full_results", 1, kSize * kSize * sizeof(int32_t));
+  for (int32_t i = 0; i < 2; ++i) {
+    publishPoints(&frames, kSize, kSize, kSize * kSize * 3 * sizeof(float));
+  }
+  // Nobody reads results: the second frame times out
+  ASSERT_THROW(utils::processShmFrames(&algorithm, &frames, &results, -1, 10), std::runtime_error);
+  ASSERT_EQ(results.size(), 1);
+
+  // Consumer closing results ring stops the loop
+  publishPoints(&frames, kSize, kSize, kSize * kSize * 3 * sizeof(float));
+  results.close();
+  ASSERT_EQ(utils::processShmFrames(&algorithm, &frames, &results), 0);
+}
+
+TEST(ShmRingBuffer, TwoProcessExtraction) {
+  constexpr int32_t kNrFrames = 3;
+  auto image = utils::DepthImage(test_globals::tum::sample_image);
+  Eigen::MatrixX3f points = image.toPointCloud(utils::readIntrinsics(test_globals::tum::intrinsics));
+  auto algorithm = PlaneExtractor(image.getHeight(), image.getWidth());
+  Eigen::VectorXi expected_labels = algorithm.process(points);
+
+  size_t frame_size = points.size() * sizeof(float);
+  auto frames = utils::ShmRingBuffer::create("/deplex_test_frames", 2, frame_size);
+  auto results = utils::ShmRingBuffer::create("/deplex_test_results", 2, expected_labels.size() * sizeof(int32_t));
+
+  pid_t camera_pid = fork();
+  ASSERT_NE(camera_pid, -1);
+  if (camera_pid == 0) {
+    // Camera process: publish frames and validate received labels
+    auto camera_frames = utils::ShmRingBuffer::open("/deplex_test_frames");
+    auto camera_results = utils::ShmRingBuffer::open("/deplex_test_results");
+    int32_t nr_sent = 0, nr_received = 0;
+    bool valid = true;
+    while (nr_received < kNrFrames) {
+      void* slot = (nr_sent < kNrFrames ? camera_frames.tryAcquireWrite() : nullptr);
+      if (slot != nullptr) {
+        std::memcpy(slot, points.data(), frame_size);
+        utils::FrameHeader header{};
+        header.sequence = nr_sent++;
+        header.timestamp_ns = 1000 * header.sequence;
+        header.height = image.getHeight();
+        header.width = image.getWidth();
+        header.format = utils::FrameFormat::kPointsF32;
+        header.depth_scale = 1;
+        header.payload_size = frame_size;
+        camera_frames.commitWrite(header);
+        if (nr_sent == kNrFrames) camera_frames.close();
+      }
+      utils::FrameHeader header{};
+      auto labels = static_cast<int32_t const*>(camera_results.tryAcquireRead(&header));
+      if (labels != nullptr) {
+        valid = valid && header.sequence == static_cast<uint64_t>(nr_received) &&
+                header.timestamp_ns == 1000 * header.sequence && header.format == utils::FrameFormat::kLabelsI32 &&
+                Eigen::Map<const Eigen::VectorXi>(labels, expected_labels.size()) == expected_labels;
+        camera_results.releaseRead();
+        ++nr_received;
+      }
+      std::this_thread::yield();
+    }
+    _exit(valid ? 0 : 1);
+  }
+
+  int64_t nr_processed = utils::processShmFrames(&algorithm, &frames, &results);
+  int status = 0;
+  waitpid(camera_pid, &status, 0);
+  ASSERT_EQ(nr_processed, kNrFrames);
+  ASSERT_TRUE(WIFEXITED(status));
+  ASSERT_EQ(WEXITSTATUS(status), 0);
+}
+}  // namespace
+}  // namespace deplex
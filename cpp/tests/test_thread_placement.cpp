@@ -0,0 +1,164 @@
+/**
+ * Copyright (c) 2022, Arthur Saliou, Anastasiia Kornilova
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <memory>
+#include <thread>
+
+#include <deplex/plane_extractor.h>
+#include <deplex/thread_placement.h>
+#include <deplex/utils/depth_image.h>
+#include <deplex/utils/eigen_io.h>
+
+#include "globals.hpp"
+
+namespace deplex {
+namespace {
+int32_t getAllowedCpu() {
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  sched_getaffinity(0, sizeof(cpu_set), &cpu_set);
+  for (int32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (CPU_ISSET(cpu, &cpu_set)) return cpu;
+  }
+  return 0;
+}
+
+/**
+ * Check placement of every thread of the process, OpenMP teams included: none of them is real-time and,
+ * if given, all of them have the given affinity.
+ */
+void expectThreadsUnplaced(cpu_set_t const* expected_cpu_set) {
+  DIR* tasks = opendir("/proc/self/task");
+  ASSERT_NE(tasks, nullptr);
+  while (dirent* entry = readdir(tasks)) {
+    if (entry->d_name[0] == '.') continue;
+    pid_t tid = std::stoi(entry->d_name);
+    EXPECT_EQ(sched_getscheduler(tid), SCHED_OTHER) << "thread " << tid;
+    if (expected_cpu_set != nullptr) {
+      cpu_set_t cpu_set;
+      CPU_ZERO(&cpu_set);
+      sched_getaffinity(tid, sizeof(cpu_set), &cpu_set);
+      EXPECT_TRUE(CPU_EQUAL(&cpu_set, expected_cpu_set)) << "thread " << tid;
+    }
+  }
+  closedir(tasks);
+}
+
+/**
+ * Whether threads of the process may switch to SCHED_FIFO (needs CAP_SYS_NICE or RLIMIT_RTPRIO).
+ */
+bool canUseRealtimePriority() {
+  bool result = false;
+  std::thread([&result] {
+    sched_param param{};
+    param.sched_priority = 1;
+    result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+  }).join();
+  return result;
+}
+
+TEST(ThreadPlacement, ParseCpuList) {
+  ASSERT_TRUE(parseCpuList("").empty());
+  ASSERT_EQ(parseCpuList("3"), std::vector<int32_t>({3}));
+  ASSERT_EQ(parseCpuList("4-6,1,5"), std::vector<int32_t>({1, 4, 5, 6}));
+}
+
+TEST(ThreadPlacement, InvalidCpuList) {
+  ASSERT_THROW(parseCpuList("0-"), std::runtime_error);
+  ASSERT_THROW(parseCpuList("3-1"), std::runtime_error);
+  ASSERT_THROW(parseCpuList("a,b"), std::runtime_error);
+  ASSERT_THROW(parseCpuList("0,,1"), std::runtime_error);
+}
+
+TEST(ThreadPlacement, InvalidConfig) {
+  config::Config config;
+  config.cpu_affinity = "0-";
+  ASSERT_THROW(PlaneExtractor(480, 640, config), std::runtime_error);
+  config.cpu_affinity = "";
+  config.realtime_priority = -1;
+  ASSERT_THROW(PlaneExtractor(480, 640, config), std::runtime_error);
+  // Prefetch thread needs a CPU of its own
+  config.realtime_priority = 0;
+  config.pipelined_processing = true;
+  config.cpu_affinity = "0";
+  ASSERT_THROW(PlaneExtractor(480, 640, config), std::runtime_error);
+}
+
+TEST(ThreadPlacement, PinnedExtraction) {
+  auto config = config::Config(test_globals::tum::config);
+  auto image = utils::DepthImage(test_globals::tum::sample_image);
+  auto points = image.toPointCloud(utils::readIntrinsics(test_globals::tum::intrinsics));
+  auto expected_labels = PlaneExtractor(image.getHeight(), image.getWidth(), config).process(points);
+
+  int32_t cpu = getAllowedCpu();
+  cpu_set_t initial_cpu_set;
+  sched_getaffinity(0, sizeof(initial_cpu_set), &initial_cpu_set);
+  config.cpu_affinity = std::to_string(cpu);
+  auto algorithm = PlaneExtractor(image.getHeight(), image.getWidth(), config);
+  cpu_set_t processing_cpu_set;
+  algorithm.addStageHook(PipelineStage::kCellGrid,
+                         [&processing_cpu_set](Eigen::Ref<const Eigen::MatrixX3f> const&, PipelineFrame*) {
+                           sched_getaffinity(0, sizeof(processing_cpu_set), &processing_cpu_set);
+                         });
+  auto labels = algorithm.process(points);
+  ASSERT_EQ(CPU_COUNT(&processing_cpu_set), 1);
+  ASSERT_TRUE(CPU_ISSET(cpu, &processing_cpu_set));
+  ASSERT_EQ(labels, expected_labels);
+
+  // Caller thread gets its placement back
+  cpu_set_t cpu_set;
+  sched_getaffinity(0, sizeof(cpu_set), &cpu_set);
+  ASSERT_TRUE(CPU_EQUAL(&cpu_set, &initial_cpu_set));
+
+  // Next frames reuse placement of OpenMP team and pin caller again
+  CPU_ZERO(&processing_cpu_set);
+  ASSERT_EQ(algorithm.process(points), expected_labels);
+  ASSERT_EQ(CPU_COUNT(&processing_cpu_set), 1);
+  ASSERT_TRUE(CPU_ISSET(cpu, &processing_cpu_set));
+  sched_getaffinity(0, sizeof(cpu_set), &cpu_set);
+  ASSERT_TRUE(CPU_EQUAL(&cpu_set, &initial_cpu_set));
+
+  // Worker thread is pinned as well
+  CPU_ZERO(&processing_cpu_set);
+  ASSERT_EQ(algorithm.processAsync(std::make_shared<const Eigen::MatrixX3f>(points)).get(), expected_labels);
+  ASSERT_EQ(CPU_COUNT(&processing_cpu_set), 1);
+  ASSERT_TRUE(CPU_ISSET(cpu, &processing_cpu_set));
+}
+
+TEST(ThreadPlacement, UnpinnedExtractionAfterPinned) {
+  constexpr int32_t kHeight = 480, kWidth = 640;
+  Eigen::MatrixX3f points = Eigen::MatrixX3f::Zero(kHeight * kWidth, 3);
+  cpu_set_t initial_cpu_set;
+  sched_getaffinity(0, sizeof(initial_cpu_set), &initial_cpu_set);
+
+  auto config = config::Config();
+  config.cpu_affinity = std::to_string(getAllowedCpu());
+  config.realtime_priority = (canUseRealtimePriority() ? 1 : 0);
+  PlaneExtractor(kHeight, kWidth, config).process(points);
+  // Real-time priority doesn't outlive the call, neither on caller nor on its OpenMP team
+  expectThreadsUnplaced(nullptr);
+
+  // Extractor without placement on the same thread unpins the OpenMP team
+  PlaneExtractor(kHeight, kWidth).process(points);
+  expectThreadsUnplaced(&initial_cpu_set);
+}
+}  // namespace
+}  // namespace deplex